@@ -32,6 +32,7 @@
 #include <SFML/Graphics/BlendMode.hpp>
 #include <DSFMLC/Graphics/TextureStruct.h>
 #include <DSFMLC/Graphics/ShaderStruct.h>
+#include <DSFMLC/Graphics/DrawCommand.h>
 
 
 // Convert sfRenderStates* to sf::RenderStates
@@ -54,7 +55,19 @@ inline sf::RenderStates createRenderStates(DInt colorSrcFactor, DInt colorDstFac
     sfmlStates.texture = texture ? texture->This : NULL;
     sfmlStates.shader = shader ? &shader->This : NULL;
 
+    //Drawing binds the shader, which mustn't happen while it is still compiling
+    if (shader)
+        waitForPendingLoad(shader);
+
     return sfmlStates;
 }
 
+// Convert the render states packed in a sfDrawCommand to sf::RenderStates
+inline sf::RenderStates createRenderStates(const sfDrawCommand& command)
+{
+    return createRenderStates(command.colorSrcFactor, command.colorDstFactor, command.colorEquation,
+    		command.alphaSrcFactor, command.alphaDstFactor, command.alphaEquation,
+    		command.transform, command.texture, command.shader);
+}
+
 #endif // DSFML_CONVERTRENDERSTATES_H
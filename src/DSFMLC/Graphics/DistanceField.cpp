@@ -0,0 +1,235 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/DistanceField.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+namespace
+{
+    //Offset from a pixel to the closest pixel of the shape it is measured against
+    struct Offset
+    {
+        int dx;
+        int dy;
+
+        int squaredLength() const
+        {
+            return dx * dx + dy * dy;
+        }
+    };
+
+    void compare(std::vector<Offset>& grid, int width, int height, int x, int y, int offsetX, int offsetY)
+    {
+        int otherX = x + offsetX;
+        int otherY = y + offsetY;
+
+        if ((otherX < 0) || (otherY < 0) || (otherX >= width) || (otherY >= height))
+            return;
+
+        Offset other = grid[otherY * width + otherX];
+        other.dx += offsetX;
+        other.dy += offsetY;
+
+        if (other.squaredLength() < grid[y * width + x].squaredLength())
+            grid[y * width + x] = other;
+    }
+
+    //Compute the distance from each pixel to the closest target pixel, with the
+    //8-point sequential signed Euclidean distance transform
+    void computeDistances(const std::vector<bool>& targets, int width, int height, std::vector<float>& distances)
+    {
+        const Offset zero = {0, 0};
+        const Offset far = {9999, 9999};
+
+        std::vector<Offset> grid(targets.size());
+        for (std::size_t i = 0; i < targets.size(); ++i)
+            grid[i] = targets[i] ? zero : far;
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                compare(grid, width, height, x, y, -1,  0);
+                compare(grid, width, height, x, y,  0, -1);
+                compare(grid, width, height, x, y, -1, -1);
+                compare(grid, width, height, x, y,  1, -1);
+            }
+
+            for (int x = width - 1; x >= 0; --x)
+                compare(grid, width, height, x, y, 1, 0);
+        }
+
+        for (int y = height - 1; y >= 0; --y)
+        {
+            for (int x = width - 1; x >= 0; --x)
+            {
+                compare(grid, width, height, x, y,  1,  0);
+                compare(grid, width, height, x, y,  0,  1);
+                compare(grid, width, height, x, y, -1,  1);
+                compare(grid, width, height, x, y,  1,  1);
+            }
+
+            for (int x = 0; x < width; ++x)
+                compare(grid, width, height, x, y, -1, 0);
+        }
+
+        distances.resize(grid.size());
+        for (std::size_t i = 0; i < grid.size(); ++i)
+            distances[i] = std::sqrt(static_cast<float>(grid[i].squaredLength()));
+    }
+}
+
+sfDistanceField::sfDistanceField() :
+baseSize(0),
+spread(0)
+{
+}
+
+void sfDistanceField::reset(unsigned int newBaseSize, unsigned int newSpread)
+{
+    baseSize = newBaseSize;
+    spread = std::max(newSpread, 1u);
+    page = sfGlyphPage();
+
+    if (!isEnabled())
+        return;
+
+    //Reserve a 2x2 white square for texturing underlines, like sf::Font does
+    page.findGlyphRect(2, 2);
+    for (unsigned int x = 0; x < 2; ++x)
+        for (unsigned int y = 0; y < 2; ++y)
+            page.image.setPixel(x, y, sf::Color(255, 255, 255, 255));
+
+    if (page.texture.loadFromImage(page.image))
+        page.texture.setSmooth(true);
+}
+
+bool sfDistanceField::isEnabled() const
+{
+    return baseSize > 0;
+}
+
+void sfDistanceField::loadGlyphs(const sf::Font& font, const sf::Uint32* codePoints, std::size_t count, bool bold)
+{
+    //Find the glyphs that are missing, and have the font rasterize them at the base size
+    std::map<sf::Uint64, sf::Glyph> missing;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sf::Uint64 key = glyphKey(codePoints[i], bold, 0);
+
+        if ((page.glyphs.find(key) == page.glyphs.end()) && (missing.find(key) == missing.end()))
+            missing[key] = font.getGlyph(codePoints[i], baseSize, bold);
+    }
+
+    if (missing.empty())
+        return;
+
+    //Reading back the font's page is slow, so only do it once for all the glyphs
+    sf::Image fontImage = font.getTexture(baseSize).copyToImage();
+    const sf::Uint8* fontPixels = fontImage.getPixelsPtr();
+    unsigned int fontWidth = fontImage.getSize().x;
+    int margin = static_cast<int>(spread);
+
+    for (std::map<sf::Uint64, sf::Glyph>::const_iterator it = missing.begin(); it != missing.end(); ++it)
+    {
+        sf::Glyph glyph = it->second;
+        const sf::IntRect& source = glyph.textureRect;
+
+        if ((source.width <= 0) || (source.height <= 0))
+        {
+            page.glyphs[it->first] = glyph;
+            continue;
+        }
+
+        //Leave room around the glyph for the distance field to fade out
+        int width = source.width + margin * 2;
+        int height = source.height + margin * 2;
+
+        std::vector<bool> inside(width * height, false);
+        std::vector<bool> outside(width * height, true);
+        for (int y = 0; y < source.height; ++y)
+        {
+            for (int x = 0; x < source.width; ++x)
+            {
+                sf::Uint8 alpha = fontPixels[((source.top + y) * fontWidth + source.left + x) * 4 + 3];
+                std::size_t index = (y + margin) * width + x + margin;
+
+                inside[index] = alpha >= 128;
+                outside[index] = alpha < 128;
+            }
+        }
+
+        std::vector<float> distanceToInside;
+        std::vector<float> distanceToOutside;
+        computeDistances(inside, width, height, distanceToInside);
+        computeDistances(outside, width, height, distanceToOutside);
+
+        //Map the signed distance to [0, 1], with the edge of the glyph at 0.5
+        sf::IntRect rect = page.findGlyphRect(width, height);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                std::size_t index = y * width + x;
+                float distance = distanceToOutside[index] - distanceToInside[index];
+                float value = std::min(std::max(0.5f + distance / (2.f * spread), 0.f), 1.f);
+
+                page.image.setPixel(rect.left + x, rect.top + y, sf::Color(255, 255, 255, static_cast<sf::Uint8>(value * 255.f + 0.5f)));
+            }
+        }
+
+        glyph.bounds.left -= margin;
+        glyph.bounds.top -= margin;
+        glyph.bounds.width += margin * 2;
+        glyph.bounds.height += margin * 2;
+        glyph.textureRect = rect;
+
+        page.glyphs[it->first] = glyph;
+    }
+
+    if (page.texture.loadFromImage(page.image))
+        page.texture.setSmooth(true);
+}
+
+sf::Glyph sfDistanceField::getGlyph(const sf::Font& font, sf::Uint32 codePoint, unsigned int characterSize, bool bold)
+{
+    loadGlyphs(font, &codePoint, 1, bold);
+
+    sf::Glyph glyph = page.glyphs[glyphKey(codePoint, bold, 0)];
+    float scale = static_cast<float>(characterSize) / baseSize;
+
+    glyph.advance *= scale;
+    glyph.bounds.left *= scale;
+    glyph.bounds.top *= scale;
+    glyph.bounds.width *= scale;
+    glyph.bounds.height *= scale;
+
+    return glyph;
+}
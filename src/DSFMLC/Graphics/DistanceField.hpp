@@ -0,0 +1,57 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_DISTANCEFIELD_HPP
+#define DSFML_DISTANCEFIELD_HPP
+
+#include <DSFMLC/Graphics/GlyphPage.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <cstddef>
+
+// Glyphs stored as signed distance fields, which are rasterized once at a base
+// size and can then be drawn at any character size with a distance field shader
+struct sfDistanceField
+{
+    sfDistanceField();
+
+    // Discard the glyphs, and generate the next ones with new settings (a base size of 0 disables the distance field)
+    void reset(unsigned int baseSize, unsigned int spread);
+
+    bool isEnabled() const;
+
+    // Generate the distance fields of the glyphs that are not in the page yet
+    void loadGlyphs(const sf::Font& font, const sf::Uint32* codePoints, std::size_t count, bool bold);
+
+    // Get a glyph, scaled to a character size
+    sf::Glyph getGlyph(const sf::Font& font, sf::Uint32 codePoint, unsigned int characterSize, bool bold);
+
+    unsigned int baseSize;
+    unsigned int spread;
+    sfGlyphPage  page;
+};
+
+#endif // DSFML_DISTANCEFIELD_HPP
@@ -0,0 +1,74 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_DRAWBATCH_HPP
+#define DSFML_DRAWBATCH_HPP
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <DSFMLC/Graphics/CreateRenderStates.hpp>
+#include <DSFMLC/Graphics/RenderStateCache.hpp>
+#include <cstring>
+#include <cstddef>
+
+// Check if two draw commands use the same render states
+inline bool haveSameRenderStates(const sfDrawCommand& left, const sfDrawCommand& right)
+{
+    return (left.colorSrcFactor == right.colorSrcFactor) &&
+           (left.colorDstFactor == right.colorDstFactor) &&
+           (left.colorEquation == right.colorEquation) &&
+           (left.alphaSrcFactor == right.alphaSrcFactor) &&
+           (left.alphaDstFactor == right.alphaDstFactor) &&
+           (left.alphaEquation == right.alphaEquation) &&
+           (left.texture == right.texture) &&
+           (left.shader == right.shader) &&
+           (std::memcmp(left.transform, right.transform, sizeof(left.transform)) == 0);
+}
+
+// Draw a list of commands, only rebuilding the render states when they change
+inline void drawBatch(sf::RenderTarget& target, sfRenderStateCache& cache, const sfDrawCommand* commands, size_t commandCount)
+{
+    sf::RenderStates states;
+
+    for (size_t i = 0; i < commandCount; ++i)
+    {
+        const sfDrawCommand& command = commands[i];
+
+        if ((i == 0) || !haveSameRenderStates(command, commands[i - 1]))
+            states = createRenderStates(command);
+
+        if ((command.vertices == NULL) || (command.vertexCount == 0))
+            continue;
+
+        cache.update(states);
+
+        target.draw(static_cast<const sf::Vertex*>(command.vertices), command.vertexCount,
+                    static_cast<sf::PrimitiveType>(command.type), states);
+    }
+}
+
+#endif // DSFML_DRAWBATCH_HPP
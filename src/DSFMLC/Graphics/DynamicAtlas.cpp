@@ -0,0 +1,407 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/DynamicAtlas.h>
+#include <DSFMLC/Graphics/DynamicAtlasStruct.h>
+#include <DSFMLC/Graphics/Texture.h>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+    //Shelves are only shared by regions at least this fraction of their height, so little space is wasted above them
+    const float MinShelfFill = 0.75f;
+
+    bool isEmpty(const sfDynamicAtlasShelf& shelf, unsigned int width)
+    {
+        return (shelf.free.size() == 1) && (shelf.free[0].x == 0) && (shelf.free[0].y == width);
+    }
+
+    //Give a span back to a shelf, merging it with its neighbours
+    void addSpan(sfDynamicAtlasShelf& shelf, unsigned int left, unsigned int width)
+    {
+        std::vector<sf::Vector2u>::iterator it = shelf.free.begin();
+        while ((it != shelf.free.end()) && (it->x < left))
+            ++it;
+
+        it = shelf.free.insert(it, sf::Vector2u(left, width));
+
+        if ((std::next(it) != shelf.free.end()) && (it->x + it->y == std::next(it)->x))
+        {
+            it->y += std::next(it)->y;
+            shelf.free.erase(std::next(it));
+        }
+
+        if ((it != shelf.free.begin()) && (std::prev(it)->x + std::prev(it)->y == it->x))
+        {
+            std::prev(it)->y += it->y;
+            shelf.free.erase(it);
+        }
+    }
+
+    //Find room for a padded region, opening a new shelf if none fits
+    bool allocate(sfDynamicAtlas* atlas, unsigned int width, unsigned int height, sf::Vector2u& position)
+    {
+        sf::Vector2u size = atlas->texture.This->getSize();
+
+        sfDynamicAtlasShelf* best = NULL;
+        std::vector<sf::Vector2u>::iterator bestSpan;
+
+        for (std::size_t i = 0; i < atlas->shelves.size(); ++i)
+        {
+            sfDynamicAtlasShelf& shelf = atlas->shelves[i];
+
+            if ((shelf.height < height) || (best && (best->height <= shelf.height)))
+                continue;
+
+            if ((height < shelf.height * MinShelfFill) && !isEmpty(shelf, size.x))
+                continue;
+
+            for (std::vector<sf::Vector2u>::iterator span = shelf.free.begin(); span != shelf.free.end(); ++span)
+            {
+                if (span->y >= width)
+                {
+                    best = &shelf;
+                    bestSpan = span;
+                    break;
+                }
+            }
+        }
+
+        if (best)
+        {
+            position = sf::Vector2u(bestSpan->x, best->top);
+            bestSpan->x += width;
+            bestSpan->y -= width;
+
+            if (!bestSpan->y)
+                best->free.erase(bestSpan);
+
+            return true;
+        }
+
+        if ((atlas->top + height > size.y) || (width > size.x))
+            return false;
+
+        sfDynamicAtlasShelf shelf;
+        shelf.top = atlas->top;
+        shelf.height = height;
+        if (width < size.x)
+            shelf.free.push_back(sf::Vector2u(width, size.x - width));
+
+        atlas->shelves.push_back(shelf);
+        atlas->top += height;
+        position = sf::Vector2u(0, shelf.top);
+
+        return true;
+    }
+
+    //Free the padded area of a region, dropping the shelves left empty at the top
+    void release(sfDynamicAtlas* atlas, const sf::IntRect& rect)
+    {
+        unsigned int width = atlas->texture.This->getSize().x;
+
+        for (std::size_t i = 0; i < atlas->shelves.size(); ++i)
+        {
+            if (atlas->shelves[i].top == static_cast<unsigned int>(rect.top))
+            {
+                addSpan(atlas->shelves[i], rect.left, rect.width + atlas->padding);
+                break;
+            }
+        }
+
+        while (!atlas->shelves.empty() && isEmpty(atlas->shelves.back(), width))
+        {
+            atlas->top -= atlas->shelves.back().height;
+            atlas->shelves.pop_back();
+        }
+
+        atlas->usedArea -= static_cast<unsigned long long>(rect.width + atlas->padding) * (rect.height + atlas->padding);
+        atlas->fragmented = true;
+    }
+
+    void touch(sfDynamicAtlas* atlas, sfDynamicAtlasEntry& entry)
+    {
+        atlas->uses.splice(atlas->uses.end(), atlas->uses, entry.use);
+    }
+
+    void erase(sfDynamicAtlas* atlas, DUint id)
+    {
+        std::unordered_map<DUint, sfDynamicAtlasEntry>::iterator it = atlas->entries.find(id);
+
+        release(atlas, it->second.rect);
+        atlas->uses.erase(it->second.use);
+        atlas->entries.erase(it);
+    }
+
+    //Double the smaller side of the page, keeping what it holds
+    bool grow(sfDynamicAtlas* atlas)
+    {
+        sf::Texture& texture = *atlas->texture.This;
+        sf::Vector2u size = texture.getSize();
+        sf::Vector2u newSize = size;
+
+        if ((size.x <= size.y) && (size.x < atlas->maxWidth))
+            newSize.x = std::min(size.x * 2, atlas->maxWidth);
+        else if (size.y < atlas->maxHeight)
+            newSize.y = std::min(size.y * 2, atlas->maxHeight);
+        else if (size.x < atlas->maxWidth)
+            newSize.x = std::min(size.x * 2, atlas->maxWidth);
+        else
+            return false;
+
+        sf::Image contents = texture.copyToImage();
+        if (!texture.create(newSize.x, newSize.y))
+            return false;
+
+        texture.update(contents, 0, 0);
+
+        if (newSize.x > size.x)
+        {
+            for (std::size_t i = 0; i < atlas->shelves.size(); ++i)
+                addSpan(atlas->shelves[i], size.x, newSize.x - size.x);
+        }
+
+        atlas->growCount++;
+        atlas->uploadCount++;
+        atlas->uploadedBytes += static_cast<unsigned long long>(size.x) * size.y * 4;
+
+        return true;
+    }
+
+    //Lay out all the regions again from scratch, tallest first
+    bool compact(sfDynamicAtlas* atlas)
+    {
+        std::vector<DUint> ids;
+        for (std::unordered_map<DUint, sfDynamicAtlasEntry>::const_iterator it = atlas->entries.begin(); it != atlas->entries.end(); ++it)
+            ids.push_back(it->first);
+
+        std::sort(ids.begin(), ids.end(), [atlas](DUint first, DUint second)
+        {
+            const sf::IntRect& a = atlas->entries[first].rect;
+            const sf::IntRect& b = atlas->entries[second].rect;
+            return (a.height != b.height) ? (a.height > b.height) : (a.width > b.width);
+        });
+
+        std::vector<sfDynamicAtlasShelf> shelves;
+        std::swap(shelves, atlas->shelves);
+        unsigned int top = atlas->top;
+        atlas->top = 0;
+
+        std::vector<sf::Vector2u> positions(ids.size());
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            const sf::IntRect& rect = atlas->entries[ids[i]].rect;
+
+            //Very unlikely since the layout only gets tighter, but the old one still works
+            if (!allocate(atlas, rect.width + atlas->padding, rect.height + atlas->padding, positions[i]))
+            {
+                std::swap(shelves, atlas->shelves);
+                atlas->top = top;
+                return false;
+            }
+        }
+
+        sf::Texture& texture = *atlas->texture.This;
+        sf::Vector2u size = texture.getSize();
+        sf::Image contents = texture.copyToImage();
+        sf::Image compacted;
+        compacted.create(size.x, size.y, sf::Color::Transparent);
+
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            sf::IntRect& rect = atlas->entries[ids[i]].rect;
+            compacted.copy(contents, positions[i].x, positions[i].y, rect);
+            rect.left = positions[i].x;
+            rect.top = positions[i].y;
+        }
+
+        texture.update(compacted);
+
+        atlas->fragmented = false;
+        atlas->compactCount++;
+        atlas->uploadCount++;
+        atlas->uploadedBytes += static_cast<unsigned long long>(size.x) * size.y * 4;
+
+        return true;
+    }
+}
+
+sfDynamicAtlas* sfDynamicAtlas_construct(DUint width, DUint height, DUint maxWidth, DUint maxHeight, DUint padding, DBool allowEviction)
+{
+    sfDynamicAtlas* atlas = new sfDynamicAtlas;
+
+    unsigned int maximumSize = sf::Texture::getMaximumSize();
+    atlas->maxWidth = std::min(std::max(maxWidth, width), maximumSize);
+    atlas->maxHeight = std::min(std::max(maxHeight, height), maximumSize);
+    atlas->padding = padding;
+    atlas->allowEviction = allowEviction == DTrue;
+
+    if (!atlas->texture.This->create(std::min(width, atlas->maxWidth), std::min(height, atlas->maxHeight)))
+        sf::err() << "Failed to create dynamic atlas texture" << std::endl;
+
+    return atlas;
+}
+
+void sfDynamicAtlas_destroy(sfDynamicAtlas* atlas)
+{
+    delete atlas;
+}
+
+DUint sfDynamicAtlas_insert(sfDynamicAtlas* atlas, const DUbyte* pixels, DUint width, DUint height)
+{
+    unsigned int paddedWidth = width + atlas->padding;
+    unsigned int paddedHeight = height + atlas->padding;
+
+    if (!width || !height || (paddedWidth > atlas->maxWidth) || (paddedHeight > atlas->maxHeight))
+    {
+        sf::err() << "Failed to insert a " << width << "x" << height << " region in dynamic atlas: "
+                  << "it is empty or larger than the maximum size (" << atlas->maxWidth << "x" << atlas->maxHeight << ")" << std::endl;
+        return 0;
+    }
+
+    sf::Vector2u position;
+    bool placed = allocate(atlas, paddedWidth, paddedHeight, position);
+
+    while (!placed && grow(atlas))
+        placed = allocate(atlas, paddedWidth, paddedHeight, position);
+
+    if (!placed && atlas->fragmented)
+        placed = compact(atlas) && allocate(atlas, paddedWidth, paddedHeight, position);
+
+    //Evict enough of the least recently used regions to make room, then close the holes they leave
+    unsigned long long area = static_cast<unsigned long long>(paddedWidth) * paddedHeight;
+    while (!placed && atlas->allowEviction && !atlas->uses.empty())
+    {
+        unsigned long long freed = 0;
+        while ((freed < area) && !atlas->uses.empty())
+        {
+            const sf::IntRect& rect = atlas->entries[atlas->uses.front()].rect;
+            freed += static_cast<unsigned long long>(rect.width + atlas->padding) * (rect.height + atlas->padding);
+
+            erase(atlas, atlas->uses.front());
+            atlas->evictionCount++;
+        }
+
+        placed = allocate(atlas, paddedWidth, paddedHeight, position) ||
+                 (compact(atlas) && allocate(atlas, paddedWidth, paddedHeight, position));
+    }
+
+    if (!placed)
+    {
+        sf::err() << "Failed to insert a " << width << "x" << height << " region in dynamic atlas: the atlas is full" << std::endl;
+        return 0;
+    }
+
+    DUint id = atlas->nextId++;
+
+    sfDynamicAtlasEntry& entry = atlas->entries[id];
+    entry.rect = sf::IntRect(position.x, position.y, width, height);
+    entry.use = atlas->uses.insert(atlas->uses.end(), id);
+    atlas->usedArea += area;
+
+    sfTexture_updateFromPixels(&atlas->texture, pixels, width, height, position.x, position.y);
+    atlas->uploadCount++;
+    atlas->uploadedBytes += static_cast<unsigned long long>(width) * height * 4;
+
+    return id;
+}
+
+DBool sfDynamicAtlas_update(sfDynamicAtlas* atlas, DUint id, const DUbyte* pixels)
+{
+    std::unordered_map<DUint, sfDynamicAtlasEntry>::iterator it = atlas->entries.find(id);
+
+    if (it == atlas->entries.end())
+        return DFalse;
+
+    const sf::IntRect& rect = it->second.rect;
+    sfTexture_updateFromPixels(&atlas->texture, pixels, rect.width, rect.height, rect.left, rect.top);
+    atlas->uploadCount++;
+    atlas->uploadedBytes += static_cast<unsigned long long>(rect.width) * rect.height * 4;
+
+    touch(atlas, it->second);
+
+    return DTrue;
+}
+
+DBool sfDynamicAtlas_remove(sfDynamicAtlas* atlas, DUint id)
+{
+    if (atlas->entries.find(id) == atlas->entries.end())
+        return DFalse;
+
+    erase(atlas, id);
+
+    return DTrue;
+}
+
+DBool sfDynamicAtlas_getRegion(sfDynamicAtlas* atlas, DUint id, DInt* left, DInt* top, DInt* width, DInt* height)
+{
+    std::unordered_map<DUint, sfDynamicAtlasEntry>::iterator it = atlas->entries.find(id);
+
+    if (it == atlas->entries.end())
+        return DFalse;
+
+    const sf::IntRect& rect = it->second.rect;
+    *left = rect.left;
+    *top = rect.top;
+    *width = rect.width;
+    *height = rect.height;
+
+    touch(atlas, it->second);
+
+    return DTrue;
+}
+
+DBool sfDynamicAtlas_compact(sfDynamicAtlas* atlas)
+{
+    return compact(atlas) ? DTrue : DFalse;
+}
+
+sfTexture* sfDynamicAtlas_getTexture(const sfDynamicAtlas* atlas)
+{
+    //The page keeps the same texture when it grows, so the wrapper stays valid
+    return new sfTexture(atlas->texture.This);
+}
+
+void sfDynamicAtlas_getStatistics(const sfDynamicAtlas* atlas, DUint* regionCount, DUint* width, DUint* height, DUint* growCount, DUint* compactCount, DUint* evictionCount, DUint* uploadCount, DUlong* uploadedBytes, float* fragmentation)
+{
+    sf::Vector2u size = atlas->texture.This->getSize();
+    unsigned long long shelfArea = static_cast<unsigned long long>(size.x) * atlas->top;
+
+    *regionCount = static_cast<DUint>(atlas->entries.size());
+    *width = size.x;
+    *height = size.y;
+    *growCount = atlas->growCount;
+    *compactCount = atlas->compactCount;
+    *evictionCount = atlas->evictionCount;
+    *uploadCount = atlas->uploadCount;
+    *uploadedBytes = atlas->uploadedBytes;
+
+    //Share of the space taken by shelves that no region covers
+    *fragmentation = shelfArea ? 1.f - static_cast<float>(static_cast<double>(atlas->usedArea) / shelfArea) : 0.f;
+}
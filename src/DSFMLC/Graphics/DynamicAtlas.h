@@ -0,0 +1,61 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_DYNAMICATLAS_H
+#define DSFML_DYNAMICATLAS_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <DSFMLC/Graphics/Types.h>
+
+//Construct a new dynamic atlas, with a page that grows up to a maximum size
+DSFML_GRAPHICS_API sfDynamicAtlas* sfDynamicAtlas_construct(DUint width, DUint height, DUint maxWidth, DUint maxHeight, DUint padding, DBool allowEviction);
+
+//Destroy an existing dynamic atlas
+DSFML_GRAPHICS_API void sfDynamicAtlas_destroy(sfDynamicAtlas* atlas);
+
+//Allocate a region for an array of RGBA pixels and upload them, returning its id or 0 on failure
+DSFML_GRAPHICS_API DUint sfDynamicAtlas_insert(sfDynamicAtlas* atlas, const DUbyte* pixels, DUint width, DUint height);
+
+//Upload new pixels to an existing region
+DSFML_GRAPHICS_API DBool sfDynamicAtlas_update(sfDynamicAtlas* atlas, DUint id, const DUbyte* pixels);
+
+//Free a region
+DSFML_GRAPHICS_API DBool sfDynamicAtlas_remove(sfDynamicAtlas* atlas, DUint id);
+
+//Get the area of the page covered by a region, marking it as recently used
+DSFML_GRAPHICS_API DBool sfDynamicAtlas_getRegion(sfDynamicAtlas* atlas, DUint id, DInt* left, DInt* top, DInt* width, DInt* height);
+
+//Move all the regions next to each other to get rid of the holes left by freed ones
+DSFML_GRAPHICS_API DBool sfDynamicAtlas_compact(sfDynamicAtlas* atlas);
+
+//Get the texture of the atlas
+DSFML_GRAPHICS_API sfTexture* sfDynamicAtlas_getTexture(const sfDynamicAtlas* atlas);
+
+//Get the number of regions, the page size, how often the page was grown and compacted, how many regions were evicted, the uploads and the fragmentation
+DSFML_GRAPHICS_API void sfDynamicAtlas_getStatistics(const sfDynamicAtlas* atlas, DUint* regionCount, DUint* width, DUint* height, DUint* growCount, DUint* compactCount, DUint* evictionCount, DUint* uploadCount, DUlong* uploadedBytes, float* fragmentation);
+
+#endif // DSFML_DYNAMICATLAS_H
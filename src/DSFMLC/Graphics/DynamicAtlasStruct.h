@@ -0,0 +1,102 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_DYNAMICATLASSTRUCT_H
+#define DSFML_DYNAMICATLASSTRUCT_H
+
+#include <DSFMLC/Graphics/TextureStruct.h>
+#include <SFML/Graphics/Rect.hpp>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+//A row of regions sharing the same height
+struct sfDynamicAtlasShelf
+{
+    unsigned int top;
+    unsigned int height;
+
+    //Free spans of the shelf as (left, width), sorted from left to right
+    std::vector<sf::Vector2u> free;
+};
+
+//A region given out by the atlas
+struct sfDynamicAtlasEntry
+{
+    sf::IntRect rect;
+    std::list<DUint>::iterator use;
+};
+
+//Internal structure of sfDynamicAtlas
+struct sfDynamicAtlas
+{
+    sfDynamicAtlas() :
+    maxWidth(0),
+    maxHeight(0),
+    padding(0),
+    allowEviction(false),
+    top(0),
+    nextId(1),
+    usedArea(0),
+    fragmented(false),
+    growCount(0),
+    compactCount(0),
+    evictionCount(0),
+    uploadCount(0),
+    uploadedBytes(0)
+    {
+    }
+
+    sfTexture texture;
+    unsigned int maxWidth;
+    unsigned int maxHeight;
+    unsigned int padding;
+    bool allowEviction;
+
+    std::vector<sfDynamicAtlasShelf> shelves;
+    unsigned int top;
+
+    std::unordered_map<DUint, sfDynamicAtlasEntry> entries;
+
+    //Ids of the regions, least recently used first
+    std::list<DUint> uses;
+    DUint nextId;
+
+    //Area of the regions including their padding
+    unsigned long long usedArea;
+
+    //Whether regions were freed since the last compaction
+    bool fragmented;
+
+    unsigned int growCount;
+    unsigned int compactCount;
+    unsigned int evictionCount;
+    unsigned int uploadCount;
+    unsigned long long uploadedBytes;
+};
+
+#endif // DSFML_DYNAMICATLASSTRUCT_H
@@ -27,7 +27,111 @@
 
 #include <DSFMLC/Graphics/Font.h>
 #include <DSFMLC/Graphics/FontStruct.h>
+#include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+    //Identifies files written by sfFont_saveGlyphAtlas
+    const char atlasMagic[8] = {'D', 'S', 'F', 'M', 'L', 'G', 'L', 'A'};
+    const sf::Uint32 atlasVersion = 1;
+
+    //Longer family names than this only come from corrupted files
+    const sf::Uint32 atlasMaximumFamilyLength = 1024;
+
+    //Get a glyph from the distance field if it is enabled, from a restored
+    //page if there is one for its size, or else from the font
+    sf::Glyph getGlyph(const sfFont* font, sf::Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness = 0)
+    {
+        //Distance field outlines are drawn by the shader, from the same glyph
+        if (font->DistanceField.isEnabled())
+            return font->DistanceField.getGlyph(font->This, codePoint, characterSize, bold);
+
+        std::map<unsigned int, sfGlyphPage>::iterator page = font->Pages.find(characterSize);
+
+        if (page != font->Pages.end())
+            return page->second.getGlyph(font->This, characterSize, codePoint, bold, outlineThickness);
+
+        return font->This.getGlyph(codePoint, characterSize, bold, outlineThickness);
+    }
+
+    //Copy the glyphs of a string missing from a restored page all at once, instead of one readback per glyph
+    void loadPageGlyphs(const sfFont* font, const sf::Uint32* codePoints, std::size_t count, unsigned int characterSize, bool bold, float outlineThickness = 0)
+    {
+        if (font->DistanceField.isEnabled())
+            return;
+
+        std::map<unsigned int, sfGlyphPage>::iterator page = font->Pages.find(characterSize);
+
+        if (page != font->Pages.end())
+            page->second.loadGlyphs(font->This, characterSize, codePoints, count, bold, outlineThickness);
+    }
+
+    //Text styles, with the same values as the ones of DSFML's Text.Style
+    enum TextStyle
+    {
+        Bold          = 1 << 0,
+        Italic        = 1 << 1,
+        Underlined    = 1 << 2,
+        StrikeThrough = 1 << 3
+    };
+
+    //A vertex array being filled by the text layout, which never writes past its capacity
+    struct VertexOutput
+    {
+        sf::Vertex* vertices;
+        size_t capacity;
+        size_t count;
+
+        void append(float x, float y, const sf::Color& color, float u, float v)
+        {
+            if (count < capacity)
+                vertices[count] = sf::Vertex(sf::Vector2f(x, y), color, sf::Vector2f(u, v));
+            ++count;
+        }
+    };
+
+    //Add an underline or strikethrough line to a vertex array
+    void addLine(VertexOutput& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness, float outlineThickness = 0)
+    {
+        float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
+        float bottom = top + std::floor(thickness + 0.5f);
+
+        vertices.append(-outlineThickness,             top    - outlineThickness, color, 1, 1);
+        vertices.append(lineLength + outlineThickness, top    - outlineThickness, color, 1, 1);
+        vertices.append(-outlineThickness,             bottom + outlineThickness, color, 1, 1);
+        vertices.append(-outlineThickness,             bottom + outlineThickness, color, 1, 1);
+        vertices.append(lineLength + outlineThickness, top    - outlineThickness, color, 1, 1);
+        vertices.append(lineLength + outlineThickness, bottom + outlineThickness, color, 1, 1);
+    }
+
+    //Add a glyph quad to a vertex array
+    void addGlyphQuad(VertexOutput& vertices, float x, float y, const sf::Color& color, const sf::Glyph& glyph, float italic, float outlineThickness = 0)
+    {
+        float left   = glyph.bounds.left;
+        float top    = glyph.bounds.top;
+        float right  = glyph.bounds.left + glyph.bounds.width;
+        float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+        float u1 = static_cast<float>(glyph.textureRect.left);
+        float v1 = static_cast<float>(glyph.textureRect.top);
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
+
+        vertices.append(x + left  - italic * top    - outlineThickness, y + top    - outlineThickness, color, u1, v1);
+        vertices.append(x + right - italic * top    - outlineThickness, y + top    - outlineThickness, color, u2, v1);
+        vertices.append(x + left  - italic * bottom - outlineThickness, y + bottom - outlineThickness, color, u1, v2);
+        vertices.append(x + left  - italic * bottom - outlineThickness, y + bottom - outlineThickness, color, u1, v2);
+        vertices.append(x + right - italic * top    - outlineThickness, y + top    - outlineThickness, color, u2, v1);
+        vertices.append(x + right - italic * bottom - outlineThickness, y + bottom - outlineThickness, color, u2, v2);
+    }
+}
 
 sfFont* sfFont_construct()
 {
@@ -37,16 +141,28 @@ sfFont* sfFont_construct()
 
 DBool sfFont_loadFromFile(sfFont* font, const char* filename, size_t length)
 {
+    font->Pages.clear();
+    font->PreloadedGlyphs.clear();
+    font->DistanceField.reset(font->DistanceField.baseSize, font->DistanceField.spread);
+
     return (font->This.loadFromFile(std::string(filename, length)))?DTrue:DFalse;
 }
 
 DBool sfFont_loadFromMemory(sfFont* font, const void* data, size_t sizeInBytes)
 {
+    font->Pages.clear();
+    font->PreloadedGlyphs.clear();
+    font->DistanceField.reset(font->DistanceField.baseSize, font->DistanceField.spread);
+
     return (font->This.loadFromMemory(data, sizeInBytes))?DTrue:DFalse;
 }
 
 DBool sfFont_loadFromStream(sfFont* font, DStream* stream)
 {
+    font->Pages.clear();
+    font->PreloadedGlyphs.clear();
+    font->DistanceField.reset(font->DistanceField.baseSize, font->DistanceField.spread);
+
     font->Stream = sfmlStream(stream);
     return (font->This.loadFromStream(font->Stream))?DTrue:DFalse;
 }
@@ -63,7 +179,7 @@ void sfFont_destroy(sfFont* font)
 
 void sfFont_getGlyph(const sfFont* font, DUint codePoint, DInt characterSize, DBool bold, float outlineThickness, float* glyphAdvance, float* glyphBoundsLeft, float* glyphBoundsTop, float* glyphBoundsWidth, float* glyphBoundsHeight, DInt* glyphTextRectLeft, DInt* glyphTextRectTop, DInt* glyphTextRectWidth, DInt* glyphTextRectHeight)
 {
-    sf::Glyph SFMLGlyph = font->This.getGlyph(codePoint, characterSize, bold == DTrue, outlineThickness);
+    sf::Glyph SFMLGlyph = getGlyph(font, codePoint, characterSize, bold == DTrue, outlineThickness);
 
     *glyphAdvance           = SFMLGlyph.advance;
     *glyphBoundsLeft        = SFMLGlyph.bounds.left;
@@ -98,6 +214,395 @@ float sfFont_getUnderlineThickness(const sfFont* font, DUint characterSize)
 
 sfTexture* sfFont_getTexture(const sfFont* font, DUint characterSize)
 {
+    if (font->DistanceField.isEnabled())
+        return new sfTexture(&font->DistanceField.page.texture);
+
+    std::map<unsigned int, sfGlyphPage>::iterator page = font->Pages.find(characterSize);
+
+    if (page != font->Pages.end())
+        return new sfTexture(&page->second.texture);
+
     //This is safe because the D Texture that uses this is only exposed as const 
     return new sfTexture(const_cast<sf::Texture*>(&(font->This.getTexture(characterSize))));
 }
+
+void sfFont_buildTextGeometry(const sfFont* font, const DUint* text, size_t length, DUint characterSize, DUint style, float outlineThickness,
+                              DUbyte fillR, DUbyte fillG, DUbyte fillB, DUbyte fillA, DUbyte outlineR, DUbyte outlineG, DUbyte outlineB, DUbyte outlineA,
+                              void* vertices, size_t vertexCapacity, size_t* vertexCount,
+                              void* outlineVertices, size_t outlineVertexCapacity, size_t* outlineVertexCount,
+                              float* boundsLeft, float* boundsTop, float* boundsWidth, float* boundsHeight)
+{
+    const sf::Font& sfmlFont = font->This;
+    sf::Color fillColor(fillR, fillG, fillB, fillA);
+    sf::Color outlineColor(outlineR, outlineG, outlineB, outlineA);
+
+    VertexOutput fill = {static_cast<sf::Vertex*>(vertices), vertexCapacity, 0};
+    VertexOutput outline = {static_cast<sf::Vertex*>(outlineVertices), outlineVertexCapacity, 0};
+
+    *boundsLeft = *boundsTop = *boundsWidth = *boundsHeight = 0;
+
+    if (length == 0)
+    {
+        *vertexCount = 0;
+        *outlineVertexCount = 0;
+        return;
+    }
+
+    //Compute values related to the text style
+    bool  bold               = (style & Bold) != 0;
+    bool  distanceField      = font->DistanceField.isEnabled();
+    float glyphOutline       = distanceField ? 0.f : outlineThickness;
+    bool  underlined         = (style & Underlined) != 0;
+    bool  strikeThrough      = (style & StrikeThrough) != 0;
+    float italic             = (style & Italic) ? 0.208f : 0.f; // 12 degrees
+    float underlineOffset    = sfmlFont.getUnderlinePosition(characterSize);
+    float underlineThickness = sfmlFont.getUnderlineThickness(characterSize);
+
+    //Generate all of the missing distance field glyphs at once
+    if (distanceField)
+    {
+        const sf::Uint32 spaceAndX[] = {L' ', L'x'};
+        font->DistanceField.loadGlyphs(sfmlFont, spaceAndX, 2, bold);
+        font->DistanceField.loadGlyphs(sfmlFont, text, length, bold);
+    }
+    else
+    {
+        const sf::Uint32 spaceAndX[] = {L' ', L'x'};
+        loadPageGlyphs(font, spaceAndX, 2, characterSize, bold);
+        loadPageGlyphs(font, text, length, characterSize, bold);
+
+        if (glyphOutline != 0)
+            loadPageGlyphs(font, text, length, characterSize, bold, glyphOutline);
+    }
+
+    //Compute the location of the strike through dynamically
+    //We use the center point of the lowercase 'x' glyph as the reference
+    //We reuse the underline thickness as the thickness of the strike through as well
+    sf::FloatRect xBounds = getGlyph(font, L'x', characterSize, bold).bounds;
+    float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+
+    //Precompute the variables needed by the algorithm
+    float hspace = getGlyph(font, L' ', characterSize, bold).advance;
+    float vspace = sfmlFont.getLineSpacing(characterSize);
+    float x      = 0.f;
+    float y      = static_cast<float>(characterSize);
+
+    //Create one quad for each character
+    float minX = static_cast<float>(characterSize);
+    float minY = static_cast<float>(characterSize);
+    float maxX = 0.f;
+    float maxY = 0.f;
+    DUint prevChar = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        DUint curChar = text[i];
+
+        //Apply the kerning offset
+        x += sfmlFont.getKerning(prevChar, curChar, characterSize);
+        prevChar = curChar;
+
+        //If we're using the underlined style and there's a new line, draw a line
+        if (underlined && (curChar == L'\n'))
+        {
+            addLine(fill, x, y, fillColor, underlineOffset, underlineThickness);
+
+            if (outlineThickness != 0)
+                addLine(outline, x, y, outlineColor, underlineOffset, underlineThickness, outlineThickness);
+        }
+
+        //If we're using the strike through style and there's a new line, draw a line across all characters
+        if (strikeThrough && (curChar == L'\n'))
+        {
+            addLine(fill, x, y, fillColor, strikeThroughOffset, underlineThickness);
+
+            if (outlineThickness != 0)
+                addLine(outline, x, y, outlineColor, strikeThroughOffset, underlineThickness, outlineThickness);
+        }
+
+        //Handle special characters
+        if ((curChar == L' ') || (curChar == L'\t') || (curChar == L'\n'))
+        {
+            //Update the current bounds (min coordinates)
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+
+            switch (curChar)
+            {
+                case L' ':  x += hspace;        break;
+                case L'\t': x += hspace * 4;    break;
+                case L'\n': y += vspace; x = 0; break;
+            }
+
+            //Update the current bounds (max coordinates)
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+
+            //Next glyph, no need to create a quad for whitespace
+            continue;
+        }
+
+        //Apply the outline
+        if (outlineThickness != 0)
+        {
+            const sf::Glyph& glyph = getGlyph(font, curChar, characterSize, bold, glyphOutline);
+
+            float left   = glyph.bounds.left;
+            float top    = glyph.bounds.top;
+            float right  = glyph.bounds.left + glyph.bounds.width;
+            float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+            //Add the outline glyph to the vertices
+            addGlyphQuad(outline, x, y, outlineColor, glyph, italic, glyphOutline);
+
+            //Update the current bounds with the outlined glyph bounds
+            minX = std::min(minX, x + left   - italic * bottom - glyphOutline);
+            maxX = std::max(maxX, x + right  - italic * top    - glyphOutline);
+            minY = std::min(minY, y + top    - glyphOutline);
+            maxY = std::max(maxY, y + bottom - glyphOutline);
+        }
+
+        //Extract the current glyph's description
+        const sf::Glyph& glyph = getGlyph(font, curChar, characterSize, bold);
+
+        //Add the glyph to the vertices
+        addGlyphQuad(fill, x, y, fillColor, glyph, italic);
+
+        //Update the current bounds with the non outlined glyph bounds
+        if (outlineThickness == 0)
+        {
+            float left   = glyph.bounds.left;
+            float top    = glyph.bounds.top;
+            float right  = glyph.bounds.left + glyph.bounds.width;
+            float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+            minX = std::min(minX, x + left  - italic * bottom);
+            maxX = std::max(maxX, x + right - italic * top);
+            minY = std::min(minY, y + top);
+            maxY = std::max(maxY, y + bottom);
+        }
+
+        //Advance to the next character
+        x += glyph.advance;
+    }
+
+    //If we're using the underlined style, add the last line
+    if (underlined && (x > 0))
+    {
+        addLine(fill, x, y, fillColor, underlineOffset, underlineThickness);
+
+        if (outlineThickness != 0)
+            addLine(outline, x, y, outlineColor, underlineOffset, underlineThickness, outlineThickness);
+    }
+
+    //If we're using the strike through style, add the last line across all characters
+    if (strikeThrough && (x > 0))
+    {
+        addLine(fill, x, y, fillColor, strikeThroughOffset, underlineThickness);
+
+        if (outlineThickness != 0)
+            addLine(outline, x, y, outlineColor, strikeThroughOffset, underlineThickness, outlineThickness);
+    }
+
+    //Update the bounding rectangle
+    *boundsLeft = minX;
+    *boundsTop = minY;
+    *boundsWidth = maxX - minX;
+    *boundsHeight = maxY - minY;
+
+    //If the arrays were too small, the counts tell how large they need to be
+    *vertexCount = fill.count;
+    *outlineVertexCount = outline.count;
+}
+
+void sfFont_findCharacterPos(const sfFont* font, const DUint* text, size_t length, size_t index, DUint characterSize, DBool bold, float* x, float* y)
+{
+    const sf::Font& sfmlFont = font->This;
+
+    //Adjust the index if it's out of range
+    if (index > length)
+        index = length;
+
+    loadPageGlyphs(font, text, index, characterSize, bold == DTrue);
+
+    //Precompute the variables needed by the algorithm
+    float hspace = getGlyph(font, L' ', characterSize, bold == DTrue).advance;
+    float vspace = sfmlFont.getLineSpacing(characterSize);
+
+    //Compute the position
+    float positionX = 0.f;
+    float positionY = 0.f;
+    DUint prevChar = 0;
+    for (size_t i = 0; i < index; ++i)
+    {
+        DUint curChar = text[i];
+
+        //Apply the kerning offset
+        positionX += sfmlFont.getKerning(prevChar, curChar, characterSize);
+        prevChar = curChar;
+
+        //Handle special characters
+        switch (curChar)
+        {
+            case L' ':  positionX += hspace;                 continue;
+            case L'\t': positionX += hspace * 4;             continue;
+            case L'\n': positionY += vspace; positionX = 0;  continue;
+            case L'\v': positionY += vspace * 4;             continue;
+        }
+
+        //For regular characters, add the advance offset of the glyph
+        positionX += getGlyph(font, curChar, characterSize, bold == DTrue).advance;
+    }
+
+    *x = positionX;
+    *y = positionY;
+}
+
+void sfFont_preloadGlyphs(sfFont* font, const DUint* ranges, size_t rangeCount, const DUint* characterSizes, size_t sizeCount, DBool bold, float outlineThickness)
+{
+    std::vector<sf::Uint32> codePoints;
+    for (size_t j = 0; j < rangeCount; ++j)
+        for (sf::Uint64 codePoint = ranges[j * 2]; codePoint <= ranges[j * 2 + 1]; ++codePoint)
+            codePoints.push_back(static_cast<sf::Uint32>(codePoint));
+
+    for (size_t i = 0; i < sizeCount; ++i)
+    {
+        unsigned int characterSize = characterSizes[i];
+        bool hasPage = font->DistanceField.isEnabled() || (font->Pages.find(characterSize) != font->Pages.end());
+
+        if (!codePoints.empty())
+            loadPageGlyphs(font, &codePoints[0], codePoints.size(), characterSize, bold == DTrue, outlineThickness);
+
+        for (size_t j = 0; j < rangeCount; ++j)
+        {
+            for (sf::Uint64 codePoint = ranges[j * 2]; codePoint <= ranges[j * 2 + 1]; ++codePoint)
+            {
+                sf::Glyph glyph = getGlyph(font, static_cast<sf::Uint32>(codePoint), characterSize, bold == DTrue, outlineThickness);
+
+                //Remember the glyphs rasterized by the font, so that they can be saved to an atlas
+                if (!hasPage)
+                    font->PreloadedGlyphs[characterSize][glyphKey(static_cast<sf::Uint32>(codePoint), bold == DTrue, outlineThickness)] = glyph;
+            }
+        }
+    }
+}
+
+DBool sfFont_saveGlyphAtlas(const sfFont* font, const char* filename, size_t length)
+{
+    std::string path(filename, length);
+    std::ofstream file(path.c_str(), std::ios::binary);
+
+    if (!file)
+    {
+        sf::err() << "Failed to save glyph atlas \"" << path << "\" (couldn't open the file)" << std::endl;
+        return DFalse;
+    }
+
+    //Pages for the preloaded glyphs are built now, repacking the glyphs as they are copied
+    std::map<unsigned int, sfGlyphPage> pages = font->Pages;
+    for (std::map<unsigned int, std::map<sf::Uint64, sf::Glyph> >::const_iterator it = font->PreloadedGlyphs.begin(); it != font->PreloadedGlyphs.end(); ++it)
+    {
+        if (pages.find(it->first) == pages.end())
+            pages[it->first].copyFromFont(font->This, it->first, it->second);
+    }
+
+    const std::string& family = font->This.getInfo().family;
+
+    file.write(atlasMagic, sizeof(atlasMagic));
+    file.write(reinterpret_cast<const char*>(&atlasVersion), sizeof(atlasVersion));
+
+    sf::Uint32 familyLength = static_cast<sf::Uint32>(family.size());
+    file.write(reinterpret_cast<const char*>(&familyLength), sizeof(familyLength));
+    file.write(family.data(), familyLength);
+
+    sf::Uint32 pageCount = static_cast<sf::Uint32>(pages.size());
+    file.write(reinterpret_cast<const char*>(&pageCount), sizeof(pageCount));
+
+    for (std::map<unsigned int, sfGlyphPage>::const_iterator it = pages.begin(); it != pages.end(); ++it)
+    {
+        sf::Uint32 characterSize = it->first;
+        file.write(reinterpret_cast<const char*>(&characterSize), sizeof(characterSize));
+
+        if (!it->second.save(file))
+            break;
+    }
+
+    if (!file)
+    {
+        sf::err() << "Failed to save glyph atlas \"" << path << "\" (couldn't write to the file)" << std::endl;
+        return DFalse;
+    }
+
+    return DTrue;
+}
+
+DBool sfFont_loadGlyphAtlas(sfFont* font, const char* filename, size_t length)
+{
+    std::string path(filename, length);
+    std::ifstream file(path.c_str(), std::ios::binary);
+
+    char magic[sizeof(atlasMagic)];
+    sf::Uint32 version = 0;
+    sf::Uint32 familyLength = 0;
+
+    if (!file.read(magic, sizeof(magic)) || (std::memcmp(magic, atlasMagic, sizeof(magic)) != 0) ||
+        !file.read(reinterpret_cast<char*>(&version), sizeof(version)) || (version != atlasVersion) ||
+        !file.read(reinterpret_cast<char*>(&familyLength), sizeof(familyLength)))
+    {
+        sf::err() << "Failed to load glyph atlas \"" << path << "\" (not a glyph atlas, or an unsupported version)" << std::endl;
+        return DFalse;
+    }
+
+    if (familyLength > atlasMaximumFamilyLength)
+    {
+        sf::err() << "Failed to load glyph atlas \"" << path << "\" (the file is truncated or corrupted)" << std::endl;
+        return DFalse;
+    }
+
+    std::string family(familyLength, '\0');
+    if ((familyLength > 0) && !file.read(&family[0], familyLength))
+    {
+        sf::err() << "Failed to load glyph atlas \"" << path << "\" (the file is truncated or corrupted)" << std::endl;
+        return DFalse;
+    }
+
+    //Glyph metrics depend on the font, so an atlas can only be used with the font it was saved from
+    if (family != font->This.getInfo().family)
+    {
+        sf::err() << "Failed to load glyph atlas \"" << path << "\" (it was saved from the font \"" << family << "\")" << std::endl;
+        return DFalse;
+    }
+
+    sf::Uint32 pageCount = 0;
+    if (!file.read(reinterpret_cast<char*>(&pageCount), sizeof(pageCount)))
+    {
+        sf::err() << "Failed to load glyph atlas \"" << path << "\" (the file is truncated or corrupted)" << std::endl;
+        return DFalse;
+    }
+
+    std::map<unsigned int, sfGlyphPage> pages;
+    for (sf::Uint32 i = 0; i < pageCount; ++i)
+    {
+        sf::Uint32 characterSize = 0;
+
+        if (!file.read(reinterpret_cast<char*>(&characterSize), sizeof(characterSize)) || !pages[characterSize].load(file))
+        {
+            sf::err() << "Failed to load glyph atlas \"" << path << "\" (the file is truncated or corrupted)" << std::endl;
+            return DFalse;
+        }
+    }
+
+    font->Pages.swap(pages);
+    font->PreloadedGlyphs.clear();
+
+    return DTrue;
+}
+
+void sfFont_setDistanceField(sfFont* font, DUint baseSize, DUint spread)
+{
+    font->DistanceField.reset(baseSize, spread);
+}
+
+DBool sfFont_isDistanceField(const sfFont* font)
+{
+    return font->DistanceField.isEnabled()?DTrue:DFalse;
+}
@@ -69,4 +69,29 @@ DSFML_GRAPHICS_API float sfFont_getUnderlineThickness (const sfFont * font, DUin
 //Get the font texture for a given character size
 DSFML_GRAPHICS_API sfTexture* sfFont_getTexture(const sfFont* font, DUint characterSize);
 
+//Lay out a string and build the vertices of its glyphs, outline and lines
+DSFML_GRAPHICS_API void sfFont_buildTextGeometry(const sfFont* font, const DUint* text, size_t length, DUint characterSize, DUint style, float outlineThickness,
+                                                 DUbyte fillR, DUbyte fillG, DUbyte fillB, DUbyte fillA, DUbyte outlineR, DUbyte outlineG, DUbyte outlineB, DUbyte outlineA,
+                                                 void* vertices, size_t vertexCapacity, size_t* vertexCount,
+                                                 void* outlineVertices, size_t outlineVertexCapacity, size_t* outlineVertexCount,
+                                                 float* boundsLeft, float* boundsTop, float* boundsWidth, float* boundsHeight);
+
+//Find the position of a character in a laid out string
+DSFML_GRAPHICS_API void sfFont_findCharacterPos(const sfFont* font, const DUint* text, size_t length, size_t index, DUint characterSize, DBool bold, float* x, float* y);
+
+//Rasterize the glyphs in some ranges of code points ahead of time, for some character sizes
+DSFML_GRAPHICS_API void sfFont_preloadGlyphs(sfFont* font, const DUint* ranges, size_t rangeCount, const DUint* characterSizes, size_t sizeCount, DBool bold, float outlineThickness);
+
+//Save the rasterized glyphs of a font to a file
+DSFML_GRAPHICS_API DBool sfFont_saveGlyphAtlas(const sfFont* font, const char* filename, size_t length);
+
+//Restore the rasterized glyphs of a font from a file
+DSFML_GRAPHICS_API DBool sfFont_loadGlyphAtlas(sfFont* font, const char* filename, size_t length);
+
+//Enable or disable rendering the glyphs of a font as distance fields (a base size of 0 disables them)
+DSFML_GRAPHICS_API void sfFont_setDistanceField(sfFont* font, DUint baseSize, DUint spread);
+
+//Tell whether a font renders its glyphs as distance fields
+DSFML_GRAPHICS_API DBool sfFont_isDistanceField(const sfFont* font);
+
 #endif // SFML_IMAGE_H
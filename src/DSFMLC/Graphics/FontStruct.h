@@ -30,13 +30,25 @@
 
 #include <SFML/Graphics/Font.hpp>
 #include <DSFMLC/Graphics/TextureStruct.h>
+#include <DSFMLC/Graphics/DistanceField.hpp>
+#include <DSFMLC/Graphics/GlyphPage.hpp>
 #include <DSFMLC/System/DStream.hpp>
+#include <map>
 
 //Internal structure of sfFont
 struct sfFont
 {
     sf::Font This;
     sfmlStream Stream;
+
+    //Glyph pages restored from a saved atlas, which replace the font's own pages
+    mutable std::map<unsigned int, sfGlyphPage> Pages;
+
+    //Glyphs that were preloaded from the font's own pages, by character size
+    std::map<unsigned int, std::map<sf::Uint64, sf::Glyph> > PreloadedGlyphs;
+
+    //Distance field glyphs, used for every character size when enabled
+    mutable sfDistanceField DistanceField;
 };
 
 #endif // DSFML_FONTSTRUCT_H
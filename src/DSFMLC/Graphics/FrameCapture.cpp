@@ -0,0 +1,262 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/FrameCapture.h>
+#include <DSFMLC/Graphics/FrameCaptureStruct.h>
+#include <DSFMLC/Graphics/RenderWindowStruct.h>
+#include <DSFMLC/Graphics/RenderTextureStruct.h>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+#include <memory>
+
+namespace
+{
+    bool isSignaled(GLenum status)
+    {
+        return (status == GL_ALREADY_SIGNALED) || (status == GL_CONDITION_SATISFIED);
+    }
+
+    void releaseFence(sfFrameCaptureSlot& slot)
+    {
+        if (slot.fence)
+        {
+            glext::deleteSync(slot.fence);
+            slot.fence = NULL;
+        }
+    }
+
+    //Start reading the active framebuffer into the next slot
+    bool capture(sfFrameCapture* capture, sf::Vector2u size)
+    {
+        if (!capture->initialized)
+        {
+            capture->initialized = true;
+            capture->useBuffers = glext::hasMappedBuffers();
+        }
+
+        unsigned int index = capture->next;
+        sfFrameCaptureSlot& slot = capture->slots[index];
+
+        //The oldest frame is overwritten when the reader falls behind
+        if (!capture->pending.empty() && (capture->pending.front() == index))
+        {
+            capture->pending.pop_front();
+            releaseFence(slot);
+            capture->dropCount++;
+        }
+
+        std::size_t bytes = static_cast<std::size_t>(size.x) * size.y * 4;
+        slot.width = size.x;
+        slot.height = size.y;
+
+        if (capture->useBuffers)
+        {
+            GLint previous = 0;
+            glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &previous);
+
+            if (!slot.buffer)
+                glext::genBuffers(1, &slot.buffer);
+
+            glext::bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+
+            if (slot.capacity != bytes)
+            {
+                glext::bufferData(GL_PIXEL_PACK_BUFFER, static_cast<glext::GLsizeiptr>(bytes), NULL, GL_STREAM_READ);
+                slot.capacity = bytes;
+            }
+
+            //With a buffer bound the copy is only queued, and the fence tells when it is done
+            glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            slot.fence = glext::fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+            glext::bindBuffer(GL_PIXEL_PACK_BUFFER, static_cast<GLuint>(previous));
+        }
+        else
+        {
+            slot.pixels.resize(bytes);
+            if (bytes)
+                glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, &slot.pixels[0]);
+        }
+
+        slot.frame = ++capture->frameCount;
+        slot.clock.restart();
+
+        capture->pending.push_back(index);
+        capture->next = (index + 1) % capture->slots.size();
+        capture->captureCount++;
+
+        return true;
+    }
+
+    //Copy rows to the caller's array the right way up, OpenGL reads windows and render textures bottom row first
+    void copyRows(const DUbyte* source, DUbyte* destination, const sfFrameCaptureSlot& slot)
+    {
+        std::size_t row = static_cast<std::size_t>(slot.width) * 4;
+
+        for (unsigned int y = 0; y < slot.height; ++y)
+            std::memcpy(destination + row * y, source + row * (slot.height - 1 - y), row);
+    }
+}
+
+sfFrameCapture* sfFrameCapture_construct(DUint bufferCount)
+{
+    sfFrameCapture* capture = new sfFrameCapture;
+    capture->slots.resize(bufferCount ? bufferCount : 1);
+
+    return capture;
+}
+
+void sfFrameCapture_destroy(sfFrameCapture* capture)
+{
+    bool hasBuffers = false;
+    for (std::size_t i = 0; i < capture->slots.size(); ++i)
+        hasBuffers = hasBuffers || capture->slots[i].buffer;
+
+    if (hasBuffers)
+    {
+        std::unique_ptr<sf::Context> context;
+        if (!sf::Context::getActiveContext())
+            context.reset(new sf::Context);
+
+        for (std::size_t i = 0; i < capture->slots.size(); ++i)
+        {
+            releaseFence(capture->slots[i]);
+
+            if (capture->slots[i].buffer)
+                glext::deleteBuffers(1, &capture->slots[i].buffer);
+        }
+    }
+
+    delete capture;
+}
+
+DBool sfFrameCapture_captureRenderWindow(sfFrameCapture* capture, sfRenderWindow* renderWindow)
+{
+    if (!renderWindow->This.setActive(true))
+    {
+        sf::err() << "Failed to capture render window: it couldn't be activated" << std::endl;
+        return DFalse;
+    }
+
+    return ::capture(capture, renderWindow->This.getSize()) ? DTrue : DFalse;
+}
+
+DBool sfFrameCapture_captureRenderTexture(sfFrameCapture* capture, sfRenderTexture* renderTexture)
+{
+    if (!renderTexture->This.setActive(true))
+    {
+        sf::err() << "Failed to capture render texture: it couldn't be activated" << std::endl;
+        return DFalse;
+    }
+
+    return ::capture(capture, renderTexture->This.getSize()) ? DTrue : DFalse;
+}
+
+DBool sfFrameCapture_read(sfFrameCapture* capture, DUbyte* pixels, size_t size, DBool wait, DUint* width, DUint* height, DUlong* frame, DLong* latency)
+{
+    if (capture->pending.empty())
+        return DFalse;
+
+    sfFrameCaptureSlot& slot = capture->slots[capture->pending.front()];
+    std::size_t bytes = static_cast<std::size_t>(slot.width) * slot.height * 4;
+
+    *width = slot.width;
+    *height = slot.height;
+
+    if (size < bytes)
+    {
+        sf::err() << "Failed to read captured frame: the array holds " << size << " bytes but the frame needs " << bytes << std::endl;
+        return DFalse;
+    }
+
+    if (capture->useBuffers)
+    {
+        if (!isSignaled(glext::clientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0)))
+        {
+            if (wait != DTrue)
+                return DFalse;
+
+            capture->stallCount++;
+
+            GLenum status;
+            do
+            {
+                status = glext::clientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+            }
+            while (!isSignaled(status) && (status != GL_WAIT_FAILED));
+        }
+
+        releaseFence(slot);
+
+        if (bytes)
+        {
+            GLint previous = 0;
+            glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &previous);
+            glext::bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+
+            const DUbyte* source = static_cast<const DUbyte*>(glext::mapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<glext::GLsizeiptr>(bytes), GL_MAP_READ_BIT));
+
+            if (source)
+            {
+                copyRows(source, pixels, slot);
+                glext::unmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+
+            glext::bindBuffer(GL_PIXEL_PACK_BUFFER, static_cast<GLuint>(previous));
+
+            if (!source)
+            {
+                sf::err() << "Failed to read captured frame: the readback buffer couldn't be mapped" << std::endl;
+                capture->pending.pop_front();
+                return DFalse;
+            }
+        }
+    }
+    else if (bytes)
+    {
+        copyRows(&slot.pixels[0], pixels, slot);
+    }
+
+    *frame = slot.frame;
+    *latency = slot.clock.getElapsedTime().asMicroseconds();
+
+    capture->pending.pop_front();
+    capture->readCount++;
+    capture->totalLatency += *latency;
+
+    return DTrue;
+}
+
+void sfFrameCapture_getStatistics(const sfFrameCapture* capture, DUint* captureCount, DUint* readCount, DUint* dropCount, DUint* stallCount, DLong* totalLatency)
+{
+    *captureCount = capture->captureCount;
+    *readCount = capture->readCount;
+    *dropCount = capture->dropCount;
+    *stallCount = capture->stallCount;
+    *totalLatency = capture->totalLatency;
+}
@@ -0,0 +1,53 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_FRAMECAPTURE_H
+#define DSFML_FRAMECAPTURE_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <DSFMLC/Graphics/Types.h>
+#include <stddef.h>
+
+//Construct a new frame capture with a ring of readback buffers
+DSFML_GRAPHICS_API sfFrameCapture* sfFrameCapture_construct(DUint bufferCount);
+
+//Destroy an existing frame capture
+DSFML_GRAPHICS_API void sfFrameCapture_destroy(sfFrameCapture* capture);
+
+//Start reading back the contents of a render window
+DSFML_GRAPHICS_API DBool sfFrameCapture_captureRenderWindow(sfFrameCapture* capture, sfRenderWindow* renderWindow);
+
+//Start reading back the contents of a render texture
+DSFML_GRAPHICS_API DBool sfFrameCapture_captureRenderTexture(sfFrameCapture* capture, sfRenderTexture* renderTexture);
+
+//Copy the oldest captured frame to an array of RGBA pixels, optionally waiting for it to be read back
+DSFML_GRAPHICS_API DBool sfFrameCapture_read(sfFrameCapture* capture, DUbyte* pixels, size_t size, DBool wait, DUint* width, DUint* height, DUlong* frame, DLong* latency);
+
+//Get the number of frames captured and read, dropped because they were not read in time, and the stalls and total latency of the reads in microseconds
+DSFML_GRAPHICS_API void sfFrameCapture_getStatistics(const sfFrameCapture* capture, DUint* captureCount, DUint* readCount, DUint* dropCount, DUint* stallCount, DLong* totalLatency);
+
+#endif // DSFML_FRAMECAPTURE_H
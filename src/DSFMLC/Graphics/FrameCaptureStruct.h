@@ -0,0 +1,98 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_FRAMECAPTURESTRUCT_H
+#define DSFML_FRAMECAPTURESTRUCT_H
+
+#include <DSFMLC/Graphics/GLFunctions.hpp>
+#include <DSFMLC/Config.h>
+#include <SFML/System/Clock.hpp>
+#include <deque>
+#include <vector>
+
+//A readback buffer and the frame it holds
+struct sfFrameCaptureSlot
+{
+    sfFrameCaptureSlot() :
+    buffer(0),
+    capacity(0),
+    width(0),
+    height(0),
+    fence(NULL),
+    frame(0)
+    {
+    }
+
+    GLuint buffer;
+    std::size_t capacity;
+    unsigned int width;
+    unsigned int height;
+
+    glext::GLsync fence;
+    DUlong frame;
+    sf::Clock clock;
+
+    //Used when buffers are unavailable
+    std::vector<DUbyte> pixels;
+};
+
+//Internal structure of sfFrameCapture
+struct sfFrameCapture
+{
+    sfFrameCapture() :
+    initialized(false),
+    useBuffers(false),
+    next(0),
+    frameCount(0),
+    captureCount(0),
+    readCount(0),
+    dropCount(0),
+    stallCount(0),
+    totalLatency(0)
+    {
+    }
+
+    std::vector<sfFrameCaptureSlot> slots;
+
+    //Buffers are created on first use, when a context is active
+    bool initialized;
+    bool useBuffers;
+    unsigned int next;
+
+    //Slots holding frames that were not read yet, oldest first
+    std::deque<unsigned int> pending;
+
+    DUlong frameCount;
+
+    unsigned int captureCount;
+    unsigned int readCount;
+    unsigned int dropCount;
+    unsigned int stallCount;
+    long long totalLatency;
+};
+
+#endif // DSFML_FRAMECAPTURESTRUCT_H
@@ -0,0 +1,323 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/FrameRecorder.h>
+#include <DSFMLC/Graphics/FrameRecorderStruct.h>
+#include <DSFMLC/Graphics/FrameCapture.h>
+#include <DSFMLC/Graphics/PixelKernels.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    void writeFrame(sfFrameRecorder* recorder, const sfRecordedFrame& frame, std::vector<sf::Uint8>& planes)
+    {
+        if (!frame.width || !frame.height)
+        {
+            recorder->dropCount++;
+            return;
+        }
+
+        if (recorder->format == sfFrameRecorderPng)
+        {
+            std::ostringstream filename;
+            filename << recorder->path << std::setw(6) << std::setfill('0') << frame.index << ".png";
+
+            sf::Image image;
+            image.create(frame.width, frame.height, &frame.pixels[0]);
+
+            if (image.saveToFile(filename.str()))
+                recorder->writeCount++;
+            else
+                recorder->dropCount++;
+
+            return;
+        }
+
+        //Streams have a single size, which the first frame decides
+        if (!recorder->streamWidth)
+        {
+            recorder->streamWidth = frame.width;
+            recorder->streamHeight = frame.height;
+
+            if (recorder->format == sfFrameRecorderY4m)
+            {
+                recorder->stream << "YUV4MPEG2 W" << frame.width << " H" << frame.height << " F" << recorder->frameRate
+                                 << ":1 Ip A1:1 C420jpeg\n";
+            }
+        }
+
+        if ((frame.width != recorder->streamWidth) || (frame.height != recorder->streamHeight))
+        {
+            recorder->dropCount++;
+            return;
+        }
+
+        std::size_t lumaSize = static_cast<std::size_t>(frame.width) * frame.height;
+        std::size_t chromaSize = static_cast<std::size_t>((frame.width + 1) / 2) * ((frame.height + 1) / 2);
+        planes.resize(lumaSize + chromaSize * 2);
+
+        pixelkernels::rgbaToYuv420(&frame.pixels[0], frame.width, frame.height,
+                                   &planes[0], &planes[lumaSize], &planes[lumaSize + chromaSize]);
+
+        if (recorder->format == sfFrameRecorderY4m)
+            recorder->stream << "FRAME\n";
+
+        recorder->stream.write(reinterpret_cast<const char*>(&planes[0]), static_cast<std::streamsize>(planes.size()));
+
+        if (recorder->stream)
+            recorder->writeCount++;
+        else
+            recorder->dropCount++;
+    }
+
+    void runWriter(sfFrameRecorder* recorder)
+    {
+        std::vector<sf::Uint8> planes;
+
+        while (true)
+        {
+            sfRecordedFrame* frame;
+
+            if (recorder->queued.pop(frame))
+            {
+                recorder->queueDepth--;
+                writeFrame(recorder, *frame, planes);
+                recorder->available.push(frame);
+            }
+            else if (recorder->stopping)
+            {
+                return;
+            }
+            else
+            {
+                //A push may land between the check and the wait, so the sleep is kept short
+                std::unique_lock<std::mutex> lock(recorder->sleepMutex);
+                recorder->wakeUp.wait_for(lock, std::chrono::milliseconds(2));
+            }
+        }
+    }
+
+    bool readFrame(sfFrameRecorder* recorder, std::vector<DUbyte>& pixels, bool wait, DUint& width, DUint& height, DUlong& index)
+    {
+        DLong latency;
+        width = 0;
+        height = 0;
+
+        if (sfFrameCapture_read(recorder->capture, pixels.empty() ? NULL : &pixels[0], pixels.size(), wait, &width, &height, &index, &latency))
+            return true;
+
+        //The frame may only have failed to fit
+        std::size_t size = static_cast<std::size_t>(width) * height * 4;
+        if (size <= pixels.size())
+            return false;
+
+        pixels.resize(size);
+
+        return sfFrameCapture_read(recorder->capture, &pixels[0], pixels.size(), wait, &width, &height, &index, &latency) == DTrue;
+    }
+
+    //Move the frames that were read back to the writers
+    void queueFrames(sfFrameRecorder* recorder, bool wait)
+    {
+        while (true)
+        {
+            sfRecordedFrame* frame = NULL;
+            recorder->available.pop(frame);
+
+            DUint width, height;
+            DUlong index;
+
+            if (!readFrame(recorder, frame ? frame->pixels : recorder->scratch, wait, width, height, index))
+            {
+                if (frame)
+                    recorder->available.push(frame);
+
+                return;
+            }
+
+            if (!frame)
+            {
+                recorder->dropCount++;
+                continue;
+            }
+
+            frame->width = width;
+            frame->height = height;
+            frame->index = index;
+
+            recorder->queued.push(frame);
+
+            unsigned int depth = ++recorder->queueDepth;
+            unsigned int maxDepth = recorder->maxQueueDepth;
+            while ((depth > maxDepth) && !recorder->maxQueueDepth.compare_exchange_weak(maxDepth, depth))
+            {
+            }
+
+            recorder->wakeUp.notify_one();
+        }
+    }
+
+    //Let the writers finish the frames that are already queued, then close the output
+    void stopWriters(sfFrameRecorder* recorder)
+    {
+        recorder->stopping = true;
+        recorder->wakeUp.notify_all();
+
+        for (std::size_t i = 0; i < recorder->writers.size(); ++i)
+            recorder->writers[i].join();
+
+        recorder->writers.clear();
+
+        if (recorder->stream.is_open())
+            recorder->stream.close();
+
+        recorder->stream.clear();
+        recorder->recording = false;
+    }
+}
+
+sfFrameRecorder* sfFrameRecorder_construct(DUint queueCapacity, DUint threadCount)
+{
+    std::size_t capacity = queueCapacity ? queueCapacity : 1;
+    sfFrameRecorder* recorder = new sfFrameRecorder(capacity);
+
+    recorder->capture = sfFrameCapture_construct(3);
+    recorder->threadCount = threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+
+    for (std::size_t i = 0; i < capacity; ++i)
+    {
+        recorder->frames.push_back(std::unique_ptr<sfRecordedFrame>(new sfRecordedFrame));
+        recorder->available.push(recorder->frames.back().get());
+    }
+
+    return recorder;
+}
+
+void sfFrameRecorder_destroy(sfFrameRecorder* recorder)
+{
+    //The recorder may not be destroyed with a context the frames can be read back in,
+    //so frames still on the GPU are dropped and only the queued ones are written
+    if (recorder->recording)
+        stopWriters(recorder);
+
+    sfFrameCapture_destroy(recorder->capture);
+
+    delete recorder;
+}
+
+DBool sfFrameRecorder_start(sfFrameRecorder* recorder, const char* path, size_t pathLength, DInt format, DUint frameRate)
+{
+    if (recorder->recording)
+    {
+        sf::err() << "Failed to start frame recorder: it is already recording" << std::endl;
+        return DFalse;
+    }
+
+    recorder->path.assign(path, pathLength);
+    recorder->format = format;
+    recorder->frameRate = frameRate ? frameRate : 60;
+    recorder->streamWidth = 0;
+    recorder->streamHeight = 0;
+
+    if (format != sfFrameRecorderPng)
+    {
+        recorder->stream.open(recorder->path.c_str(), std::ios::binary | std::ios::trunc);
+
+        if (!recorder->stream)
+        {
+            sf::err() << "Failed to start frame recorder: \"" << recorder->path << "\" couldn't be opened" << std::endl;
+            recorder->stream.clear();
+            return DFalse;
+        }
+    }
+
+    recorder->stopping = false;
+    unsigned int writerCount = (format == sfFrameRecorderPng) ? recorder->threadCount : 1;
+
+    for (unsigned int i = 0; i < writerCount; ++i)
+        recorder->writers.push_back(std::thread(runWriter, recorder));
+
+    recorder->recording = true;
+
+    return DTrue;
+}
+
+void sfFrameRecorder_stop(sfFrameRecorder* recorder)
+{
+    if (!recorder->recording)
+        return;
+
+    //Frames still on the GPU are waited for, then the writers finish what is queued
+    queueFrames(recorder, true);
+    stopWriters(recorder);
+}
+
+DBool sfFrameRecorder_isRecording(const sfFrameRecorder* recorder)
+{
+    return recorder->recording ? DTrue : DFalse;
+}
+
+DBool sfFrameRecorder_captureRenderWindow(sfFrameRecorder* recorder, sfRenderWindow* renderWindow)
+{
+    if (!recorder->recording || !sfFrameCapture_captureRenderWindow(recorder->capture, renderWindow))
+        return DFalse;
+
+    recorder->captureCount++;
+    queueFrames(recorder, false);
+
+    return DTrue;
+}
+
+DBool sfFrameRecorder_captureRenderTexture(sfFrameRecorder* recorder, sfRenderTexture* renderTexture)
+{
+    if (!recorder->recording || !sfFrameCapture_captureRenderTexture(recorder->capture, renderTexture))
+        return DFalse;
+
+    recorder->captureCount++;
+    queueFrames(recorder, false);
+
+    return DTrue;
+}
+
+void sfFrameRecorder_getStatistics(const sfFrameRecorder* recorder, DUint* captureCount, DUint* writeCount, DUint* dropCount, DUint* queueDepth, DUint* maxQueueDepth)
+{
+    //Frames the capture overwrote before they could be read were dropped too
+    DUint captured, read, overwritten, stalls;
+    DLong latency;
+    sfFrameCapture_getStatistics(recorder->capture, &captured, &read, &overwritten, &stalls, &latency);
+
+    *captureCount = recorder->captureCount;
+    *writeCount = recorder->writeCount;
+    *dropCount = recorder->dropCount + overwritten;
+    *queueDepth = recorder->queueDepth;
+    *maxQueueDepth = recorder->maxQueueDepth;
+}
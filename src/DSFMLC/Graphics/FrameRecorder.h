@@ -0,0 +1,67 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_FRAMERECORDER_H
+#define DSFML_FRAMERECORDER_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <DSFMLC/Graphics/Types.h>
+#include <stddef.h>
+
+//Formats a frame recorder can write
+typedef enum
+{
+    sfFrameRecorderY4m,
+    sfFrameRecorderRawYuv,
+    sfFrameRecorderPng
+} sfFrameRecorderFormat;
+
+//Construct a new frame recorder, with room for some frames waiting to be written
+DSFML_GRAPHICS_API sfFrameRecorder* sfFrameRecorder_construct(DUint queueCapacity, DUint threadCount);
+
+//Destroy an existing frame recorder, dropping the frames that weren't read back
+DSFML_GRAPHICS_API void sfFrameRecorder_destroy(sfFrameRecorder* recorder);
+
+//Start writing frames to a file, or to a sequence of files for images
+DSFML_GRAPHICS_API DBool sfFrameRecorder_start(sfFrameRecorder* recorder, const char* path, size_t pathLength, DInt format, DUint frameRate);
+
+//Write the frames still in flight and close the output
+DSFML_GRAPHICS_API void sfFrameRecorder_stop(sfFrameRecorder* recorder);
+
+//Tell whether the recorder was started and not stopped since
+DSFML_GRAPHICS_API DBool sfFrameRecorder_isRecording(const sfFrameRecorder* recorder);
+
+//Capture the contents of a render window and queue the frames that were read back
+DSFML_GRAPHICS_API DBool sfFrameRecorder_captureRenderWindow(sfFrameRecorder* recorder, sfRenderWindow* renderWindow);
+
+//Capture the contents of a render texture and queue the frames that were read back
+DSFML_GRAPHICS_API DBool sfFrameRecorder_captureRenderTexture(sfFrameRecorder* recorder, sfRenderTexture* renderTexture);
+
+//Get the number of frames captured, written and dropped, and the current and highest number of frames waiting to be written
+DSFML_GRAPHICS_API void sfFrameRecorder_getStatistics(const sfFrameRecorder* recorder, DUint* captureCount, DUint* writeCount, DUint* dropCount, DUint* queueDepth, DUint* maxQueueDepth);
+
+#endif // DSFML_FRAMERECORDER_H
@@ -0,0 +1,108 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_FRAMERECORDERSTRUCT_H
+#define DSFML_FRAMERECORDERSTRUCT_H
+
+#include <DSFMLC/Graphics/LockFreeQueue.hpp>
+#include <DSFMLC/Graphics/Types.h>
+#include <DSFMLC/Config.h>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//A frame read back from the GPU, going from the render thread to the writers
+struct sfRecordedFrame
+{
+    std::vector<DUbyte> pixels;
+    unsigned int width;
+    unsigned int height;
+    DUlong index;
+};
+
+//Internal structure of sfFrameRecorder
+struct sfFrameRecorder
+{
+    sfFrameRecorder(std::size_t queueCapacity) :
+    capture(NULL),
+    threadCount(0),
+    recording(false),
+    format(0),
+    frameRate(0),
+    queued(queueCapacity),
+    available(queueCapacity),
+    stopping(false),
+    streamWidth(0),
+    streamHeight(0),
+    captureCount(0),
+    writeCount(0),
+    dropCount(0),
+    queueDepth(0),
+    maxQueueDepth(0)
+    {
+    }
+
+    sfFrameCapture* capture;
+    unsigned int threadCount;
+    bool recording;
+
+    std::string path;
+    int format;
+    unsigned int frameRate;
+
+    //Frames waiting to be written, and frames ready to be filled again
+    LockFreeQueue<sfRecordedFrame*> queued;
+    LockFreeQueue<sfRecordedFrame*> available;
+    std::vector<std::unique_ptr<sfRecordedFrame>> frames;
+
+    //Frames read back while every frame is waiting to be written end up here and are dropped
+    std::vector<DUbyte> scratch;
+
+    //Only used to put idle writers to sleep, the queues themselves don't lock
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<bool> stopping;
+    std::vector<std::thread> writers;
+
+    //Video streams are written by a single writer, so that frames stay in order
+    std::ofstream stream;
+    unsigned int streamWidth;
+    unsigned int streamHeight;
+
+    std::atomic<unsigned int> captureCount;
+    std::atomic<unsigned int> writeCount;
+    std::atomic<unsigned int> dropCount;
+    std::atomic<unsigned int> queueDepth;
+    std::atomic<unsigned int> maxQueueDepth;
+};
+
+#endif // DSFML_FRAMERECORDERSTRUCT_H
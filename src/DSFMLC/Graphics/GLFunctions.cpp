@@ -0,0 +1,168 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/GLFunctions.hpp>
+#include <SFML/Window/Context.hpp>
+#include <mutex>
+
+namespace
+{
+    //The shader loading thread may ask for the functions at the same time as the main thread
+    std::once_flag loaded;
+
+    //Get a function by its core name, falling back to its extension names
+    template <typename T>
+    void loadFunction(T& function, const char* name, const char* arbName, const char* extName = NULL)
+    {
+        function = reinterpret_cast<T>(sf::Context::getFunction(name));
+
+        if (!function && arbName)
+            function = reinterpret_cast<T>(sf::Context::getFunction(arbName));
+
+        if (!function && extName)
+            function = reinterpret_cast<T>(sf::Context::getFunction(extName));
+    }
+}
+
+namespace glext
+{
+    void (APIENTRY *genBuffers)(GLsizei n, GLuint* buffers) = NULL;
+    void (APIENTRY *deleteBuffers)(GLsizei n, const GLuint* buffers) = NULL;
+    void (APIENTRY *bindBuffer)(GLenum target, GLuint buffer) = NULL;
+    void (APIENTRY *bufferData)(GLenum target, GLsizeiptr size, const void* data, GLenum usage) = NULL;
+    void (APIENTRY *bufferSubData)(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) = NULL;
+    void (APIENTRY *blendFuncSeparate)(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) = NULL;
+    void (APIENTRY *blendEquation)(GLenum mode) = NULL;
+    void (APIENTRY *blendEquationSeparate)(GLenum modeRGB, GLenum modeAlpha) = NULL;
+    void (APIENTRY *useProgram)(GLuint program) = NULL;
+    GLint (APIENTRY *getUniformLocation)(GLuint program, const char* name) = NULL;
+    void (APIENTRY *uniform1fv)(GLint location, GLsizei count, const GLfloat* value) = NULL;
+    void (APIENTRY *uniform2fv)(GLint location, GLsizei count, const GLfloat* value) = NULL;
+    void (APIENTRY *uniform3fv)(GLint location, GLsizei count, const GLfloat* value) = NULL;
+    void (APIENTRY *uniform4fv)(GLint location, GLsizei count, const GLfloat* value) = NULL;
+    void (APIENTRY *uniform1iv)(GLint location, GLsizei count, const GLint* value) = NULL;
+    void (APIENTRY *uniform2iv)(GLint location, GLsizei count, const GLint* value) = NULL;
+    void (APIENTRY *uniform3iv)(GLint location, GLsizei count, const GLint* value) = NULL;
+    void (APIENTRY *uniform4iv)(GLint location, GLsizei count, const GLint* value) = NULL;
+    void (APIENTRY *uniformMatrix3fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) = NULL;
+    void (APIENTRY *uniformMatrix4fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) = NULL;
+    GLuint (APIENTRY *getUniformBlockIndex)(GLuint program, const char* name) = NULL;
+    void (APIENTRY *uniformBlockBinding)(GLuint program, GLuint blockIndex, GLuint blockBinding) = NULL;
+    void (APIENTRY *bindBufferBase)(GLenum target, GLuint index, GLuint buffer) = NULL;
+    void (APIENTRY *getProgramiv)(GLuint program, GLenum pname, GLint* params) = NULL;
+    void (APIENTRY *getProgramBinary)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary) = NULL;
+    void (APIENTRY *programBinary)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length) = NULL;
+    void* (APIENTRY *mapBufferRange)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) = NULL;
+    GLboolean (APIENTRY *unmapBuffer)(GLenum target) = NULL;
+    void (APIENTRY *bufferStorage)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) = NULL;
+    GLsync (APIENTRY *fenceSync)(GLenum condition, GLbitfield flags) = NULL;
+    GLenum (APIENTRY *clientWaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout) = NULL;
+    void (APIENTRY *deleteSync)(GLsync sync) = NULL;
+
+    void load()
+    {
+        std::call_once(loaded, []()
+        {
+            loadFunction(genBuffers, "glGenBuffers", "glGenBuffersARB");
+            loadFunction(deleteBuffers, "glDeleteBuffers", "glDeleteBuffersARB");
+            loadFunction(bindBuffer, "glBindBuffer", "glBindBufferARB");
+            loadFunction(bufferData, "glBufferData", "glBufferDataARB");
+            loadFunction(bufferSubData, "glBufferSubData", "glBufferSubDataARB");
+            loadFunction(blendFuncSeparate, "glBlendFuncSeparate", NULL, "glBlendFuncSeparateEXT");
+            loadFunction(blendEquation, "glBlendEquation", NULL, "glBlendEquationEXT");
+            loadFunction(blendEquationSeparate, "glBlendEquationSeparate", NULL, "glBlendEquationSeparateEXT");
+            loadFunction(useProgram, "glUseProgram", "glUseProgramObjectARB");
+            loadFunction(getUniformLocation, "glGetUniformLocation", "glGetUniformLocationARB");
+            loadFunction(uniform1fv, "glUniform1fv", "glUniform1fvARB");
+            loadFunction(uniform2fv, "glUniform2fv", "glUniform2fvARB");
+            loadFunction(uniform3fv, "glUniform3fv", "glUniform3fvARB");
+            loadFunction(uniform4fv, "glUniform4fv", "glUniform4fvARB");
+            loadFunction(uniform1iv, "glUniform1iv", "glUniform1ivARB");
+            loadFunction(uniform2iv, "glUniform2iv", "glUniform2ivARB");
+            loadFunction(uniform3iv, "glUniform3iv", "glUniform3ivARB");
+            loadFunction(uniform4iv, "glUniform4iv", "glUniform4ivARB");
+            loadFunction(uniformMatrix3fv, "glUniformMatrix3fv", "glUniformMatrix3fvARB");
+            loadFunction(uniformMatrix4fv, "glUniformMatrix4fv", "glUniformMatrix4fvARB");
+            loadFunction(getUniformBlockIndex, "glGetUniformBlockIndex", NULL);
+            loadFunction(uniformBlockBinding, "glUniformBlockBinding", NULL);
+            loadFunction(bindBufferBase, "glBindBufferBase", NULL, "glBindBufferBaseEXT");
+            loadFunction(getProgramiv, "glGetProgramiv", "glGetObjectParameterivARB");
+            loadFunction(getProgramBinary, "glGetProgramBinary", NULL);
+            loadFunction(programBinary, "glProgramBinary", NULL);
+            loadFunction(mapBufferRange, "glMapBufferRange", NULL);
+            loadFunction(unmapBuffer, "glUnmapBuffer", "glUnmapBufferARB");
+            loadFunction(bufferStorage, "glBufferStorage", NULL);
+            loadFunction(fenceSync, "glFenceSync", NULL);
+            loadFunction(clientWaitSync, "glClientWaitSync", NULL);
+            loadFunction(deleteSync, "glDeleteSync", NULL);
+        });
+    }
+
+    bool hasBufferObjects()
+    {
+        load();
+
+        return genBuffers && deleteBuffers && bindBuffer && bufferData && bufferSubData;
+    }
+
+    bool hasUniforms()
+    {
+        load();
+
+        return useProgram && getUniformLocation && uniform1fv && uniform2fv && uniform3fv && uniform4fv &&
+               uniform1iv && uniform2iv && uniform3iv && uniform4iv && uniformMatrix3fv && uniformMatrix4fv;
+    }
+
+    bool hasUniformBuffers()
+    {
+        return hasUniforms() && hasBufferObjects() && getUniformBlockIndex && uniformBlockBinding && bindBufferBase;
+    }
+
+    bool hasProgramBinaries()
+    {
+        load();
+
+        if (!getProgramiv || !getProgramBinary || !programBinary)
+            return false;
+
+        //Drivers may expose the functions without supporting any binary format
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+        return formats > 0;
+    }
+
+    bool hasMappedBuffers()
+    {
+        return hasBufferObjects() && mapBufferRange && unmapBuffer && fenceSync && clientWaitSync && deleteSync;
+    }
+
+    bool hasPersistentBuffers()
+    {
+        return hasMappedBuffers() && bufferStorage;
+    }
+}
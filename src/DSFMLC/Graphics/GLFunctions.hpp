@@ -0,0 +1,199 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_GLFUNCTIONS_HPP
+#define DSFML_GLFUNCTIONS_HPP
+
+#include <SFML/OpenGL.hpp>
+#include <cstddef>
+
+#ifndef APIENTRY
+    #define APIENTRY
+#endif
+
+// Constants from OpenGL versions newer than the headers some platforms ship with
+#ifndef GL_ARRAY_BUFFER
+    #define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STREAM_DRAW
+    #define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_STATIC_DRAW
+    #define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_DYNAMIC_DRAW
+    #define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_FUNC_ADD
+    #define GL_FUNC_ADD 0x8006
+#endif
+#ifndef GL_FUNC_SUBTRACT
+    #define GL_FUNC_SUBTRACT 0x800A
+#endif
+#ifndef GL_FUNC_REVERSE_SUBTRACT
+    #define GL_FUNC_REVERSE_SUBTRACT 0x800B
+#endif
+#ifndef GL_CURRENT_PROGRAM
+    #define GL_CURRENT_PROGRAM 0x8B8D
+#endif
+#ifndef GL_UNIFORM_BUFFER
+    #define GL_UNIFORM_BUFFER 0x8A11
+#endif
+#ifndef GL_MAX_UNIFORM_BUFFER_BINDINGS
+    #define GL_MAX_UNIFORM_BUFFER_BINDINGS 0x8A2F
+#endif
+#ifndef GL_INVALID_INDEX
+    #define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif
+#ifndef GL_LINK_STATUS
+    #define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+    #define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+    #define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+#ifndef GL_PIXEL_PACK_BUFFER
+    #define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_PIXEL_PACK_BUFFER_BINDING
+    #define GL_PIXEL_PACK_BUFFER_BINDING 0x88ED
+#endif
+#ifndef GL_PIXEL_UNPACK_BUFFER
+    #define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+#ifndef GL_PIXEL_UNPACK_BUFFER_BINDING
+    #define GL_PIXEL_UNPACK_BUFFER_BINDING 0x88EF
+#endif
+#ifndef GL_STREAM_READ
+    #define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_MAP_READ_BIT
+    #define GL_MAP_READ_BIT 0x0001
+#endif
+#ifndef GL_MAP_WRITE_BIT
+    #define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_INVALIDATE_RANGE_BIT
+    #define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#endif
+#ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+    #define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#endif
+#ifndef GL_MAP_UNSYNCHRONIZED_BIT
+    #define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+    #define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+    #define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_ALREADY_SIGNALED
+    #define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_CONDITION_SATISFIED
+    #define GL_CONDITION_SATISFIED 0x911C
+#endif
+#ifndef GL_WAIT_FAILED
+    #define GL_WAIT_FAILED 0x911D
+#endif
+#ifndef GL_TEXTURE_MAX_LEVEL
+    #define GL_TEXTURE_MAX_LEVEL 0x813D
+#endif
+
+//OpenGL functions that are not part of OpenGL 1.1, loaded at runtime
+namespace glext
+{
+    typedef std::ptrdiff_t GLsizeiptr;
+    typedef std::ptrdiff_t GLintptr;
+    typedef unsigned long long GLuint64;
+    typedef struct SyncObject* GLsync;
+
+    extern void (APIENTRY *genBuffers)(GLsizei n, GLuint* buffers);
+    extern void (APIENTRY *deleteBuffers)(GLsizei n, const GLuint* buffers);
+    extern void (APIENTRY *bindBuffer)(GLenum target, GLuint buffer);
+    extern void (APIENTRY *bufferData)(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+    extern void (APIENTRY *bufferSubData)(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+    extern void (APIENTRY *blendFuncSeparate)(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+    extern void (APIENTRY *blendEquation)(GLenum mode);
+    extern void (APIENTRY *blendEquationSeparate)(GLenum modeRGB, GLenum modeAlpha);
+    extern void (APIENTRY *useProgram)(GLuint program);
+    extern GLint (APIENTRY *getUniformLocation)(GLuint program, const char* name);
+    extern void (APIENTRY *uniform1fv)(GLint location, GLsizei count, const GLfloat* value);
+    extern void (APIENTRY *uniform2fv)(GLint location, GLsizei count, const GLfloat* value);
+    extern void (APIENTRY *uniform3fv)(GLint location, GLsizei count, const GLfloat* value);
+    extern void (APIENTRY *uniform4fv)(GLint location, GLsizei count, const GLfloat* value);
+    extern void (APIENTRY *uniform1iv)(GLint location, GLsizei count, const GLint* value);
+    extern void (APIENTRY *uniform2iv)(GLint location, GLsizei count, const GLint* value);
+    extern void (APIENTRY *uniform3iv)(GLint location, GLsizei count, const GLint* value);
+    extern void (APIENTRY *uniform4iv)(GLint location, GLsizei count, const GLint* value);
+    extern void (APIENTRY *uniformMatrix3fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+    extern void (APIENTRY *uniformMatrix4fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+    extern GLuint (APIENTRY *getUniformBlockIndex)(GLuint program, const char* name);
+    extern void (APIENTRY *uniformBlockBinding)(GLuint program, GLuint blockIndex, GLuint blockBinding);
+    extern void (APIENTRY *bindBufferBase)(GLenum target, GLuint index, GLuint buffer);
+    extern void (APIENTRY *getProgramiv)(GLuint program, GLenum pname, GLint* params);
+    extern void (APIENTRY *getProgramBinary)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+    extern void (APIENTRY *programBinary)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+    extern void* (APIENTRY *mapBufferRange)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+    extern GLboolean (APIENTRY *unmapBuffer)(GLenum target);
+    extern void (APIENTRY *bufferStorage)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+    extern GLsync (APIENTRY *fenceSync)(GLenum condition, GLbitfield flags);
+    extern GLenum (APIENTRY *clientWaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+    extern void (APIENTRY *deleteSync)(GLsync sync);
+
+    //Load the functions, must be called with an active OpenGL context
+    void load();
+
+    //Check if buffer objects are supported by the current context
+    bool hasBufferObjects();
+
+    //Check if uniforms can be set directly in the current context
+    bool hasUniforms();
+
+    //Check if uniform buffer objects are supported by the current context
+    bool hasUniformBuffers();
+
+    //Check if linked programs can be retrieved and restored in the current context
+    bool hasProgramBinaries();
+
+    //Check if buffers can be mapped and fenced, which streaming pixels through buffers needs
+    bool hasMappedBuffers();
+
+    //Check if buffers can stay mapped while the GPU uses them
+    bool hasPersistentBuffers();
+}
+
+#endif // DSFML_GLFUNCTIONS_HPP
@@ -0,0 +1,309 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/GlyphPage.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    //Space left around each glyph, so that smooth textures don't bleed
+    const unsigned int padding = 2;
+
+    template <typename T>
+    void write(std::ostream& stream, const T& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool read(std::istream& stream, T& value)
+    {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+}
+
+sf::Uint64 glyphKey(sf::Uint32 codePoint, bool bold, float outlineThickness)
+{
+    sf::Uint32 outlineBits;
+    std::memcpy(&outlineBits, &outlineThickness, sizeof(outlineBits));
+
+    return (static_cast<sf::Uint64>(outlineBits) << 32) | (static_cast<sf::Uint64>(bold ? 1 : 0) << 31) | codePoint;
+}
+
+sfGlyphPage::sfGlyphPage() :
+rowTop(0),
+rowLeft(0),
+rowHeight(0)
+{
+}
+
+const sf::Glyph& sfGlyphPage::getGlyph(const sf::Font& font, unsigned int characterSize, sf::Uint32 codePoint, bool bold, float outlineThickness)
+{
+    sf::Uint64 key = glyphKey(codePoint, bold, outlineThickness);
+
+    std::map<sf::Uint64, sf::Glyph>::const_iterator it = glyphs.find(key);
+    if (it != glyphs.end())
+        return it->second;
+
+    //Not in the saved atlas, so have the font rasterize it and copy it over
+    loadGlyphs(font, characterSize, &codePoint, 1, bold, outlineThickness);
+
+    return glyphs[key];
+}
+
+void sfGlyphPage::loadGlyphs(const sf::Font& font, unsigned int characterSize, const sf::Uint32* codePoints, std::size_t count, bool bold, float outlineThickness)
+{
+    std::map<sf::Uint64, sf::Glyph> missing;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sf::Uint64 key = glyphKey(codePoints[i], bold, outlineThickness);
+
+        if ((glyphs.find(key) == glyphs.end()) && (missing.find(key) == missing.end()))
+            missing[key] = font.getGlyph(codePoints[i], characterSize, bold, outlineThickness);
+    }
+
+    if (!missing.empty())
+        copyFromFont(font, characterSize, missing);
+}
+
+void sfGlyphPage::copyFromFont(const sf::Font& font, unsigned int characterSize, const std::map<sf::Uint64, sf::Glyph>& fontGlyphs)
+{
+    //Reading back the font's page is slow, so only do it once for all the glyphs
+    sf::Image fontImage;
+    bool fontImageLoaded = false;
+
+    //Glyphs are uploaded on their own unless the page grew, and then the whole page is
+    std::vector<sf::IntRect> copied;
+
+    for (std::map<sf::Uint64, sf::Glyph>::const_iterator it = fontGlyphs.begin(); it != fontGlyphs.end(); ++it)
+    {
+        sf::Glyph glyph = it->second;
+
+        if ((glyph.textureRect.width > 0) && (glyph.textureRect.height > 0))
+        {
+            if (!fontImageLoaded)
+            {
+                fontImage = font.getTexture(characterSize).copyToImage();
+                fontImageLoaded = true;
+            }
+
+            sf::IntRect rect = findGlyphRect(glyph.textureRect.width, glyph.textureRect.height);
+            image.copy(fontImage, rect.left, rect.top, glyph.textureRect);
+            glyph.textureRect = rect;
+            copied.push_back(rect);
+        }
+
+        glyphs[it->first] = glyph;
+    }
+
+    if (!fontImageLoaded)
+        return;
+
+    if (texture.getSize() != image.getSize())
+    {
+        if (texture.loadFromImage(image))
+            texture.setSmooth(true);
+
+        return;
+    }
+
+    std::vector<sf::Uint8> pixels;
+    const sf::Uint8* imagePixels = image.getPixelsPtr();
+    std::size_t imageWidth = image.getSize().x;
+
+    for (std::size_t i = 0; i < copied.size(); ++i)
+    {
+        const sf::IntRect& rect = copied[i];
+        std::size_t rowSize = static_cast<std::size_t>(rect.width) * 4;
+        pixels.resize(rowSize * rect.height);
+
+        for (int y = 0; y < rect.height; ++y)
+            std::memcpy(&pixels[y * rowSize], imagePixels + ((rect.top + y) * imageWidth + rect.left) * 4, rowSize);
+
+        texture.update(&pixels[0], rect.width, rect.height, rect.left, rect.top);
+    }
+}
+
+bool sfGlyphPage::save(std::ostream& stream) const
+{
+    sf::Vector2u size = image.getSize();
+
+    write(stream, static_cast<sf::Uint32>(size.x));
+    write(stream, static_cast<sf::Uint32>(size.y));
+    write(stream, static_cast<sf::Uint32>(rowTop));
+    write(stream, static_cast<sf::Uint32>(rowLeft));
+    write(stream, static_cast<sf::Uint32>(rowHeight));
+    write(stream, static_cast<sf::Uint32>(glyphs.size()));
+
+    for (std::map<sf::Uint64, sf::Glyph>::const_iterator it = glyphs.begin(); it != glyphs.end(); ++it)
+    {
+        const sf::Glyph& glyph = it->second;
+
+        write(stream, it->first);
+        write(stream, glyph.advance);
+        write(stream, glyph.bounds.left);
+        write(stream, glyph.bounds.top);
+        write(stream, glyph.bounds.width);
+        write(stream, glyph.bounds.height);
+        write(stream, static_cast<sf::Int32>(glyph.textureRect.left));
+        write(stream, static_cast<sf::Int32>(glyph.textureRect.top));
+        write(stream, static_cast<sf::Int32>(glyph.textureRect.width));
+        write(stream, static_cast<sf::Int32>(glyph.textureRect.height));
+    }
+
+    //Glyph pages are white, so only the alpha channel needs to be saved
+    std::vector<sf::Uint8> alpha(size.x * size.y);
+    const sf::Uint8* pixels = image.getPixelsPtr();
+    for (std::size_t i = 0; i < alpha.size(); ++i)
+        alpha[i] = pixels[i * 4 + 3];
+
+    if (!alpha.empty())
+        stream.write(reinterpret_cast<const char*>(&alpha[0]), alpha.size());
+
+    return static_cast<bool>(stream);
+}
+
+bool sfGlyphPage::load(std::istream& stream)
+{
+    sf::Uint32 width, height, savedRowTop, savedRowLeft, savedRowHeight, glyphCount;
+
+    if (!read(stream, width) || !read(stream, height) || !read(stream, savedRowTop) ||
+        !read(stream, savedRowLeft) || !read(stream, savedRowHeight) || !read(stream, glyphCount))
+        return false;
+
+    //The sizes come from the file, so don't allocate or upload more than a texture could hold
+    unsigned int maximumSize = sf::Texture::getMaximumSize();
+    if ((width > maximumSize) || (height > maximumSize))
+    {
+        sf::err() << "Failed to load glyph page: its size (" << width << "x" << height << ") is larger than the maximum texture size (" << maximumSize << ")" << std::endl;
+        return false;
+    }
+
+    glyphs.clear();
+
+    for (sf::Uint32 i = 0; i < glyphCount; ++i)
+    {
+        sf::Uint64 key;
+        sf::Glyph glyph;
+        sf::Int32 rect[4];
+
+        if (!read(stream, key) || !read(stream, glyph.advance) ||
+            !read(stream, glyph.bounds.left) || !read(stream, glyph.bounds.top) ||
+            !read(stream, glyph.bounds.width) || !read(stream, glyph.bounds.height) ||
+            !read(stream, rect))
+            return false;
+
+        //Text would sample outside the page when drawing a glyph whose rectangle doesn't fit in it
+        if ((rect[0] < 0) || (rect[1] < 0) || (rect[2] < 0) || (rect[3] < 0) ||
+            (static_cast<std::size_t>(rect[0]) + static_cast<std::size_t>(rect[2]) > width) ||
+            (static_cast<std::size_t>(rect[1]) + static_cast<std::size_t>(rect[3]) > height))
+            return false;
+
+        glyph.textureRect = sf::IntRect(rect[0], rect[1], rect[2], rect[3]);
+        glyphs[key] = glyph;
+    }
+
+    std::vector<sf::Uint8> alpha(static_cast<std::size_t>(width) * height);
+    if (!alpha.empty() && !stream.read(reinterpret_cast<char*>(&alpha[0]), alpha.size()))
+        return false;
+
+    std::vector<sf::Uint8> pixels(alpha.size() * 4, 255);
+    for (std::size_t i = 0; i < alpha.size(); ++i)
+        pixels[i * 4 + 3] = alpha[i];
+
+    if (!pixels.empty())
+        image.create(width, height, &pixels[0]);
+    else
+        image = sf::Image();
+
+    rowTop = savedRowTop;
+    rowLeft = savedRowLeft;
+    rowHeight = savedRowHeight;
+
+    if (pixels.empty())
+        return true;
+
+    if (!texture.loadFromImage(image))
+        return false;
+
+    //Same as the pages of sf::Font
+    texture.setSmooth(true);
+
+    return true;
+}
+
+sf::IntRect sfGlyphPage::findGlyphRect(unsigned int width, unsigned int height)
+{
+    //Start with the same size as the pages of sf::Font
+    if (image.getSize().x == 0)
+        image.create(128, 128, sf::Color(255, 255, 255, 0));
+
+    sf::Vector2u size = image.getSize();
+
+    //Glyphs are packed in rows, and a new row is started when the current one is full or too short
+    if ((rowLeft + width + padding > size.x) || (height + padding > rowHeight))
+    {
+        rowTop += rowHeight;
+        rowLeft = 0;
+        rowHeight = height + padding;
+    }
+
+    //Make the page larger when there is no room left
+    unsigned int maximumSize = sf::Texture::getMaximumSize();
+    unsigned int newWidth = size.x;
+    unsigned int newHeight = size.y;
+
+    while ((width + padding > newWidth) && (newWidth * 2 <= maximumSize))
+        newWidth *= 2;
+
+    while ((rowTop + rowHeight > newHeight) && (newHeight * 2 <= maximumSize))
+        newHeight *= 2;
+
+    if ((newWidth != size.x) || (newHeight != size.y))
+    {
+        sf::Image grown;
+        grown.create(newWidth, newHeight, sf::Color(255, 255, 255, 0));
+        grown.copy(image, 0, 0);
+        image = grown;
+        size = image.getSize();
+    }
+
+    if ((width + padding > size.x) || (rowTop + rowHeight > size.y))
+    {
+        sf::err() << "Failed to add a new glyph to the atlas: the maximum texture size has been reached" << std::endl;
+        return sf::IntRect(0, 0, 2, 2);
+    }
+
+    sf::IntRect rect(rowLeft + padding / 2, rowTop + padding / 2, width, height);
+    rowLeft += width + padding;
+
+    return rect;
+}
@@ -0,0 +1,75 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_GLYPHPAGE_HPP
+#define DSFML_GLYPHPAGE_HPP
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <ostream>
+
+// Build the key identifying a glyph in a page, the same way sf::Font does
+sf::Uint64 glyphKey(sf::Uint32 codePoint, bool bold, float outlineThickness);
+
+// A page of already rasterized glyphs for a single character size, which
+// stands in for sf::Font's own page once it has been restored from a file
+struct sfGlyphPage
+{
+    sfGlyphPage();
+
+    // Find a glyph, copying it over from the font when the page doesn't have it yet
+    const sf::Glyph& getGlyph(const sf::Font& font, unsigned int characterSize, sf::Uint32 codePoint, bool bold, float outlineThickness);
+
+    // Copy the glyphs of a string that the page doesn't have yet, reading back the font's page only once
+    void loadGlyphs(const sf::Font& font, unsigned int characterSize, const sf::Uint32* codePoints, std::size_t count, bool bold, float outlineThickness);
+
+    // Copy some glyphs and the pixels they use from the font's own page
+    void copyFromFont(const sf::Font& font, unsigned int characterSize, const std::map<sf::Uint64, sf::Glyph>& fontGlyphs);
+
+    // Write the glyphs and the alpha channel of the page to a stream
+    bool save(std::ostream& stream) const;
+
+    // Read the glyphs and the alpha channel of the page from a stream
+    bool load(std::istream& stream);
+
+    // Find room for a new glyph, growing the page if needed
+    sf::IntRect findGlyphRect(unsigned int width, unsigned int height);
+
+    std::map<sf::Uint64, sf::Glyph> glyphs;
+    sf::Image                      image;
+    sf::Texture                    texture;
+    unsigned int                   rowTop;
+    unsigned int                   rowLeft;
+    unsigned int                   rowHeight;
+};
+
+#endif // DSFML_GLYPHPAGE_HPP
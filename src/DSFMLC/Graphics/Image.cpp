@@ -27,6 +27,63 @@
 
 #include <DSFMLC/Graphics/Image.h>
 #include <DSFMLC/Graphics/ImageStruct.h>
+#include <DSFMLC/Graphics/ImageLoader.hpp>
+#include <DSFMLC/Graphics/PixelKernels.hpp>
+#include <DSFMLC/Graphics/Resampler.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    //Decode one image of a load on the pool, unless the load was cancelled first
+    void queue(const std::shared_ptr<sfImageLoadState>& state, std::size_t index, const std::function<bool(sf::Image&)>& decode)
+    {
+        imageloader::enqueue([state, index, decode]()
+        {
+            bool loaded = !state->Cancelled && decode(state->Images[index]->This);
+
+            std::lock_guard<std::mutex> lock(state->Mutex);
+            state->Finished[index] = true;
+            state->Loaded[index] = loaded;
+            state->FinishedCount++;
+            state->Condition.notify_all();
+        });
+    }
+
+    void queueFile(const std::shared_ptr<sfImageLoadState>& state, std::size_t index, const std::string& filename)
+    {
+        queue(state, index, [filename](sf::Image& image)
+        {
+            return image.loadFromFile(filename);
+        });
+    }
+
+    //sf::Image only hands out its pixels as const, but they are owned by the image being changed
+    sf::Uint8* getPixels(sf::Image& image)
+    {
+        return const_cast<sf::Uint8*>(image.getPixelsPtr());
+    }
+
+    std::size_t getPixelCount(const sf::Image& image)
+    {
+        return static_cast<std::size_t>(image.getSize().x) * image.getSize().y;
+    }
+
+    bool containsRegion(const sf::Image& image, DUint left, DUint top, DUint width, DUint height)
+    {
+        sf::Vector2u size = image.getSize();
+
+        if ((left > size.x) || (top > size.y) || (width > size.x - left) || (height > size.y - top))
+        {
+            sf::err() << "The region (" << left << ", " << top << ", " << width << ", " << height
+                      << ") is outside of the image (" << size.x << "x" << size.y << ")" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
 
 sfImage* sfImage_construct(void)
 {
@@ -66,6 +123,49 @@ DBool sfImage_loadFromStream(sfImage* image, DStream* stream)
     return image->This.loadFromStream(Stream)?DTrue:DFalse;
 }
 
+sfImageLoad* sfImage_loadFromFileAsync(const char* filename, size_t length)
+{
+    sfImageLoad* load = new sfImageLoad;
+    load->State = std::make_shared<sfImageLoadState>(1);
+
+    queueFile(load->State, 0, std::string(filename, length));
+
+    return load;
+}
+
+sfImageLoad* sfImage_loadFromMemoryAsync(const void* data, size_t size)
+{
+    sfImageLoad* load = new sfImageLoad;
+    load->State = std::make_shared<sfImageLoadState>(1);
+
+    //The caller's memory may be gone by the time the image is decoded
+    std::shared_ptr<std::vector<char>> copy = std::make_shared<std::vector<char>>(static_cast<const char*>(data),
+                                                                                 static_cast<const char*>(data) + size);
+
+    queue(load->State, 0, [copy](sf::Image& image)
+    {
+        return !copy->empty() && image.loadFromMemory(&(*copy)[0], copy->size());
+    });
+
+    return load;
+}
+
+sfImageLoad* sfImage_loadMany(const char* const* filenames, const size_t* lengths, size_t count)
+{
+    sfImageLoad* load = new sfImageLoad;
+    load->State = std::make_shared<sfImageLoadState>(count);
+
+    for (size_t i = 0; i < count; ++i)
+        queueFile(load->State, i, std::string(filenames[i], lengths[i]));
+
+    return load;
+}
+
+void sfImage_setDecodeThreadCount(DUint count)
+{
+    imageloader::setThreadCount(count);
+}
+
 sfImage* sfImage_copy(const sfImage* image)
 {
     return new sfImage(*image);
@@ -83,13 +183,60 @@ DBool sfImage_saveToFile(const sfImage* image, const char* filename, size_t leng
 
 void sfImage_createMaskFromColor(sfImage* image, DUbyte r, DUbyte b, DUbyte g, DUbyte a, DUbyte alpha)
 {
-    image->This.createMaskFromColor(sf::Color(r, g, b, a), alpha);
+    if (getPixelCount(image->This) == 0)
+        return;
+
+    const sf::Uint8 color[4] = {r, g, b, a};
+    pixelkernels::maskFromColor(getPixels(image->This), getPixelCount(image->This), color, alpha);
 }
 
-void sfImage_copyImage(sfImage* image, const sfImage* source, DUint destX, DUint destY, DInt sourceRectTop, DInt sourceRectLeft, DInt sourceRectWidth, DInt sourceRectHeight, DBool applyAlpha)
+void sfImage_copyImage(sfImage* image, const sfImage* source, DUint destX, DUint destY, DInt sourceRectLeft, DInt sourceRectTop, DInt sourceRectWidth, DInt sourceRectHeight, DBool applyAlpha)
 {
     sf::IntRect sfmlRect(sourceRectLeft, sourceRectTop, sourceRectWidth, sourceRectHeight);
-    image->This. copy(source->This, destX, destY, sfmlRect, applyAlpha == DTrue);
+
+    //Plain copies are row memcpys in SFML already, only blending goes through the kernels
+    if (applyAlpha != DTrue)
+    {
+        image->This.copy(source->This, destX, destY, sfmlRect, false);
+        return;
+    }
+
+    sf::Vector2u sourceSize = source->This.getSize();
+    sf::Vector2u size = image->This.getSize();
+    if ((sourceSize.x == 0) || (sourceSize.y == 0) || (size.x == 0) || (size.y == 0))
+        return;
+
+    //Keep the source rectangle inside the source image, rows past its edge would be read out of bounds
+    if ((sfmlRect.width == 0) || (sfmlRect.height == 0))
+    {
+        sfmlRect = sf::IntRect(0, 0, static_cast<int>(sourceSize.x), static_cast<int>(sourceSize.y));
+    }
+    else
+    {
+        sfmlRect.left = std::max(sfmlRect.left, 0);
+        sfmlRect.top = std::max(sfmlRect.top, 0);
+        if ((sfmlRect.left >= static_cast<int>(sourceSize.x)) || (sfmlRect.top >= static_cast<int>(sourceSize.y)))
+            return;
+
+        sfmlRect.width = std::min(sfmlRect.width, static_cast<int>(sourceSize.x) - sfmlRect.left);
+        sfmlRect.height = std::min(sfmlRect.height, static_cast<int>(sourceSize.y) - sfmlRect.top);
+    }
+
+    int width = std::min(sfmlRect.width, static_cast<int>(size.x) - static_cast<int>(destX));
+    int height = std::min(sfmlRect.height, static_cast<int>(size.y) - static_cast<int>(destY));
+    if ((width <= 0) || (height <= 0))
+        return;
+
+    const sf::Uint8* sourcePixels = source->This.getPixelsPtr();
+    sf::Uint8* pixels = getPixels(image->This);
+
+    for (int row = 0; row < height; ++row)
+    {
+        const sf::Uint8* from = sourcePixels + ((sfmlRect.top + row) * static_cast<std::size_t>(sourceSize.x) + sfmlRect.left) * 4;
+        sf::Uint8* to = pixels + ((destY + row) * static_cast<std::size_t>(size.x) + destX) * 4;
+
+        pixelkernels::blend(from, to, static_cast<std::size_t>(width));
+    }
 }
 
 void sfImage_setPixel(sfImage* image, DUint x, DUint y, DUbyte r, DUbyte b, DUbyte g, DUbyte a)
@@ -112,6 +259,86 @@ const DUbyte* sfImage_getPixelsPtr(const sfImage* image)
     return image->This.getPixelsPtr();
 }
 
+DBool sfImage_getPixels(const sfImage* image, DUint left, DUint top, DUint width, DUint height, DUbyte* pixels)
+{
+    if (!containsRegion(image->This, left, top, width, height))
+        return DFalse;
+
+    if ((width == 0) || (height == 0))
+        return DTrue;
+
+    std::size_t stride = static_cast<std::size_t>(image->This.getSize().x) * 4;
+    const sf::Uint8* from = image->This.getPixelsPtr() + top * stride + static_cast<std::size_t>(left) * 4;
+
+    for (DUint row = 0; row < height; ++row)
+        std::memcpy(pixels + row * static_cast<std::size_t>(width) * 4, from + row * stride, static_cast<std::size_t>(width) * 4);
+
+    return DTrue;
+}
+
+DBool sfImage_setPixels(sfImage* image, DUint left, DUint top, DUint width, DUint height, const DUbyte* pixels)
+{
+    if (!containsRegion(image->This, left, top, width, height))
+        return DFalse;
+
+    if ((width == 0) || (height == 0))
+        return DTrue;
+
+    std::size_t stride = static_cast<std::size_t>(image->This.getSize().x) * 4;
+    sf::Uint8* to = getPixels(image->This) + top * stride + static_cast<std::size_t>(left) * 4;
+
+    for (DUint row = 0; row < height; ++row)
+        std::memcpy(to + row * stride, pixels + row * static_cast<std::size_t>(width) * 4, static_cast<std::size_t>(width) * 4);
+
+    return DTrue;
+}
+
+void sfImage_fill(sfImage* image, DUbyte r, DUbyte g, DUbyte b, DUbyte a)
+{
+    if (getPixelCount(image->This) == 0)
+        return;
+
+    const sf::Uint8 color[4] = {r, g, b, a};
+    pixelkernels::fill(getPixels(image->This), getPixelCount(image->This), color);
+}
+
+void sfImage_premultiplyAlpha(sfImage* image)
+{
+    if (getPixelCount(image->This) == 0)
+        return;
+
+    pixelkernels::premultiply(getPixels(image->This), getPixelCount(image->This));
+}
+
+DBool sfImage_swizzle(sfImage* image, DUint r, DUint g, DUint b, DUint a)
+{
+    if ((r > 3) || (g > 3) || (b > 3) || (a > 3))
+    {
+        sf::err() << "Failed to swizzle image, channel indices must be between 0 and 3" << std::endl;
+        return DFalse;
+    }
+
+    const unsigned int order[4] = {r, g, b, a};
+
+    if (getPixelCount(image->This) > 0)
+        pixelkernels::swizzle(getPixels(image->This), getPixelCount(image->This), order);
+
+    return DTrue;
+}
+
+DBool sfImage_setInstructionSet(DInt instructionSet)
+{
+    if ((instructionSet < sfImageScalar) || (instructionSet > sfImageNeon))
+        return DFalse;
+
+    return pixelkernels::setInstructionSet(static_cast<pixelkernels::InstructionSet>(instructionSet)) ? DTrue : DFalse;
+}
+
+DInt sfImage_getInstructionSet(void)
+{
+    return pixelkernels::getInstructionSet();
+}
+
 void sfImage_getSize(const sfImage* image, DUint* width, DUint* height)
 {
     sf::Vector2u sfmlSize = image->This.getSize();
@@ -122,10 +349,126 @@ void sfImage_getSize(const sfImage* image, DUint* width, DUint* height)
 
 void sfImage_flipHorizontally(sfImage* image)
 {
-    image->This.flipHorizontally();
+    if (getPixelCount(image->This) == 0)
+        return;
+
+    pixelkernels::flipHorizontally(getPixels(image->This), image->This.getSize().x, image->This.getSize().y);
 }
 
 void sfImage_flipVertically(sfImage* image)
 {
-    image->This.flipVertically();
+    if (getPixelCount(image->This) == 0)
+        return;
+
+    pixelkernels::flipVertically(getPixels(image->This), image->This.getSize().x, image->This.getSize().y);
+}
+
+sfImage* sfImage_resize(const sfImage* image, DUint width, DUint height, DInt filter)
+{
+    sf::Vector2u size = image->This.getSize();
+
+    if ((size.x == 0) || (size.y == 0) || (width == 0) || (height == 0))
+    {
+        sf::err() << "Failed to resize image, its size and the new size can't be empty" << std::endl;
+        return NULL;
+    }
+
+    if ((filter < sfImageBox) || (filter > sfImageLanczos))
+    {
+        sf::err() << "Failed to resize image, unknown filter " << filter << std::endl;
+        return NULL;
+    }
+
+    sfImage* resized = new sfImage;
+    resized->This.create(width, height);
+
+    resampler::resize(image->This.getPixelsPtr(), size.x, size.y, getPixels(resized->This), width, height, static_cast<resampler::Filter>(filter));
+
+    return resized;
+}
+
+size_t sfImage_createMipmaps(const sfImage* image, DInt filter, sfImage** levels, size_t count)
+{
+    const sfImage* previous = image;
+    size_t created = 0;
+
+    while (created < count)
+    {
+        sf::Vector2u size = previous->This.getSize();
+        if ((size.x <= 1) && (size.y <= 1))
+            break;
+
+        //Each level is made from the previous one rather than the full image, which keeps the filters small
+        levels[created] = sfImage_resize(previous, std::max(1u, size.x / 2), std::max(1u, size.y / 2), filter);
+        if (!levels[created])
+            break;
+
+        previous = levels[created++];
+    }
+
+    return created;
+}
+
+size_t sfImageLoad_getCount(const sfImageLoad* load)
+{
+    return load->State->Images.size();
+}
+
+size_t sfImageLoad_getFinishedCount(const sfImageLoad* load)
+{
+    std::lock_guard<std::mutex> lock(load->State->Mutex);
+    return load->State->FinishedCount;
+}
+
+DBool sfImageLoad_isReady(const sfImageLoad* load)
+{
+    return (sfImageLoad_getFinishedCount(load) == load->State->Images.size()) ? DTrue : DFalse;
+}
+
+DBool sfImageLoad_wait(const sfImageLoad* load)
+{
+    sfImageLoadState& state = *load->State;
+
+    std::unique_lock<std::mutex> lock(state.Mutex);
+    state.Condition.wait(lock, [&state] { return state.FinishedCount == state.Images.size(); });
+
+    for (std::size_t i = 0; i < state.Loaded.size(); ++i)
+    {
+        if (!state.Loaded[i])
+            return DFalse;
+    }
+
+    return DTrue;
+}
+
+void sfImageLoad_cancel(sfImageLoad* load)
+{
+    load->State->Cancelled = true;
+}
+
+DBool sfImageLoad_isLoaded(const sfImageLoad* load, size_t index)
+{
+    std::lock_guard<std::mutex> lock(load->State->Mutex);
+    return ((index < load->State->Loaded.size()) && load->State->Loaded[index]) ? DTrue : DFalse;
+}
+
+sfImage* sfImageLoad_takeImage(sfImageLoad* load, size_t index)
+{
+    sfImageLoadState& state = *load->State;
+
+    if (index >= state.Images.size())
+        return NULL;
+
+    std::unique_lock<std::mutex> lock(state.Mutex);
+    state.Condition.wait(lock, [&state, index] { return state.Finished[index]; });
+
+    //Images can only be taken once, which spares copying their pixels
+    return state.Loaded[index] ? state.Images[index].release() : NULL;
+}
+
+void sfImageLoad_destroy(sfImageLoad* load)
+{
+    //The tasks keep the state alive, they only need to know their images are no longer wanted
+    load->State->Cancelled = true;
+    delete load;
 }
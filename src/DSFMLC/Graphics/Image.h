@@ -34,6 +34,24 @@
 #include <stddef.h>
 
 
+//Instruction sets the pixel operations of images can use
+typedef enum
+{
+    sfImageScalar,
+    sfImageSse2,
+    sfImageAvx2,
+    sfImageNeon
+} sfImageInstructionSet;
+
+//Filters images can be resized with
+typedef enum
+{
+    sfImageBox,
+    sfImageBilinear,
+    sfImageBicubic,
+    sfImageLanczos
+} sfImageFilter;
+
 //Construct a new image
 DSFML_GRAPHICS_API sfImage* sfImage_construct(void);
 
@@ -55,6 +73,24 @@ DSFML_GRAPHICS_API DBool sfImage_loadFromMemory(sfImage* image, const void* data
 //Create an image from a custom stream
 DSFML_GRAPHICS_API DBool sfImage_loadFromStream(sfImage* image, DStream* stream);
 
+//Decode an image file on the decoding threads
+DSFML_GRAPHICS_API sfImageLoad* sfImage_loadFromFileAsync(const char* filename, size_t length);
+
+//Decode a copy of an image file in memory on the decoding threads
+DSFML_GRAPHICS_API sfImageLoad* sfImage_loadFromMemoryAsync(const void* data, size_t size);
+
+//Decode many image files across the decoding threads
+DSFML_GRAPHICS_API sfImageLoad* sfImage_loadMany(const char* const* filenames, const size_t* lengths, size_t count);
+
+//Set the number of threads decoding images in the background, 0 uses one per core
+DSFML_GRAPHICS_API void sfImage_setDecodeThreadCount(DUint count);
+
+//Make the pixel operations of images use an instruction set, returning false if it isn't supported
+DSFML_GRAPHICS_API DBool sfImage_setInstructionSet(DInt instructionSet);
+
+//Get the instruction set the pixel operations of images use
+DSFML_GRAPHICS_API DInt sfImage_getInstructionSet(void);
+
 //Copy an existing image
 DSFML_GRAPHICS_API sfImage* sfImage_copy(const sfImage* image);
 
@@ -71,7 +107,7 @@ DSFML_GRAPHICS_API void sfImage_getSize(const sfImage* image, DUint* width, DUin
 DSFML_GRAPHICS_API void sfImage_createMaskFromColor(sfImage* image, DUbyte r, DUbyte b, DUbyte g, DUbyte a, DUbyte alpha);
 
 //Copy pixels from an image onto another
-DSFML_GRAPHICS_API void sfImage_copyImage(sfImage* image, const sfImage* source, DUint destX, DUint destY, DInt sourceRectTop, DInt sourceRectLeft, DInt sourceRectWidth, DInt sourceRectHeight, DBool applyAlpha);
+DSFML_GRAPHICS_API void sfImage_copyImage(sfImage* image, const sfImage* source, DUint destX, DUint destY, DInt sourceRectLeft, DInt sourceRectTop, DInt sourceRectWidth, DInt sourceRectHeight, DBool applyAlpha);
 
 //Change the color of a pixel in an image
 DSFML_GRAPHICS_API void sfImage_setPixel(sfImage* image, DUint x, DUint y, DUbyte r, DUbyte b, DUbyte g, DUbyte a);
@@ -82,10 +118,55 @@ DSFML_GRAPHICS_API void sfImage_getPixel(const sfImage* image, DUint x, DUint y,
 //Get a read-only pointer to the array of pixels of an image
 DSFML_GRAPHICS_API const DUbyte* sfImage_getPixelsPtr(const sfImage* image);
 
+//Copy the pixels of a region of an image into an array
+DSFML_GRAPHICS_API DBool sfImage_getPixels(const sfImage* image, DUint left, DUint top, DUint width, DUint height, DUbyte* pixels);
+
+//Replace the pixels of a region of an image with an array
+DSFML_GRAPHICS_API DBool sfImage_setPixels(sfImage* image, DUint left, DUint top, DUint width, DUint height, const DUbyte* pixels);
+
+//Set every pixel of an image to a color
+DSFML_GRAPHICS_API void sfImage_fill(sfImage* image, DUbyte r, DUbyte g, DUbyte b, DUbyte a);
+
+//Multiply the color channels of every pixel of an image by its alpha
+DSFML_GRAPHICS_API void sfImage_premultiplyAlpha(sfImage* image);
+
+//Reorder the channels of every pixel of an image, each argument is the index of the original channel to use
+DSFML_GRAPHICS_API DBool sfImage_swizzle(sfImage* image, DUint r, DUint g, DUint b, DUint a);
+
 //Flip an image horizontally (left <-> right)
 DSFML_GRAPHICS_API void sfImage_flipHorizontally(sfImage* image);
 
 //Flip an image vertically (top <-> bottom)
 DSFML_GRAPHICS_API void sfImage_flipVertically(sfImage* image);
 
+//Create a resized copy of an image, or return NULL if either size is empty
+DSFML_GRAPHICS_API sfImage* sfImage_resize(const sfImage* image, DUint width, DUint height, DInt filter);
+
+//Create the mipmaps of an image, each half the size of the previous one, returning how many were created
+DSFML_GRAPHICS_API size_t sfImage_createMipmaps(const sfImage* image, DInt filter, sfImage** levels, size_t count);
+
+//Get the number of images of a background load
+DSFML_GRAPHICS_API size_t sfImageLoad_getCount(const sfImageLoad* load);
+
+//Get the number of images of a background load that were decoded, failed or were cancelled
+DSFML_GRAPHICS_API size_t sfImageLoad_getFinishedCount(const sfImageLoad* load);
+
+//Tell whether all the images of a background load are finished, without blocking
+DSFML_GRAPHICS_API DBool sfImageLoad_isReady(const sfImageLoad* load);
+
+//Wait for all the images of a background load, returning whether they were all decoded
+DSFML_GRAPHICS_API DBool sfImageLoad_wait(const sfImageLoad* load);
+
+//Skip the images of a background load that haven't started decoding
+DSFML_GRAPHICS_API void sfImageLoad_cancel(sfImageLoad* load);
+
+//Tell whether an image of a background load was decoded, without blocking
+DSFML_GRAPHICS_API DBool sfImageLoad_isLoaded(const sfImageLoad* load, size_t index);
+
+//Wait for an image of a background load and hand it over, or return NULL if it failed or was already taken
+DSFML_GRAPHICS_API sfImage* sfImageLoad_takeImage(sfImageLoad* load, size_t index);
+
+//Cancel and destroy a background load
+DSFML_GRAPHICS_API void sfImageLoad_destroy(sfImageLoad* load);
+
 #endif // SFML_IMAGE_H
@@ -0,0 +1,147 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/ImageLoader.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    class Pool
+    {
+    public:
+        Pool() :
+        m_threadCount(0)
+        {
+        }
+
+        ~Pool()
+        {
+            resize(0);
+        }
+
+        void enqueue(const std::function<void()>& task)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            //Threads are started on first use so that programs which never decode in the background don't pay for them
+            if (m_threads.empty())
+                spawn(defaultCount());
+
+            m_tasks.push_back(task);
+            m_condition.notify_one();
+        }
+
+        void resize(unsigned int count)
+        {
+            std::vector<std::thread> stopped;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                spawn(count);
+
+                while (m_threads.size() > count)
+                {
+                    stopped.push_back(std::move(m_threads.back()));
+                    m_threads.pop_back();
+                }
+            }
+
+            m_condition.notify_all();
+
+            for (std::size_t i = 0; i < stopped.size(); ++i)
+                stopped[i].join();
+        }
+
+        static unsigned int defaultCount()
+        {
+            unsigned int cores = std::thread::hardware_concurrency();
+            return cores ? cores : 2;
+        }
+
+    private:
+        //Must be called with the mutex locked
+        void spawn(unsigned int count)
+        {
+            m_threadCount = count;
+
+            while (m_threads.size() < m_threadCount)
+                m_threads.push_back(std::thread(&Pool::run, this, static_cast<unsigned int>(m_threads.size())));
+        }
+
+        void run(unsigned int index)
+        {
+            while (true)
+            {
+                std::function<void()> task;
+
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this, index] { return (index >= m_threadCount) || !m_tasks.empty(); });
+
+                    //Threads beyond the count leave, the remaining ones drain the queue
+                    if (index >= m_threadCount)
+                        return;
+
+                    task = m_tasks.front();
+                    m_tasks.pop_front();
+                }
+
+                task();
+            }
+        }
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<std::function<void()>> m_tasks;
+        std::vector<std::thread> m_threads;
+        unsigned int m_threadCount;
+    };
+
+    Pool& getPool()
+    {
+        static Pool pool;
+        return pool;
+    }
+}
+
+namespace imageloader
+{
+    void enqueue(const std::function<void()>& task)
+    {
+        getPool().enqueue(task);
+    }
+
+    void setThreadCount(unsigned int count)
+    {
+        getPool().resize(count ? count : Pool::defaultCount());
+    }
+}
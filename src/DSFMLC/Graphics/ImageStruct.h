@@ -29,6 +29,11 @@
 #define DSFML_IMAGESTRUCT_H
 
 #include <SFML/Graphics/Image.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 //Internal structure of sfImage
 struct sfImage
@@ -36,4 +41,36 @@ struct sfImage
     sf::Image This;
 };
 
+//Images being decoded in the background, shared with the tasks decoding them
+struct sfImageLoadState
+{
+    sfImageLoadState(std::size_t count) :
+    Images(count),
+    Finished(count, false),
+    Loaded(count, false),
+    FinishedCount(0),
+    Cancelled(false)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            Images[i].reset(new sfImage);
+    }
+
+    std::mutex Mutex;
+    std::condition_variable Condition;
+
+    //Each task only writes its own image, the flags are guarded by the mutex
+    std::vector<std::unique_ptr<sfImage>> Images;
+    std::vector<bool> Finished;
+    std::vector<bool> Loaded;
+    std::size_t FinishedCount;
+
+    std::atomic<bool> Cancelled;
+};
+
+//Internal structure of sfImageLoad
+struct sfImageLoad
+{
+    std::shared_ptr<sfImageLoadState> State;
+};
+
 #endif // SFML_IMAGESTRUCT_H
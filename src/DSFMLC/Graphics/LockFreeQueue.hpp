@@ -0,0 +1,148 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_LOCKFREEQUEUE_HPP
+#define DSFML_LOCKFREEQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+//Bounded queue that any number of threads can push to and pop from without locking
+template <typename T>
+class LockFreeQueue
+{
+public:
+    //The capacity is rounded up to a power of two
+    explicit LockFreeQueue(std::size_t capacity) :
+    m_mask(roundUp(capacity) - 1),
+    m_cells(new Cell[m_mask + 1]),
+    m_pushPosition(0),
+    m_popPosition(0)
+    {
+        for (std::size_t i = 0; i <= m_mask; ++i)
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    //Return false if the queue is full
+    bool push(const T& value)
+    {
+        std::size_t position = m_pushPosition.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true)
+        {
+            cell = &m_cells[position & m_mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0)
+            {
+                if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = value;
+        cell->sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    //Return false if the queue is empty
+    bool pop(T& value)
+    {
+        std::size_t position = m_popPosition.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        while (true)
+        {
+            cell = &m_cells[position & m_mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+            if (difference == 0)
+            {
+                if (m_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_popPosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = cell->value;
+        cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+
+        return true;
+    }
+
+private:
+    //Each cell tells, through its sequence, whether it is ready to be pushed to or popped from
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    static std::size_t roundUp(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+
+        return size;
+    }
+
+    LockFreeQueue(const LockFreeQueue&);
+    LockFreeQueue& operator=(const LockFreeQueue&);
+
+    const std::size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    //Kept on separate cache lines so that pushing and popping threads don't slow each other down
+    char m_padding0[64];
+    std::atomic<std::size_t> m_pushPosition;
+    char m_padding1[64];
+    std::atomic<std::size_t> m_popPosition;
+    char m_padding2[64];
+};
+
+#endif // DSFML_LOCKFREEQUEUE_HPP
@@ -0,0 +1,191 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_PARALLEL_HPP
+#define DSFML_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel
+{
+    //Run a function for every index, spread over the available cores, and wait for all of them
+    template <typename Function>
+    void forEach(std::size_t count, Function function)
+    {
+        std::atomic<std::size_t> next(0);
+
+        auto work = [&]()
+        {
+            for (std::size_t i = next++; i < count; i = next++)
+                function(i);
+        };
+
+        std::size_t threadCount = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), count);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < threadCount; ++i)
+            threads.push_back(std::thread(work));
+
+        work();
+
+        for (std::size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+    }
+
+    //Threads kept waiting for work, for jobs run too often to start threads each time
+    class ThreadPool
+    {
+    public:
+
+        //Start a thread per core besides the calling one, which also works during forEach
+        ThreadPool() :
+        m_function(NULL),
+        m_count(0),
+        m_next(0),
+        m_generation(0),
+        m_pending(0),
+        m_stopping(false)
+        {
+            std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+            for (std::size_t i = 0; i < threadCount; ++i)
+                m_threads.push_back(std::thread(&ThreadPool::run, this));
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_wake.notify_all();
+
+            for (std::size_t i = 0; i < m_threads.size(); ++i)
+                m_threads[i].join();
+        }
+
+        //Number of threads working during forEach, the calling one included
+        std::size_t getThreadCount() const
+        {
+            return m_threads.size() + 1;
+        }
+
+        //Run a function for every index on the pool's threads and wait for all of them,
+        //jobs started from several threads at once run one after the other
+        void forEach(std::size_t count, const std::function<void(std::size_t)>& function)
+        {
+            if (m_threads.empty() || (count < 2))
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    function(i);
+                return;
+            }
+
+            std::lock_guard<std::mutex> job(m_jobMutex);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_function = &function;
+                m_count = count;
+                m_next = 0;
+                m_pending = m_threads.size();
+                ++m_generation;
+            }
+            m_wake.notify_all();
+
+            work();
+
+            //Every thread takes part in every job, so none of them still uses the function once this returns
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this]() { return m_pending == 0; });
+            m_function = NULL;
+        }
+
+    private:
+
+        ThreadPool(const ThreadPool&);
+        ThreadPool& operator=(const ThreadPool&);
+
+        void work()
+        {
+            for (std::size_t i = m_next++; i < m_count; i = m_next++)
+                (*m_function)(i);
+        }
+
+        void run()
+        {
+            std::size_t generation = 0;
+
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wake.wait(lock, [&]() { return m_stopping || (m_generation != generation); });
+
+                    if (m_stopping)
+                        return;
+
+                    generation = m_generation;
+                }
+
+                work();
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_pending == 0)
+                    m_done.notify_one();
+            }
+        }
+
+        std::vector<std::thread> m_threads;
+        std::mutex m_jobMutex;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        const std::function<void(std::size_t)>* m_function;
+        std::size_t m_count;
+        std::atomic<std::size_t> m_next;
+        std::size_t m_generation;
+        std::size_t m_pending;
+        bool m_stopping;
+    };
+
+    //The pool shared by everything that needs one, started the first time it is used
+    inline ThreadPool& getThreadPool()
+    {
+        //Never destroyed, joining threads while the program exits can deadlock on some platforms
+        static ThreadPool* threadPool = new ThreadPool;
+
+        return *threadPool;
+    }
+}
+
+#endif // DSFML_PARALLEL_HPP
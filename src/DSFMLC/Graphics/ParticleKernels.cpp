@@ -0,0 +1,418 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/ParticleKernels.hpp>
+#include <DSFMLC/Graphics/PixelKernels.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define DSFML_PARTICLEKERNELS_SSE2
+    #include <emmintrin.h>
+
+    //AVX functions are compiled for it on their own and only called when the pixel kernels chose AVX2
+    #if defined(_MSC_VER)
+        #define DSFML_PARTICLEKERNELS_AVX2
+        #define DSFML_TARGET_AVX2
+        #include <immintrin.h>
+    #elif defined(__GNUC__)
+        #define DSFML_PARTICLEKERNELS_AVX2
+        #define DSFML_TARGET_AVX2 __attribute__((target("avx2")))
+        #include <immintrin.h>
+    #endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    //32 bit NEON has no division or square root
+    #define DSFML_PARTICLEKERNELS_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace
+{
+    sf::Uint8 toChannel(float value)
+    {
+        return static_cast<sf::Uint8>(std::min(std::max(value, 0.f), 255.f) + 0.5f);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Scalar kernels, also used for the particles left over by the vector loops
+    ////////////////////////////////////////////////////////////
+
+    void integrateScalar(float* x, float* y, float* velocityX, float* velocityY, float* life,
+                         std::size_t begin, std::size_t end, const particlekernels::Forces& forces, float seconds)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            float accelerationX = forces.accelerationX;
+            float accelerationY = forces.accelerationY;
+
+            for (std::size_t j = 0; j < forces.attractorCount; ++j)
+            {
+                const float* attractor = forces.attractors + j * 3;
+                float dx = attractor[0] - x[i];
+                float dy = attractor[1] - y[i];
+                float distance = dx * dx + dy * dy + 1.f;
+                float pull = attractor[2] / (distance * std::sqrt(distance));
+
+                accelerationX = accelerationX + pull * dx;
+                accelerationY = accelerationY + pull * dy;
+            }
+
+            velocityX[i] = (velocityX[i] + accelerationX * seconds) * forces.damping;
+            velocityY[i] = (velocityY[i] + accelerationY * seconds) * forces.damping;
+            x[i] = x[i] + velocityX[i] * seconds;
+            y[i] = y[i] + velocityY[i] * seconds;
+            life[i] = life[i] - seconds;
+        }
+    }
+
+    void advanceScalar(float* values, const float* rates, std::size_t begin, std::size_t end, float seconds)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            values[i] = values[i] + rates[i] * seconds;
+    }
+
+    void writeQuadsScalar(const float* x, const float* y, const float* size, const float* const* color,
+                          const float* textureRect, std::size_t begin, std::size_t end, sf::Vertex* vertices)
+    {
+        const float textureLeft = textureRect[0];
+        const float textureTop = textureRect[1];
+        const float textureRight = textureRect[0] + textureRect[2];
+        const float textureBottom = textureRect[1] + textureRect[3];
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            float half = std::max(size[i], 0.f) * 0.5f;
+            float left = x[i] - half;
+            float top = y[i] - half;
+            float right = x[i] + half;
+            float bottom = y[i] + half;
+            sf::Color particleColor(toChannel(color[0][i]), toChannel(color[1][i]), toChannel(color[2][i]), toChannel(color[3][i]));
+
+            sf::Vertex* quad = vertices + i * 4;
+            quad[0] = sf::Vertex(sf::Vector2f(left, top), particleColor, sf::Vector2f(textureLeft, textureTop));
+            quad[1] = sf::Vertex(sf::Vector2f(right, top), particleColor, sf::Vector2f(textureRight, textureTop));
+            quad[2] = sf::Vertex(sf::Vector2f(right, bottom), particleColor, sf::Vector2f(textureRight, textureBottom));
+            quad[3] = sf::Vertex(sf::Vector2f(left, bottom), particleColor, sf::Vector2f(textureLeft, textureBottom));
+        }
+    }
+
+
+#ifdef DSFML_PARTICLEKERNELS_SSE2
+    ////////////////////////////////////////////////////////////
+    // SSE2 kernels, 4 particles at a time
+    ////////////////////////////////////////////////////////////
+
+    std::size_t integrateSse2(float* x, float* y, float* velocityX, float* velocityY, float* life,
+                              std::size_t begin, std::size_t end, const particlekernels::Forces& forces, float seconds)
+    {
+        const __m128 dt = _mm_set1_ps(seconds);
+        const __m128 damping = _mm_set1_ps(forces.damping);
+        const __m128 one = _mm_set1_ps(1.f);
+
+        std::size_t i = begin;
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 px = _mm_loadu_ps(x + i);
+            __m128 py = _mm_loadu_ps(y + i);
+            __m128 accelerationX = _mm_set1_ps(forces.accelerationX);
+            __m128 accelerationY = _mm_set1_ps(forces.accelerationY);
+
+            for (std::size_t j = 0; j < forces.attractorCount; ++j)
+            {
+                const float* attractor = forces.attractors + j * 3;
+                __m128 dx = _mm_sub_ps(_mm_set1_ps(attractor[0]), px);
+                __m128 dy = _mm_sub_ps(_mm_set1_ps(attractor[1]), py);
+                __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), one);
+                __m128 pull = _mm_div_ps(_mm_set1_ps(attractor[2]), _mm_mul_ps(distance, _mm_sqrt_ps(distance)));
+
+                accelerationX = _mm_add_ps(accelerationX, _mm_mul_ps(pull, dx));
+                accelerationY = _mm_add_ps(accelerationY, _mm_mul_ps(pull, dy));
+            }
+
+            __m128 vx = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(velocityX + i), _mm_mul_ps(accelerationX, dt)), damping);
+            __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(velocityY + i), _mm_mul_ps(accelerationY, dt)), damping);
+
+            _mm_storeu_ps(velocityX + i, vx);
+            _mm_storeu_ps(velocityY + i, vy);
+            _mm_storeu_ps(x + i, _mm_add_ps(px, _mm_mul_ps(vx, dt)));
+            _mm_storeu_ps(y + i, _mm_add_ps(py, _mm_mul_ps(vy, dt)));
+            _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), dt));
+        }
+
+        return i;
+    }
+
+    std::size_t advanceSse2(float* values, const float* rates, std::size_t begin, std::size_t end, float seconds)
+    {
+        const __m128 dt = _mm_set1_ps(seconds);
+
+        std::size_t i = begin;
+        for (; i + 4 <= end; i += 4)
+            _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), _mm_mul_ps(_mm_loadu_ps(rates + i), dt)));
+
+        return i;
+    }
+
+    //A quad is 80 bytes, exactly five vectors, so each one is put together in registers and stored at once.
+    //Aligned quads bypass the cache, they won't be read again and mapped vertex buffers are write combined.
+    //Bit pattern of a float, so that it can be put in a vector along with the packed colors
+    int toBits(float value)
+    {
+        int bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        return bits;
+    }
+
+    std::size_t writeQuadsSse2(const float* x, const float* y, const float* size, const float* const* color,
+                               const float* textureRect, std::size_t begin, std::size_t end, sf::Vertex* vertices)
+    {
+        const int textureLeft = toBits(textureRect[0]);
+        const int textureTop = toBits(textureRect[1]);
+        const int textureRight = toBits(textureRect[0] + textureRect[2]);
+        const int textureBottom = toBits(textureRect[1] + textureRect[3]);
+        const bool aligned = (reinterpret_cast<std::size_t>(vertices + begin * 4) % 16) == 0;
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            float half = std::max(size[i], 0.f) * 0.5f;
+            int left = toBits(x[i] - half);
+            int top = toBits(y[i] - half);
+            int right = toBits(x[i] + half);
+            int bottom = toBits(y[i] + half);
+
+            //The color is never handled as a float, x87 loads would turn the patterns that are NaNs into other ones
+            sf::Color particleColor(toChannel(color[0][i]), toChannel(color[1][i]), toChannel(color[2][i]), toChannel(color[3][i]));
+            int packedColor;
+            std::memcpy(&packedColor, &particleColor, sizeof(packedColor));
+
+            //Vertices are x, y, color, u, v, with the corners going clockwise from the top left
+            __m128 words[5];
+            words[0] = _mm_castsi128_ps(_mm_setr_epi32(left, top, packedColor, textureLeft));
+            words[1] = _mm_castsi128_ps(_mm_setr_epi32(textureTop, right, top, packedColor));
+            words[2] = _mm_castsi128_ps(_mm_setr_epi32(textureRight, textureTop, right, bottom));
+            words[3] = _mm_castsi128_ps(_mm_setr_epi32(packedColor, textureRight, textureBottom, left));
+            words[4] = _mm_castsi128_ps(_mm_setr_epi32(bottom, packedColor, textureLeft, textureBottom));
+
+            float* quad = reinterpret_cast<float*>(vertices + i * 4);
+            if (aligned)
+            {
+                for (int word = 0; word < 5; ++word)
+                    _mm_stream_ps(quad + word * 4, words[word]);
+            }
+            else
+            {
+                for (int word = 0; word < 5; ++word)
+                    _mm_storeu_ps(quad + word * 4, words[word]);
+            }
+        }
+
+        _mm_sfence();
+        return end;
+    }
+#endif
+
+
+#ifdef DSFML_PARTICLEKERNELS_AVX2
+    ////////////////////////////////////////////////////////////
+    // AVX kernels, 8 particles at a time
+    ////////////////////////////////////////////////////////////
+
+    DSFML_TARGET_AVX2 std::size_t integrateAvx2(float* x, float* y, float* velocityX, float* velocityY, float* life,
+                                                std::size_t begin, std::size_t end, const particlekernels::Forces& forces, float seconds)
+    {
+        const __m256 dt = _mm256_set1_ps(seconds);
+        const __m256 damping = _mm256_set1_ps(forces.damping);
+        const __m256 one = _mm256_set1_ps(1.f);
+
+        std::size_t i = begin;
+        for (; i + 8 <= end; i += 8)
+        {
+            __m256 px = _mm256_loadu_ps(x + i);
+            __m256 py = _mm256_loadu_ps(y + i);
+            __m256 accelerationX = _mm256_set1_ps(forces.accelerationX);
+            __m256 accelerationY = _mm256_set1_ps(forces.accelerationY);
+
+            for (std::size_t j = 0; j < forces.attractorCount; ++j)
+            {
+                const float* attractor = forces.attractors + j * 3;
+                __m256 dx = _mm256_sub_ps(_mm256_set1_ps(attractor[0]), px);
+                __m256 dy = _mm256_sub_ps(_mm256_set1_ps(attractor[1]), py);
+                __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), one);
+                __m256 pull = _mm256_div_ps(_mm256_set1_ps(attractor[2]), _mm256_mul_ps(distance, _mm256_sqrt_ps(distance)));
+
+                accelerationX = _mm256_add_ps(accelerationX, _mm256_mul_ps(pull, dx));
+                accelerationY = _mm256_add_ps(accelerationY, _mm256_mul_ps(pull, dy));
+            }
+
+            __m256 vx = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(velocityX + i), _mm256_mul_ps(accelerationX, dt)), damping);
+            __m256 vy = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(velocityY + i), _mm256_mul_ps(accelerationY, dt)), damping);
+
+            _mm256_storeu_ps(velocityX + i, vx);
+            _mm256_storeu_ps(velocityY + i, vy);
+            _mm256_storeu_ps(x + i, _mm256_add_ps(px, _mm256_mul_ps(vx, dt)));
+            _mm256_storeu_ps(y + i, _mm256_add_ps(py, _mm256_mul_ps(vy, dt)));
+            _mm256_storeu_ps(life + i, _mm256_sub_ps(_mm256_loadu_ps(life + i), dt));
+        }
+
+        return i;
+    }
+
+    DSFML_TARGET_AVX2 std::size_t advanceAvx2(float* values, const float* rates, std::size_t begin, std::size_t end, float seconds)
+    {
+        const __m256 dt = _mm256_set1_ps(seconds);
+
+        std::size_t i = begin;
+        for (; i + 8 <= end; i += 8)
+            _mm256_storeu_ps(values + i, _mm256_add_ps(_mm256_loadu_ps(values + i), _mm256_mul_ps(_mm256_loadu_ps(rates + i), dt)));
+
+        return i;
+    }
+#endif
+
+
+#ifdef DSFML_PARTICLEKERNELS_NEON
+    ////////////////////////////////////////////////////////////
+    // NEON kernels, 4 particles at a time
+    ////////////////////////////////////////////////////////////
+
+    //Multiplications and additions are kept apart, vmlaq_f32 may be fused and round differently
+    std::size_t integrateNeon(float* x, float* y, float* velocityX, float* velocityY, float* life,
+                              std::size_t begin, std::size_t end, const particlekernels::Forces& forces, float seconds)
+    {
+        const float32x4_t dt = vdupq_n_f32(seconds);
+        const float32x4_t damping = vdupq_n_f32(forces.damping);
+        const float32x4_t one = vdupq_n_f32(1.f);
+
+        std::size_t i = begin;
+        for (; i + 4 <= end; i += 4)
+        {
+            float32x4_t px = vld1q_f32(x + i);
+            float32x4_t py = vld1q_f32(y + i);
+            float32x4_t accelerationX = vdupq_n_f32(forces.accelerationX);
+            float32x4_t accelerationY = vdupq_n_f32(forces.accelerationY);
+
+            for (std::size_t j = 0; j < forces.attractorCount; ++j)
+            {
+                const float* attractor = forces.attractors + j * 3;
+                float32x4_t dx = vsubq_f32(vdupq_n_f32(attractor[0]), px);
+                float32x4_t dy = vsubq_f32(vdupq_n_f32(attractor[1]), py);
+                float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), one);
+                float32x4_t pull = vdivq_f32(vdupq_n_f32(attractor[2]), vmulq_f32(distance, vsqrtq_f32(distance)));
+
+                accelerationX = vaddq_f32(accelerationX, vmulq_f32(pull, dx));
+                accelerationY = vaddq_f32(accelerationY, vmulq_f32(pull, dy));
+            }
+
+            float32x4_t vx = vmulq_f32(vaddq_f32(vld1q_f32(velocityX + i), vmulq_f32(accelerationX, dt)), damping);
+            float32x4_t vy = vmulq_f32(vaddq_f32(vld1q_f32(velocityY + i), vmulq_f32(accelerationY, dt)), damping);
+
+            vst1q_f32(velocityX + i, vx);
+            vst1q_f32(velocityY + i, vy);
+            vst1q_f32(x + i, vaddq_f32(px, vmulq_f32(vx, dt)));
+            vst1q_f32(y + i, vaddq_f32(py, vmulq_f32(vy, dt)));
+            vst1q_f32(life + i, vsubq_f32(vld1q_f32(life + i), dt));
+        }
+
+        return i;
+    }
+
+    std::size_t advanceNeon(float* values, const float* rates, std::size_t begin, std::size_t end, float seconds)
+    {
+        const float32x4_t dt = vdupq_n_f32(seconds);
+
+        std::size_t i = begin;
+        for (; i + 4 <= end; i += 4)
+            vst1q_f32(values + i, vaddq_f32(vld1q_f32(values + i), vmulq_f32(vld1q_f32(rates + i), dt)));
+
+        return i;
+    }
+#endif
+}
+
+namespace particlekernels
+{
+    void integrate(float* x, float* y, float* velocityX, float* velocityY, float* life,
+                   std::size_t begin, std::size_t end, const Forces& forces, float seconds)
+    {
+        std::size_t done = begin;
+
+        switch (pixelkernels::getInstructionSet())
+        {
+#ifdef DSFML_PARTICLEKERNELS_AVX2
+            case pixelkernels::Avx2: done = integrateAvx2(x, y, velocityX, velocityY, life, begin, end, forces, seconds); break;
+#endif
+#ifdef DSFML_PARTICLEKERNELS_SSE2
+            case pixelkernels::Sse2: done = integrateSse2(x, y, velocityX, velocityY, life, begin, end, forces, seconds); break;
+#endif
+#ifdef DSFML_PARTICLEKERNELS_NEON
+            case pixelkernels::Neon: done = integrateNeon(x, y, velocityX, velocityY, life, begin, end, forces, seconds); break;
+#endif
+            default: break;
+        }
+
+        integrateScalar(x, y, velocityX, velocityY, life, done, end, forces, seconds);
+    }
+
+    void advance(float* values, const float* rates, std::size_t begin, std::size_t end, float seconds)
+    {
+        std::size_t done = begin;
+
+        switch (pixelkernels::getInstructionSet())
+        {
+#ifdef DSFML_PARTICLEKERNELS_AVX2
+            case pixelkernels::Avx2: done = advanceAvx2(values, rates, begin, end, seconds); break;
+#endif
+#ifdef DSFML_PARTICLEKERNELS_SSE2
+            case pixelkernels::Sse2: done = advanceSse2(values, rates, begin, end, seconds); break;
+#endif
+#ifdef DSFML_PARTICLEKERNELS_NEON
+            case pixelkernels::Neon: done = advanceNeon(values, rates, begin, end, seconds); break;
+#endif
+            default: break;
+        }
+
+        advanceScalar(values, rates, done, end, seconds);
+    }
+
+    //AVX can't put a quad together any faster, the stores are what takes time
+    void writeQuads(const float* x, const float* y, const float* size, const float* const* color,
+                    const float* textureRect, std::size_t begin, std::size_t end, sf::Vertex* vertices)
+    {
+        switch (pixelkernels::getInstructionSet())
+        {
+#ifdef DSFML_PARTICLEKERNELS_SSE2
+            case pixelkernels::Avx2:
+            case pixelkernels::Sse2: begin = writeQuadsSse2(x, y, size, color, textureRect, begin, end, vertices); break;
+#endif
+            default: break;
+        }
+
+        writeQuadsScalar(x, y, size, color, textureRect, begin, end, vertices);
+    }
+}
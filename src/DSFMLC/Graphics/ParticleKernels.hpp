@@ -0,0 +1,68 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_PARTICLEKERNELS_HPP
+#define DSFML_PARTICLEKERNELS_HPP
+
+#include <SFML/Graphics/Vertex.hpp>
+#include <cstddef>
+
+//Particle updates over structure of arrays storage, vectorized with the instruction set chosen for the pixel kernels
+//
+//The vector kernels do the same operations in the same order as the scalar ones, so every instruction set gives
+//exactly the same particles.
+namespace particlekernels
+{
+    //Accelerations applied to every particle during a step
+    struct Forces
+    {
+        //Sum of the constant accelerations
+        float accelerationX;
+        float accelerationY;
+
+        //Factor the velocities are multiplied by after being accelerated
+        float damping;
+
+        //Attractors stored as x, y, strength, pulling with strength / distance² (softened by one unit)
+        const float* attractors;
+        std::size_t attractorCount;
+    };
+
+    //Accelerate, move and age particles in [begin, end), positions move with the new velocities
+    void integrate(float* x, float* y, float* velocityX, float* velocityY, float* life,
+                   std::size_t begin, std::size_t end, const Forces& forces, float seconds);
+
+    //Change values in [begin, end) by their rate of change per second
+    void advance(float* values, const float* rates, std::size_t begin, std::size_t end, float seconds);
+
+    //Write a quad centered on each particle in [begin, end), the quad of particle i starting at vertices[i * 4]
+    //and textured with a rectangle stored as left, top, width, height. Colors are red, green, blue, alpha arrays.
+    void writeQuads(const float* x, const float* y, const float* size, const float* const* color,
+                    const float* textureRect, std::size_t begin, std::size_t end, sf::Vertex* vertices);
+}
+
+#endif // DSFML_PARTICLEKERNELS_HPP
@@ -0,0 +1,471 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/ParticleSystem.h>
+#include <DSFMLC/Graphics/ParticleSystemStruct.h>
+#include <DSFMLC/Graphics/ParticleKernels.hpp>
+#include <DSFMLC/Graphics/Parallel.hpp>
+#include <DSFMLC/Graphics/VertexBufferStruct.h>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    //Particles handled at once, small enough for all their arrays to stay in the cache between kernels
+    const std::size_t chunkSize = 4096;
+
+    //Systems smaller than this are updated on the calling thread only
+    const std::size_t parallelThreshold = 8 * chunkSize;
+
+    enum AffectorType
+    {
+        Force,
+        Drag,
+        Attractor
+    };
+
+    //Random number in [0, 1)
+    float nextRandom(sfParticleSystem* particleSystem)
+    {
+        DUint& state = particleSystem->random;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        return (state >> 8) * (1.f / 16777216.f);
+    }
+
+    float between(sfParticleSystem* particleSystem, float minimum, float maximum)
+    {
+        return minimum + (maximum - minimum) * nextRandom(particleSystem);
+    }
+
+    //Run a function over chunks of particles, on the thread pool when the system is large enough, returning the number of threads used
+    template <typename Function>
+    unsigned int forEachChunk(sfParticleSystem* particleSystem, std::size_t count, Function function)
+    {
+        std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+        if (particleSystem->parallel && (count >= parallelThreshold))
+        {
+            parallel::ThreadPool& threadPool = parallel::getThreadPool();
+
+            threadPool.forEach(chunkCount, [&](std::size_t chunk)
+            {
+                function(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+            });
+
+            return static_cast<unsigned int>(threadPool.getThreadCount());
+        }
+
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+            function(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+
+        return 1;
+    }
+
+    //Create particles, returning how many fit in the system
+    std::size_t spawn(sfParticleSystem* particleSystem, const sfParticleEmitter& emitter, std::size_t count)
+    {
+        std::size_t first = particleSystem->particleCount;
+        count = std::min(count, particleSystem->maxParticleCount - first);
+        if (count == 0)
+            return 0;
+
+        //Arrays grow geometrically, and never shrink so that they can be reused as particles come and go
+        std::size_t needed = first + count;
+        if (particleSystem->fields[0].size() < needed)
+        {
+            std::size_t capacity = std::min(std::max(needed, particleSystem->fields[0].size() * 2), particleSystem->maxParticleCount);
+            for (int field = 0; field < sfParticleSystem::FieldCount; ++field)
+                particleSystem->fields[field].resize(capacity);
+        }
+
+        float* fields[sfParticleSystem::FieldCount];
+        for (int field = 0; field < sfParticleSystem::FieldCount; ++field)
+            fields[field] = &particleSystem->fields[field][0];
+
+        const float degreesToRadians = 3.141592654f / 180.f;
+
+        for (std::size_t i = first; i < needed; ++i)
+        {
+            float angle = between(particleSystem, emitter.minAngle, emitter.maxAngle) * degreesToRadians;
+            float speed = between(particleSystem, emitter.minSpeed, emitter.maxSpeed);
+            float lifetime = between(particleSystem, static_cast<float>(emitter.minLifetime), static_cast<float>(emitter.maxLifetime)) / 1000000.f;
+
+            //Particles without a lifetime die at the next update, without changing
+            float inverseLifetime = (lifetime > 0) ? 1.f / lifetime : 0.f;
+
+            fields[sfParticleSystem::X][i] = emitter.left + emitter.width * nextRandom(particleSystem);
+            fields[sfParticleSystem::Y][i] = emitter.top + emitter.height * nextRandom(particleSystem);
+            fields[sfParticleSystem::VelocityX][i] = std::cos(angle) * speed;
+            fields[sfParticleSystem::VelocityY][i] = std::sin(angle) * speed;
+            fields[sfParticleSystem::Life][i] = lifetime;
+            fields[sfParticleSystem::Size][i] = emitter.startSize;
+            fields[sfParticleSystem::SizeRate][i] = (emitter.endSize - emitter.startSize) * inverseLifetime;
+
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                fields[sfParticleSystem::Red + channel][i] = emitter.startColor[channel];
+                fields[sfParticleSystem::RedRate + channel][i] = (static_cast<float>(emitter.endColor[channel]) - emitter.startColor[channel]) * inverseLifetime;
+            }
+        }
+
+        particleSystem->particleCount = needed;
+        return count;
+    }
+
+    //Replace dead particles with the last ones, which doesn't keep the drawing order but only moves a few particles
+    std::size_t removeDead(sfParticleSystem* particleSystem)
+    {
+        std::size_t count = particleSystem->particleCount;
+        if (count == 0)
+            return 0;
+
+        const float* life = &particleSystem->fields[sfParticleSystem::Life][0];
+        std::size_t removed = 0;
+
+        for (std::size_t i = 0; i < count;)
+        {
+            if (life[i] > 0)
+            {
+                ++i;
+                continue;
+            }
+
+            --count;
+            ++removed;
+            for (int field = 0; field < sfParticleSystem::FieldCount; ++field)
+                particleSystem->fields[field][i] = particleSystem->fields[field][count];
+        }
+
+        particleSystem->particleCount = count;
+        return removed;
+    }
+
+    void writeQuads(sfParticleSystem* particleSystem, sf::Vertex* vertices)
+    {
+        const float* x = &particleSystem->fields[sfParticleSystem::X][0];
+        const float* y = &particleSystem->fields[sfParticleSystem::Y][0];
+        const float* size = &particleSystem->fields[sfParticleSystem::Size][0];
+        const float* color[4] = {&particleSystem->fields[sfParticleSystem::Red][0], &particleSystem->fields[sfParticleSystem::Green][0],
+                                 &particleSystem->fields[sfParticleSystem::Blue][0], &particleSystem->fields[sfParticleSystem::Alpha][0]};
+        const float* textureRect = particleSystem->textureRect;
+
+        forEachChunk(particleSystem, particleSystem->particleCount, [&](std::size_t begin, std::size_t end)
+        {
+            particlekernels::writeQuads(x, y, size, color, textureRect, begin, end, vertices);
+        });
+    }
+
+    DLong microsecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+sfParticleSystem* sfParticleSystem_construct(DUint maxParticleCount)
+{
+    sfParticleSystem* particleSystem = new sfParticleSystem;
+    particleSystem->maxParticleCount = maxParticleCount;
+
+    return particleSystem;
+}
+
+void sfParticleSystem_destroy(sfParticleSystem* particleSystem)
+{
+    delete particleSystem;
+}
+
+void sfParticleSystem_setTextureRect(sfParticleSystem* particleSystem, float left, float top, float width, float height)
+{
+    particleSystem->textureRect[0] = left;
+    particleSystem->textureRect[1] = top;
+    particleSystem->textureRect[2] = width;
+    particleSystem->textureRect[3] = height;
+}
+
+DUint sfParticleSystem_addEmitter(sfParticleSystem* particleSystem, const sfParticleEmitter* emitter)
+{
+    sfParticleEmitterState state;
+    state.id = particleSystem->nextId++;
+    state.settings = *emitter;
+    state.pending = 0;
+
+    particleSystem->emitters.push_back(state);
+    return state.id;
+}
+
+DBool sfParticleSystem_setEmitter(sfParticleSystem* particleSystem, DUint id, const sfParticleEmitter* emitter)
+{
+    for (std::size_t i = 0; i < particleSystem->emitters.size(); ++i)
+    {
+        if (particleSystem->emitters[i].id == id)
+        {
+            particleSystem->emitters[i].settings = *emitter;
+            return DTrue;
+        }
+    }
+
+    return DFalse;
+}
+
+DBool sfParticleSystem_removeEmitter(sfParticleSystem* particleSystem, DUint id)
+{
+    for (std::size_t i = 0; i < particleSystem->emitters.size(); ++i)
+    {
+        if (particleSystem->emitters[i].id == id)
+        {
+            particleSystem->emitters.erase(particleSystem->emitters.begin() + i);
+            return DTrue;
+        }
+    }
+
+    return DFalse;
+}
+
+DUint sfParticleSystem_emit(sfParticleSystem* particleSystem, const sfParticleEmitter* emitter, DUint count)
+{
+    return static_cast<DUint>(spawn(particleSystem, *emitter, count));
+}
+
+DUint sfParticleSystem_addAffector(sfParticleSystem* particleSystem, const sfParticleAffector* affector)
+{
+    if ((affector->type < Force) || (affector->type > Attractor))
+    {
+        sf::err() << "Failed to add particle affector: unknown affector type " << affector->type << std::endl;
+        return 0;
+    }
+
+    DUint id = particleSystem->nextId++;
+    particleSystem->affectors.push_back(std::make_pair(id, *affector));
+
+    return id;
+}
+
+DBool sfParticleSystem_setAffector(sfParticleSystem* particleSystem, DUint id, const sfParticleAffector* affector)
+{
+    if ((affector->type < Force) || (affector->type > Attractor))
+    {
+        sf::err() << "Failed to change particle affector: unknown affector type " << affector->type << std::endl;
+        return DFalse;
+    }
+
+    for (std::size_t i = 0; i < particleSystem->affectors.size(); ++i)
+    {
+        if (particleSystem->affectors[i].first == id)
+        {
+            particleSystem->affectors[i].second = *affector;
+            return DTrue;
+        }
+    }
+
+    return DFalse;
+}
+
+DBool sfParticleSystem_removeAffector(sfParticleSystem* particleSystem, DUint id)
+{
+    for (std::size_t i = 0; i < particleSystem->affectors.size(); ++i)
+    {
+        if (particleSystem->affectors[i].first == id)
+        {
+            particleSystem->affectors.erase(particleSystem->affectors.begin() + i);
+            return DTrue;
+        }
+    }
+
+    return DFalse;
+}
+
+void sfParticleSystem_setParallel(sfParticleSystem* particleSystem, DBool parallel)
+{
+    particleSystem->parallel = parallel == DTrue;
+}
+
+void sfParticleSystem_update(sfParticleSystem* particleSystem, DLong elapsed)
+{
+    //Time only goes forward, a negative step would make the emitters owe a negative number of particles
+    if (elapsed <= 0)
+    {
+        particleSystem->emittedCount = 0;
+        particleSystem->expiredCount = 0;
+        particleSystem->updateTime = 0;
+        return;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    float seconds = elapsed / 1000000.f;
+
+    //Affectors of the same kind are gathered so that the kernels go through the particles once
+    particlekernels::Forces forces;
+    forces.accelerationX = 0;
+    forces.accelerationY = 0;
+
+    float drag = 0;
+    std::vector<float> attractors;
+
+    for (std::size_t i = 0; i < particleSystem->affectors.size(); ++i)
+    {
+        const sfParticleAffector& affector = particleSystem->affectors[i].second;
+
+        switch (affector.type)
+        {
+            case Force:
+                forces.accelerationX += affector.x;
+                forces.accelerationY += affector.y;
+                break;
+            case Drag:
+                drag += affector.strength;
+                break;
+            default:
+                attractors.push_back(affector.x);
+                attractors.push_back(affector.y);
+                attractors.push_back(affector.strength);
+                break;
+        }
+    }
+
+    forces.damping = std::exp(-drag * seconds);
+    forces.attractors = attractors.empty() ? NULL : &attractors[0];
+    forces.attractorCount = attractors.size() / 3;
+
+    particleSystem->threadCount = 1;
+
+    if (particleSystem->particleCount > 0)
+    {
+        float* fields[sfParticleSystem::FieldCount];
+        for (int field = 0; field < sfParticleSystem::FieldCount; ++field)
+            fields[field] = &particleSystem->fields[field][0];
+
+        particleSystem->threadCount = forEachChunk(particleSystem, particleSystem->particleCount, [&](std::size_t begin, std::size_t end)
+        {
+            particlekernels::integrate(fields[sfParticleSystem::X], fields[sfParticleSystem::Y],
+                                       fields[sfParticleSystem::VelocityX], fields[sfParticleSystem::VelocityY],
+                                       fields[sfParticleSystem::Life], begin, end, forces, seconds);
+
+            for (int field = sfParticleSystem::Red; field <= sfParticleSystem::Size; ++field)
+                particlekernels::advance(fields[field], fields[field + sfParticleSystem::RedRate - sfParticleSystem::Red], begin, end, seconds);
+        });
+    }
+
+    particleSystem->expiredCount = static_cast<unsigned int>(removeDead(particleSystem));
+
+    //New particles start at the emitter and only move from the next update on
+    std::size_t emitted = 0;
+    for (std::size_t i = 0; i < particleSystem->emitters.size(); ++i)
+    {
+        sfParticleEmitterState& emitter = particleSystem->emitters[i];
+        emitter.pending += std::max(emitter.settings.rate, 0.f) * static_cast<double>(seconds);
+
+        std::size_t count = static_cast<std::size_t>(emitter.pending);
+        emitter.pending -= static_cast<double>(count);
+        emitted += spawn(particleSystem, emitter.settings, count);
+    }
+
+    particleSystem->emittedCount = static_cast<unsigned int>(emitted);
+    particleSystem->updateTime = microsecondsSince(start);
+}
+
+void sfParticleSystem_clear(sfParticleSystem* particleSystem)
+{
+    particleSystem->particleCount = 0;
+
+    for (std::size_t i = 0; i < particleSystem->emitters.size(); ++i)
+        particleSystem->emitters[i].pending = 0;
+}
+
+DUint sfParticleSystem_getParticleCount(const sfParticleSystem* particleSystem)
+{
+    return static_cast<DUint>(particleSystem->particleCount);
+}
+
+DUint sfParticleSystem_writeVertices(sfParticleSystem* particleSystem, sfVertexBuffer* vertexBuffer, DBool* uploaded)
+{
+    *uploaded = DFalse;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::size_t vertexCount = particleSystem->particleCount * 4;
+    if (vertexCount == 0)
+    {
+        particleSystem->vertexTime = 0;
+        return 0;
+    }
+
+    bool written = false;
+
+    //Writing straight into the buffer's memory saves copying the vertices again
+    if (vertexBuffer)
+    {
+        sf::Vertex* mapping = vertexBuffer->map(vertexCount);
+        if (mapping)
+        {
+            writeQuads(particleSystem, mapping);
+            written = vertexBuffer->unmap();
+        }
+    }
+
+    bool buffered = written;
+
+    if (!written)
+    {
+        particleSystem->vertices.resize(vertexCount);
+        writeQuads(particleSystem, &particleSystem->vertices[0]);
+
+        //Without mapping the buffer was never given any storage, and the caller draws the vertices itself if it still has none
+        if (vertexBuffer)
+        {
+            if (!vertexBuffer->buffer)
+                vertexBuffer->create(vertexCount);
+
+            buffered = vertexBuffer->update(&particleSystem->vertices[0], vertexCount, 0);
+        }
+    }
+
+    *uploaded = buffered ? DTrue : DFalse;
+
+    particleSystem->vertexTime = microsecondsSince(start);
+    return static_cast<DUint>(vertexCount);
+}
+
+const void* sfParticleSystem_getVertices(const sfParticleSystem* particleSystem)
+{
+    return particleSystem->vertices.empty() ? NULL : &particleSystem->vertices[0];
+}
+
+void sfParticleSystem_getStatistics(const sfParticleSystem* particleSystem, DUint* particleCount, DUint* emittedCount, DUint* expiredCount, DUint* threadCount, DLong* updateTime, DLong* vertexTime)
+{
+    *particleCount = static_cast<DUint>(particleSystem->particleCount);
+    *emittedCount = particleSystem->emittedCount;
+    *expiredCount = particleSystem->expiredCount;
+    *threadCount = particleSystem->threadCount;
+    *updateTime = particleSystem->updateTime;
+    *vertexTime = particleSystem->vertexTime;
+}
@@ -0,0 +1,125 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_PARTICLESYSTEM_H
+#define DSFML_PARTICLESYSTEM_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <DSFMLC/Graphics/Types.h>
+#include <stddef.h>
+
+//How an emitter creates particles
+typedef struct
+{
+    //Range of the lifetime of the particles, in microseconds
+    DLong minLifetime;
+    DLong maxLifetime;
+
+    //Area the particles appear in
+    float left;
+    float top;
+    float width;
+    float height;
+
+    //Particles created per second
+    float rate;
+
+    //Range of the direction of the particles, in degrees, and of their speed
+    float minAngle;
+    float maxAngle;
+    float minSpeed;
+    float maxSpeed;
+
+    //Color and size of the particles when they appear and when they die, blended in between
+    DUbyte startColor[4];
+    DUbyte endColor[4];
+    float startSize;
+    float endSize;
+} sfParticleEmitter;
+
+//How an affector changes the particles: 0 is a constant acceleration of x, y, 1 is a drag slowing the particles
+//by strength per second, 2 is an attractor at x, y pulling with strength / distance²
+typedef struct
+{
+    DInt type;
+    float x;
+    float y;
+    float strength;
+} sfParticleAffector;
+
+//Construct a new particle system holding at most maxParticleCount particles
+DSFML_GRAPHICS_API sfParticleSystem* sfParticleSystem_construct(DUint maxParticleCount);
+
+//Destroy an existing particle system
+DSFML_GRAPHICS_API void sfParticleSystem_destroy(sfParticleSystem* particleSystem);
+
+//Set the part of the texture drawn on each particle
+DSFML_GRAPHICS_API void sfParticleSystem_setTextureRect(sfParticleSystem* particleSystem, float left, float top, float width, float height);
+
+//Add an emitter, returning its id
+DSFML_GRAPHICS_API DUint sfParticleSystem_addEmitter(sfParticleSystem* particleSystem, const sfParticleEmitter* emitter);
+
+//Change an emitter
+DSFML_GRAPHICS_API DBool sfParticleSystem_setEmitter(sfParticleSystem* particleSystem, DUint id, const sfParticleEmitter* emitter);
+
+//Remove an emitter
+DSFML_GRAPHICS_API DBool sfParticleSystem_removeEmitter(sfParticleSystem* particleSystem, DUint id);
+
+//Create particles at once, returning how many were created before the system was full
+DSFML_GRAPHICS_API DUint sfParticleSystem_emit(sfParticleSystem* particleSystem, const sfParticleEmitter* emitter, DUint count);
+
+//Add an affector, returning its id
+DSFML_GRAPHICS_API DUint sfParticleSystem_addAffector(sfParticleSystem* particleSystem, const sfParticleAffector* affector);
+
+//Change an affector
+DSFML_GRAPHICS_API DBool sfParticleSystem_setAffector(sfParticleSystem* particleSystem, DUint id, const sfParticleAffector* affector);
+
+//Remove an affector
+DSFML_GRAPHICS_API DBool sfParticleSystem_removeAffector(sfParticleSystem* particleSystem, DUint id);
+
+//Set whether large systems are updated on several threads
+DSFML_GRAPHICS_API void sfParticleSystem_setParallel(sfParticleSystem* particleSystem, DBool parallel);
+
+//Move, age and remove particles, then let the emitters create new ones, over some microseconds
+DSFML_GRAPHICS_API void sfParticleSystem_update(sfParticleSystem* particleSystem, DLong elapsed);
+
+//Remove all the particles
+DSFML_GRAPHICS_API void sfParticleSystem_clear(sfParticleSystem* particleSystem);
+
+//Get the number of living particles
+DSFML_GRAPHICS_API DUint sfParticleSystem_getParticleCount(const sfParticleSystem* particleSystem);
+
+//Write a quad per particle into a vertex buffer, or only into the system's own vertices if it is NULL or can't be written, returning the number of vertices and whether the buffer holds them
+DSFML_GRAPHICS_API DUint sfParticleSystem_writeVertices(sfParticleSystem* particleSystem, sfVertexBuffer* vertexBuffer, DBool* uploaded);
+
+//Get the vertices written by the last call to writeVertices when they didn't go straight to a vertex buffer
+DSFML_GRAPHICS_API const void* sfParticleSystem_getVertices(const sfParticleSystem* particleSystem);
+
+//Get the number of particles, how many the last update created and removed and on how many threads, and how long updating and writing vertices took
+DSFML_GRAPHICS_API void sfParticleSystem_getStatistics(const sfParticleSystem* particleSystem, DUint* particleCount, DUint* emittedCount, DUint* expiredCount, DUint* threadCount, DLong* updateTime, DLong* vertexTime);
+
+#endif // DSFML_PARTICLESYSTEM_H
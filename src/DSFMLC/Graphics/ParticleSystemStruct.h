@@ -0,0 +1,112 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_PARTICLESYSTEMSTRUCT_H
+#define DSFML_PARTICLESYSTEMSTRUCT_H
+
+#include <DSFMLC/Config.h>
+#include <DSFMLC/Graphics/ParticleSystem.h>
+#include <SFML/Graphics/Vertex.hpp>
+#include <cstddef>
+#include <vector>
+
+//An emitter and the fraction of a particle it owes from previous updates
+struct sfParticleEmitterState
+{
+    DUint id;
+    sfParticleEmitter settings;
+    double pending;
+};
+
+//Internal structure of sfParticleSystem
+struct sfParticleSystem
+{
+    //Arrays holding each property of the particles
+    enum Field
+    {
+        X,
+        Y,
+        VelocityX,
+        VelocityY,
+        Life,
+        Red,
+        Green,
+        Blue,
+        Alpha,
+        Size,
+        RedRate,
+        GreenRate,
+        BlueRate,
+        AlphaRate,
+        SizeRate,
+        FieldCount
+    };
+
+    sfParticleSystem() :
+    particleCount(0),
+    maxParticleCount(0),
+    nextId(1),
+    random(0x9E3779B9u),
+    parallel(true),
+    emittedCount(0),
+    expiredCount(0),
+    threadCount(1),
+    updateTime(0),
+    vertexTime(0)
+    {
+        textureRect[0] = textureRect[1] = 0;
+        textureRect[2] = textureRect[3] = 1;
+    }
+
+    //Particles are stored as a structure of arrays, each array at least particleCount long
+    std::vector<float> fields[FieldCount];
+    std::size_t particleCount;
+    std::size_t maxParticleCount;
+
+    std::vector<sfParticleEmitterState> emitters;
+    std::vector<std::pair<DUint, sfParticleAffector> > affectors;
+    DUint nextId;
+
+    float textureRect[4];
+
+    //State of the xorshift generator the emitters use
+    DUint random;
+
+    //Large systems are updated on the shared thread pool
+    bool parallel;
+
+    //Vertices written when they can't go straight to a vertex buffer
+    std::vector<sf::Vertex> vertices;
+
+    unsigned int emittedCount;
+    unsigned int expiredCount;
+    unsigned int threadCount;
+    DLong updateTime;
+    DLong vertexTime;
+};
+
+#endif // DSFML_PARTICLESYSTEMSTRUCT_H
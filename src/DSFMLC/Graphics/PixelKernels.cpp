@@ -0,0 +1,880 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/PixelKernels.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define DSFML_PIXELKERNELS_SSE2
+    #include <emmintrin.h>
+
+    //AVX2 functions are compiled for it on their own and only called when the CPU reports it
+    #if defined(_MSC_VER)
+        #define DSFML_PIXELKERNELS_AVX2
+        #define DSFML_TARGET_AVX2
+        #include <immintrin.h>
+        #include <intrin.h>
+    #elif defined(__GNUC__)
+        #define DSFML_PIXELKERNELS_AVX2
+        #define DSFML_TARGET_AVX2 __attribute__((target("avx2")))
+        #include <immintrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define DSFML_PIXELKERNELS_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace
+{
+    bool cpuHasAvx2()
+    {
+#if defined(DSFML_PIXELKERNELS_AVX2) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        //The OS must also save the AVX registers
+        __cpuid(info, 1);
+        if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)) || ((_xgetbv(0) & 6) != 6))
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#elif defined(DSFML_PIXELKERNELS_AVX2)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#else
+        return false;
+#endif
+    }
+
+    pixelkernels::InstructionSet bestInstructionSet()
+    {
+        if (cpuHasAvx2())
+            return pixelkernels::Avx2;
+
+#if defined(DSFML_PIXELKERNELS_SSE2)
+        return pixelkernels::Sse2;
+#elif defined(DSFML_PIXELKERNELS_NEON)
+        return pixelkernels::Neon;
+#else
+        return pixelkernels::Scalar;
+#endif
+    }
+
+    std::atomic<int>& currentInstructionSet()
+    {
+        static std::atomic<int> instructionSet(bestInstructionSet());
+        return instructionSet;
+    }
+
+    inline sf::Uint32 loadPixel(const sf::Uint8* pixel)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, pixel, 4);
+        return value;
+    }
+
+    inline void storePixel(sf::Uint8* pixel, sf::Uint32 value)
+    {
+        std::memcpy(pixel, &value, 4);
+    }
+
+    //Exact x / 255 for x up to 255 * 255
+    inline unsigned int divide255(unsigned int x)
+    {
+        return (x + 1 + (x >> 8)) >> 8;
+    }
+
+    inline sf::Uint8 luma(int r, int g, int b)
+    {
+        return static_cast<sf::Uint8>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+    }
+
+    inline sf::Uint8 blueChroma(int r, int g, int b)
+    {
+        return static_cast<sf::Uint8>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+    }
+
+    inline sf::Uint8 redChroma(int r, int g, int b)
+    {
+        return static_cast<sf::Uint8>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Scalar kernels, also used for the pixels left over by the vector loops
+    ////////////////////////////////////////////////////////////
+
+    void fillScalar(sf::Uint8* pixels, std::size_t begin, std::size_t count, sf::Uint32 color)
+    {
+        for (std::size_t i = begin; i < count; ++i)
+            storePixel(pixels + i * 4, color);
+    }
+
+    void maskScalar(sf::Uint8* pixels, std::size_t begin, std::size_t count, sf::Uint32 color, sf::Uint8 alpha)
+    {
+        for (std::size_t i = begin; i < count; ++i)
+        {
+            if (loadPixel(pixels + i * 4) == color)
+                pixels[i * 4 + 3] = alpha;
+        }
+    }
+
+    void mirrorScalar(sf::Uint8* row, std::size_t left, std::size_t right)
+    {
+        for (; left + 1 < right; ++left, --right)
+        {
+            sf::Uint32 first = loadPixel(row + left * 4);
+            storePixel(row + left * 4, loadPixel(row + (right - 1) * 4));
+            storePixel(row + (right - 1) * 4, first);
+        }
+    }
+
+    void blendScalar(const sf::Uint8* source, sf::Uint8* destination, std::size_t begin, std::size_t count)
+    {
+        for (std::size_t i = begin; i < count; ++i)
+        {
+            const sf::Uint8* src = source + i * 4;
+            sf::Uint8* dst = destination + i * 4;
+            unsigned int alpha = src[3];
+
+            dst[0] = static_cast<sf::Uint8>(divide255(src[0] * alpha + dst[0] * (255 - alpha)));
+            dst[1] = static_cast<sf::Uint8>(divide255(src[1] * alpha + dst[1] * (255 - alpha)));
+            dst[2] = static_cast<sf::Uint8>(divide255(src[2] * alpha + dst[2] * (255 - alpha)));
+            dst[3] = static_cast<sf::Uint8>(alpha + divide255(dst[3] * (255 - alpha)));
+        }
+    }
+
+    void premultiplyScalar(sf::Uint8* pixels, std::size_t begin, std::size_t count)
+    {
+        for (std::size_t i = begin; i < count; ++i)
+        {
+            sf::Uint8* pixel = pixels + i * 4;
+            unsigned int alpha = pixel[3];
+
+            pixel[0] = static_cast<sf::Uint8>(divide255(pixel[0] * alpha));
+            pixel[1] = static_cast<sf::Uint8>(divide255(pixel[1] * alpha));
+            pixel[2] = static_cast<sf::Uint8>(divide255(pixel[2] * alpha));
+        }
+    }
+
+    void swizzleScalar(sf::Uint8* pixels, std::size_t begin, std::size_t count, const unsigned int* order)
+    {
+        for (std::size_t i = begin; i < count; ++i)
+        {
+            sf::Uint8* pixel = pixels + i * 4;
+            sf::Uint8 original[4] = {pixel[0], pixel[1], pixel[2], pixel[3]};
+
+            for (int channel = 0; channel < 4; ++channel)
+                pixel[channel] = original[order[channel]];
+        }
+    }
+
+#ifdef DSFML_PIXELKERNELS_SSE2
+    ////////////////////////////////////////////////////////////
+    // SSE2 kernels, 4 pixels at a time
+    ////////////////////////////////////////////////////////////
+
+    std::size_t fillSse2(sf::Uint8* pixels, std::size_t count, sf::Uint32 color)
+    {
+        const __m128i value = _mm_set1_epi32(static_cast<int>(color));
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), value);
+
+        return i;
+    }
+
+    std::size_t maskSse2(sf::Uint8* pixels, std::size_t count, sf::Uint32 color, sf::Uint8 alpha)
+    {
+        const __m128i key = _mm_set1_epi32(static_cast<int>(color));
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m128i alphaValue = _mm_set1_epi32(static_cast<int>(static_cast<sf::Uint32>(alpha) << 24));
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+            __m128i matches = _mm_cmpeq_epi32(block, key);
+
+            block = _mm_or_si128(_mm_andnot_si128(_mm_and_si128(matches, alphaMask), block), _mm_and_si128(matches, alphaValue));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), block);
+        }
+
+        return i;
+    }
+
+    void mirrorSse2(sf::Uint8* row, std::size_t width)
+    {
+        std::size_t left = 0;
+        std::size_t right = width;
+
+        for (; right - left >= 8; left += 4, right -= 4)
+        {
+            __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + left * 4));
+            __m128i last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + (right - 4) * 4));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + left * 4), _mm_shuffle_epi32(last, _MM_SHUFFLE(0, 1, 2, 3)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + (right - 4) * 4), _mm_shuffle_epi32(first, _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+
+        mirrorScalar(row, left, right);
+    }
+
+    //Blend 2 pixels widened to 16 bits, the alpha lane of the source is forced to 255 so the same sum gives the new alpha
+    inline __m128i blendPairSse2(__m128i source, __m128i destination)
+    {
+        const __m128i full = _mm_set1_epi16(255);
+        const __m128i alphaLanes = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+
+        __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(source, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i sum = _mm_add_epi16(_mm_mullo_epi16(_mm_or_si128(source, alphaLanes), alpha),
+                                    _mm_mullo_epi16(destination, _mm_sub_epi16(full, alpha)));
+
+        return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(sum, _mm_set1_epi16(1)), _mm_srli_epi16(sum, 8)), 8);
+    }
+
+    std::size_t blendSse2(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+            __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * 4));
+
+            __m128i low = blendPairSse2(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+            __m128i high = blendPairSse2(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(low, high));
+        }
+
+        return i;
+    }
+
+    //Premultiply 2 pixels widened to 16 bits, the alpha lane is multiplied by 255 to keep it
+    inline __m128i premultiplyPairSse2(__m128i pixels)
+    {
+        const __m128i colorLanes = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+        const __m128i alphaLanes = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+
+        __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i product = _mm_mullo_epi16(pixels, _mm_or_si128(_mm_and_si128(alpha, colorLanes), alphaLanes));
+
+        return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(product, _mm_set1_epi16(1)), _mm_srli_epi16(product, 8)), 8);
+    }
+
+    std::size_t premultiplySse2(sf::Uint8* pixels, std::size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+
+            __m128i low = premultiplyPairSse2(_mm_unpacklo_epi8(block, zero));
+            __m128i high = premultiplyPairSse2(_mm_unpackhi_epi8(block, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), _mm_packus_epi16(low, high));
+        }
+
+        return i;
+    }
+
+    //SSE2 has no byte shuffle, so each channel is shifted from its source position to its destination
+    std::size_t swizzleSse2(sf::Uint8* pixels, std::size_t count, const unsigned int* order)
+    {
+        const __m128i channelMask = _mm_set1_epi32(0xFF);
+        __m128i sourceShifts[4];
+        __m128i destinationShifts[4];
+
+        for (int channel = 0; channel < 4; ++channel)
+        {
+            sourceShifts[channel] = _mm_cvtsi32_si128(static_cast<int>(order[channel] * 8));
+            destinationShifts[channel] = _mm_cvtsi32_si128(channel * 8);
+        }
+
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+            __m128i result = _mm_setzero_si128();
+
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                __m128i value = _mm_and_si128(_mm_srl_epi32(block, sourceShifts[channel]), channelMask);
+                result = _mm_or_si128(result, _mm_sll_epi32(value, destinationShifts[channel]));
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), result);
+        }
+
+        return i;
+    }
+
+    //Weighted sums of the color channels of 4 pixels, as 32 bits integers
+    inline __m128i weigh(__m128i pixels, __m128i weights)
+    {
+        __m128i zero = _mm_setzero_si128();
+        __m128i low = _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), weights);
+        __m128i high = _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), weights);
+
+        //Each pixel gave two partial sums, r + g and b + a
+        __m128 first = _mm_shuffle_ps(_mm_castsi128_ps(low), _mm_castsi128_ps(high), _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 second = _mm_shuffle_ps(_mm_castsi128_ps(low), _mm_castsi128_ps(high), _MM_SHUFFLE(3, 1, 3, 1));
+
+        return _mm_add_epi32(_mm_castps_si128(first), _mm_castps_si128(second));
+    }
+#endif
+
+#ifdef DSFML_PIXELKERNELS_AVX2
+    ////////////////////////////////////////////////////////////
+    // AVX2 kernels, 8 pixels at a time
+    ////////////////////////////////////////////////////////////
+
+    DSFML_TARGET_AVX2 std::size_t fillAvx2(sf::Uint8* pixels, std::size_t count, sf::Uint32 color)
+    {
+        const __m256i value = _mm256_set1_epi32(static_cast<int>(color));
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * 4), value);
+
+        return i;
+    }
+
+    DSFML_TARGET_AVX2 std::size_t maskAvx2(sf::Uint8* pixels, std::size_t count, sf::Uint32 color, sf::Uint8 alpha)
+    {
+        const __m256i key = _mm256_set1_epi32(static_cast<int>(color));
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m256i alphaValue = _mm256_set1_epi32(static_cast<int>(static_cast<sf::Uint32>(alpha) << 24));
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i * 4));
+            __m256i matches = _mm256_cmpeq_epi32(block, key);
+
+            block = _mm256_or_si256(_mm256_andnot_si256(_mm256_and_si256(matches, alphaMask), block), _mm256_and_si256(matches, alphaValue));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * 4), block);
+        }
+
+        return i;
+    }
+
+    DSFML_TARGET_AVX2 void mirrorAvx2(sf::Uint8* row, std::size_t width)
+    {
+        const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        std::size_t left = 0;
+        std::size_t right = width;
+
+        for (; right - left >= 16; left += 8, right -= 8)
+        {
+            __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + left * 4));
+            __m256i last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + (right - 8) * 4));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + left * 4), _mm256_permutevar8x32_epi32(last, reverse));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + (right - 8) * 4), _mm256_permutevar8x32_epi32(first, reverse));
+        }
+
+        mirrorScalar(row, left, right);
+    }
+
+    DSFML_TARGET_AVX2 inline __m256i blendPairAvx2(__m256i source, __m256i destination)
+    {
+        const __m256i full = _mm256_set1_epi16(255);
+        const __m256i alphaLanes = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+
+        __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(source, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_or_si256(source, alphaLanes), alpha),
+                                       _mm256_mullo_epi16(destination, _mm256_sub_epi16(full, alpha)));
+
+        return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(1)), _mm256_srli_epi16(sum, 8)), 8);
+    }
+
+    //The unpacks and the pack work within 128 bits lanes, so they restore the pixel order together
+    DSFML_TARGET_AVX2 std::size_t blendAvx2(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4));
+            __m256i dst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i * 4));
+
+            __m256i low = blendPairAvx2(_mm256_unpacklo_epi8(src, zero), _mm256_unpacklo_epi8(dst, zero));
+            __m256i high = blendPairAvx2(_mm256_unpackhi_epi8(src, zero), _mm256_unpackhi_epi8(dst, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), _mm256_packus_epi16(low, high));
+        }
+
+        return i;
+    }
+
+    DSFML_TARGET_AVX2 inline __m256i premultiplyPairAvx2(__m256i pixels)
+    {
+        const __m256i colorLanes = _mm256_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0);
+        const __m256i alphaLanes = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+
+        __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m256i product = _mm256_mullo_epi16(pixels, _mm256_or_si256(_mm256_and_si256(alpha, colorLanes), alphaLanes));
+
+        return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(product, _mm256_set1_epi16(1)), _mm256_srli_epi16(product, 8)), 8);
+    }
+
+    DSFML_TARGET_AVX2 std::size_t premultiplyAvx2(sf::Uint8* pixels, std::size_t count)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i * 4));
+
+            __m256i low = premultiplyPairAvx2(_mm256_unpacklo_epi8(block, zero));
+            __m256i high = premultiplyPairAvx2(_mm256_unpackhi_epi8(block, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * 4), _mm256_packus_epi16(low, high));
+        }
+
+        return i;
+    }
+
+    DSFML_TARGET_AVX2 std::size_t swizzleAvx2(sf::Uint8* pixels, std::size_t count, const unsigned int* order)
+    {
+        //The byte shuffle indexes within each 128 bits lane, so both lanes use the same pattern
+        alignas(32) sf::Uint8 pattern[32];
+        for (int byte = 0; byte < 32; ++byte)
+            pattern[byte] = static_cast<sf::Uint8>((byte % 16) / 4 * 4 + order[byte % 4]);
+
+        const __m256i shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(pattern));
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i * 4));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * 4), _mm256_shuffle_epi8(block, shuffle));
+        }
+
+        return i;
+    }
+#endif
+
+#ifdef DSFML_PIXELKERNELS_NEON
+    ////////////////////////////////////////////////////////////
+    // NEON kernels, with the channels split into their own registers by the interleaved loads
+    ////////////////////////////////////////////////////////////
+
+    std::size_t fillNeon(sf::Uint8* pixels, std::size_t count, sf::Uint32 color)
+    {
+        const uint8x16_t value = vreinterpretq_u8_u32(vdupq_n_u32(color));
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+            vst1q_u8(pixels + i * 4, value);
+
+        return i;
+    }
+
+    std::size_t maskNeon(sf::Uint8* pixels, std::size_t count, sf::Uint32 color, sf::Uint8 alpha)
+    {
+        const uint32x4_t key = vdupq_n_u32(color);
+        const uint32x4_t colorMask = vdupq_n_u32(0x00FFFFFFu);
+        const uint32x4_t alphaValue = vdupq_n_u32(static_cast<sf::Uint32>(alpha) << 24);
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32x4_t block = vreinterpretq_u32_u8(vld1q_u8(pixels + i * 4));
+            uint32x4_t masked = vorrq_u32(vandq_u32(block, colorMask), alphaValue);
+
+            block = vbslq_u32(vceqq_u32(block, key), masked, block);
+            vst1q_u8(pixels + i * 4, vreinterpretq_u8_u32(block));
+        }
+
+        return i;
+    }
+
+    void mirrorNeon(sf::Uint8* row, std::size_t width)
+    {
+        std::size_t left = 0;
+        std::size_t right = width;
+
+        for (; right - left >= 8; left += 4, right -= 4)
+        {
+            uint32x4_t first = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(row + left * 4)));
+            uint32x4_t last = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(row + (right - 4) * 4)));
+
+            vst1q_u8(row + left * 4, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(last), vget_low_u32(last))));
+            vst1q_u8(row + (right - 4) * 4, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(first), vget_low_u32(first))));
+        }
+
+        mirrorScalar(row, left, right);
+    }
+
+    inline uint8x8_t divide255Neon(uint16x8_t x)
+    {
+        return vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+    }
+
+    std::size_t blendNeon(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        const uint8x8_t full = vdup_n_u8(255);
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t src = vld4_u8(source + i * 4);
+            uint8x8x4_t dst = vld4_u8(destination + i * 4);
+            uint8x8_t inverse = vsub_u8(full, src.val[3]);
+
+            for (int channel = 0; channel < 3; ++channel)
+                dst.val[channel] = divide255Neon(vmlal_u8(vmull_u8(src.val[channel], src.val[3]), dst.val[channel], inverse));
+
+            dst.val[3] = vadd_u8(src.val[3], divide255Neon(vmull_u8(dst.val[3], inverse)));
+            vst4_u8(destination + i * 4, dst);
+        }
+
+        return i;
+    }
+
+    std::size_t premultiplyNeon(sf::Uint8* pixels, std::size_t count)
+    {
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            uint8x8x4_t block = vld4_u8(pixels + i * 4);
+
+            for (int channel = 0; channel < 3; ++channel)
+                block.val[channel] = divide255Neon(vmull_u8(block.val[channel], block.val[3]));
+
+            vst4_u8(pixels + i * 4, block);
+        }
+
+        return i;
+    }
+
+    std::size_t swizzleNeon(sf::Uint8* pixels, std::size_t count, const unsigned int* order)
+    {
+        std::size_t i = 0;
+
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x4_t block = vld4q_u8(pixels + i * 4);
+            uint8x16x4_t result;
+
+            for (int channel = 0; channel < 4; ++channel)
+                result.val[channel] = block.val[order[channel]];
+
+            vst4q_u8(pixels + i * 4, result);
+        }
+
+        return i;
+    }
+#endif
+
+    void lumaRow(const sf::Uint8* rgba, unsigned int width, sf::Uint8* y, bool vectorized)
+    {
+        unsigned int x = 0;
+
+#ifdef DSFML_PIXELKERNELS_SSE2
+        const __m128i weights = _mm_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0);
+        const __m128i rounding = _mm_set1_epi32(128);
+        const __m128i offset = _mm_set1_epi16(16);
+
+        for (; vectorized && (x + 16 <= width); x += 16)
+        {
+            const sf::Uint8* pixels = rgba + x * 4;
+            __m128i sums[4];
+
+            for (int i = 0; i < 4; ++i)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 16));
+                sums[i] = _mm_srai_epi32(_mm_add_epi32(weigh(block, weights), rounding), 8);
+            }
+
+            __m128i low = _mm_add_epi16(_mm_packs_epi32(sums[0], sums[1]), offset);
+            __m128i high = _mm_add_epi16(_mm_packs_epi32(sums[2], sums[3]), offset);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(y + x), _mm_packus_epi16(low, high));
+        }
+#else
+        (void)vectorized;
+#endif
+
+        for (; x < width; ++x)
+            y[x] = luma(rgba[x * 4], rgba[x * 4 + 1], rgba[x * 4 + 2]);
+    }
+
+    void averageRows(const sf::Uint8* first, const sf::Uint8* second, std::size_t size, sf::Uint8* result, bool vectorized)
+    {
+        std::size_t i = 0;
+
+#ifdef DSFML_PIXELKERNELS_SSE2
+        for (; vectorized && (i + 16 <= size); i += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), _mm_avg_epu8(a, b));
+        }
+#else
+        (void)vectorized;
+#endif
+
+        for (; i < size; ++i)
+            result[i] = static_cast<sf::Uint8>((first[i] + second[i] + 1) >> 1);
+    }
+}
+
+namespace pixelkernels
+{
+    bool isSupported(InstructionSet instructionSet)
+    {
+        switch (instructionSet)
+        {
+            case Scalar:
+                return true;
+#ifdef DSFML_PIXELKERNELS_SSE2
+            case Sse2:
+                return true;
+#endif
+#ifdef DSFML_PIXELKERNELS_AVX2
+            case Avx2:
+                return cpuHasAvx2();
+#endif
+#ifdef DSFML_PIXELKERNELS_NEON
+            case Neon:
+                return true;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    InstructionSet getInstructionSet()
+    {
+        return static_cast<InstructionSet>(currentInstructionSet().load());
+    }
+
+    bool setInstructionSet(InstructionSet instructionSet)
+    {
+        if (!isSupported(instructionSet))
+            return false;
+
+        currentInstructionSet() = instructionSet;
+        return true;
+    }
+
+    void fill(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color)
+    {
+        sf::Uint32 value = loadPixel(color);
+        std::size_t done = 0;
+
+        switch (getInstructionSet())
+        {
+#ifdef DSFML_PIXELKERNELS_AVX2
+            case Avx2: done = fillAvx2(pixels, count, value); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_SSE2
+            case Sse2: done = fillSse2(pixels, count, value); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_NEON
+            case Neon: done = fillNeon(pixels, count, value); break;
+#endif
+            default: break;
+        }
+
+        fillScalar(pixels, done, count, value);
+    }
+
+    void maskFromColor(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color, sf::Uint8 alpha)
+    {
+        sf::Uint32 value = loadPixel(color);
+        std::size_t done = 0;
+
+        switch (getInstructionSet())
+        {
+#ifdef DSFML_PIXELKERNELS_AVX2
+            case Avx2: done = maskAvx2(pixels, count, value, alpha); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_SSE2
+            case Sse2: done = maskSse2(pixels, count, value, alpha); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_NEON
+            case Neon: done = maskNeon(pixels, count, value, alpha); break;
+#endif
+            default: break;
+        }
+
+        maskScalar(pixels, done, count, value, alpha);
+    }
+
+    void flipHorizontally(sf::Uint8* pixels, unsigned int width, unsigned int height)
+    {
+        InstructionSet instructionSet = getInstructionSet();
+
+        for (unsigned int row = 0; row < height; ++row)
+        {
+            sf::Uint8* line = pixels + static_cast<std::size_t>(width) * 4 * row;
+
+            switch (instructionSet)
+            {
+#ifdef DSFML_PIXELKERNELS_AVX2
+                case Avx2: mirrorAvx2(line, width); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_SSE2
+                case Sse2: mirrorSse2(line, width); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_NEON
+                case Neon: mirrorNeon(line, width); break;
+#endif
+                default: mirrorScalar(line, 0, width); break;
+            }
+        }
+    }
+
+    //Whole rows are swapped through a buffer, memcpy is already as wide as the CPU allows
+    void flipVertically(sf::Uint8* pixels, unsigned int width, unsigned int height)
+    {
+        std::size_t stride = static_cast<std::size_t>(width) * 4;
+        std::vector<sf::Uint8> buffer(stride);
+
+        for (unsigned int row = 0; row < height / 2; ++row)
+        {
+            sf::Uint8* top = pixels + stride * row;
+            sf::Uint8* bottom = pixels + stride * (height - 1 - row);
+
+            std::memcpy(&buffer[0], top, stride);
+            std::memcpy(top, bottom, stride);
+            std::memcpy(bottom, &buffer[0], stride);
+        }
+    }
+
+    void blend(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        std::size_t done = 0;
+
+        switch (getInstructionSet())
+        {
+#ifdef DSFML_PIXELKERNELS_AVX2
+            case Avx2: done = blendAvx2(source, destination, count); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_SSE2
+            case Sse2: done = blendSse2(source, destination, count); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_NEON
+            case Neon: done = blendNeon(source, destination, count); break;
+#endif
+            default: break;
+        }
+
+        blendScalar(source, destination, done, count);
+    }
+
+    void premultiply(sf::Uint8* pixels, std::size_t count)
+    {
+        std::size_t done = 0;
+
+        switch (getInstructionSet())
+        {
+#ifdef DSFML_PIXELKERNELS_AVX2
+            case Avx2: done = premultiplyAvx2(pixels, count); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_SSE2
+            case Sse2: done = premultiplySse2(pixels, count); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_NEON
+            case Neon: done = premultiplyNeon(pixels, count); break;
+#endif
+            default: break;
+        }
+
+        premultiplyScalar(pixels, done, count);
+    }
+
+    void swizzle(sf::Uint8* pixels, std::size_t count, const unsigned int* order)
+    {
+        std::size_t done = 0;
+
+        switch (getInstructionSet())
+        {
+#ifdef DSFML_PIXELKERNELS_AVX2
+            case Avx2: done = swizzleAvx2(pixels, count, order); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_SSE2
+            case Sse2: done = swizzleSse2(pixels, count, order); break;
+#endif
+#ifdef DSFML_PIXELKERNELS_NEON
+            case Neon: done = swizzleNeon(pixels, count, order); break;
+#endif
+            default: break;
+        }
+
+        swizzleScalar(pixels, done, count, order);
+    }
+
+    void rgbaToYuv420(const sf::Uint8* rgba, unsigned int width, unsigned int height, sf::Uint8* y, sf::Uint8* u, sf::Uint8* v)
+    {
+        std::size_t stride = static_cast<std::size_t>(width) * 4;
+        bool vectorized = getInstructionSet() != Scalar;
+
+        for (unsigned int row = 0; row < height; ++row)
+            lumaRow(rgba + stride * row, width, y + static_cast<std::size_t>(width) * row, vectorized);
+
+        //Chroma is taken from the average of each 2x2 block, repeating the last row and column for odd sizes
+        unsigned int chromaWidth = (width + 1) / 2;
+        std::vector<sf::Uint8> average(stride);
+
+        for (unsigned int row = 0; row < (height + 1) / 2; ++row)
+        {
+            const sf::Uint8* first = rgba + stride * (row * 2);
+            const sf::Uint8* second = rgba + stride * std::min(row * 2 + 1, height - 1);
+            averageRows(first, second, stride, &average[0], vectorized);
+
+            sf::Uint8* uRow = u + static_cast<std::size_t>(chromaWidth) * row;
+            sf::Uint8* vRow = v + static_cast<std::size_t>(chromaWidth) * row;
+
+            for (unsigned int column = 0; column < chromaWidth; ++column)
+            {
+                const sf::Uint8* left = &average[column * 8];
+                const sf::Uint8* right = &average[std::min(column * 2 + 1, width - 1) * 4];
+
+                int r = (left[0] + right[0] + 1) >> 1;
+                int g = (left[1] + right[1] + 1) >> 1;
+                int b = (left[2] + right[2] + 1) >> 1;
+
+                uRow[column] = blueChroma(r, g, b);
+                vRow[column] = redChroma(r, g, b);
+            }
+        }
+    }
+}
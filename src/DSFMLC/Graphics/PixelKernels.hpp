@@ -0,0 +1,80 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_PIXELKERNELS_HPP
+#define DSFML_PIXELKERNELS_HPP
+
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+//Conversions and filters over arrays of RGBA pixels, vectorized where the CPU allows it
+namespace pixelkernels
+{
+    //Vector instruction sets the kernels can use
+    enum InstructionSet
+    {
+        Scalar,
+        Sse2,
+        Avx2,
+        Neon
+    };
+
+    //Tell whether the kernels were built for an instruction set and the CPU runs it
+    bool isSupported(InstructionSet instructionSet);
+
+    //Get the instruction set the kernels currently use, the best supported one unless it was changed
+    InstructionSet getInstructionSet();
+
+    //Make the kernels use another instruction set, returning false if it isn't supported
+    bool setInstructionSet(InstructionSet instructionSet);
+
+    //Set every pixel to a color
+    void fill(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color);
+
+    //Set the alpha of the pixels exactly matching a color
+    void maskFromColor(sf::Uint8* pixels, std::size_t count, const sf::Uint8* color, sf::Uint8 alpha);
+
+    //Mirror each row of an image
+    void flipHorizontally(sf::Uint8* pixels, unsigned int width, unsigned int height);
+
+    //Swap the rows of an image top to bottom
+    void flipVertically(sf::Uint8* pixels, unsigned int width, unsigned int height);
+
+    //Draw pixels over others using the source alpha, with the same rounding as sf::Image::copy
+    void blend(const sf::Uint8* source, sf::Uint8* destination, std::size_t count);
+
+    //Multiply the color channels of pixels by their alpha
+    void premultiply(sf::Uint8* pixels, std::size_t count);
+
+    //Reorder the channels of pixels, channel i of the result is channel order[i] of the original
+    void swizzle(sf::Uint8* pixels, std::size_t count, const unsigned int* order);
+
+    //Convert RGBA pixels to planar YUV 4:2:0 with BT.601 coefficients, the chroma planes are (width + 1) / 2 pixels wide
+    void rgbaToYuv420(const sf::Uint8* rgba, unsigned int width, unsigned int height, sf::Uint8* y, sf::Uint8* u, sf::Uint8* v);
+}
+
+#endif // DSFML_PIXELKERNELS_HPP
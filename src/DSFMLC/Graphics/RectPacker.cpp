@@ -0,0 +1,570 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/RectPacker.hpp>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    using rectpacker::Placement;
+    using rectpacker::Result;
+
+    struct Rect
+    {
+        unsigned int x;
+        unsigned int y;
+        unsigned int width;
+        unsigned int height;
+    };
+
+    //Heuristics used to choose where the next rectangle goes
+    enum Heuristic
+    {
+        BestShortSideFit,
+        BestAreaFit,
+        BottomLeft,
+        MinWaste
+    };
+
+    //Orders in which rectangles are inserted, largest first
+    enum SortOrder
+    {
+        ByArea,
+        ByLongestSide,
+        ByHeight
+    };
+
+    struct Candidate
+    {
+        int algorithm;
+        Heuristic heuristic;
+        SortOrder order;
+    };
+
+    class Bin
+    {
+    public:
+        Bin(unsigned int width, unsigned int height) :
+        m_width(width),
+        m_height(height),
+        m_usedWidth(0),
+        m_usedHeight(0)
+        {
+        }
+
+        virtual ~Bin()
+        {
+        }
+
+        //Find room for a rectangle, returns false if it doesn't fit
+        virtual bool insert(unsigned int width, unsigned int height, bool allowRotation, Placement& placement) = 0;
+
+        sf::Vector2u getUsedSize() const
+        {
+            return sf::Vector2u(m_usedWidth, m_usedHeight);
+        }
+
+    protected:
+        void use(const Rect& rect)
+        {
+            m_usedWidth = std::max(m_usedWidth, rect.x + rect.width);
+            m_usedHeight = std::max(m_usedHeight, rect.y + rect.height);
+        }
+
+        unsigned int m_width;
+        unsigned int m_height;
+        unsigned int m_usedWidth;
+        unsigned int m_usedHeight;
+    };
+
+    //Keeps every maximal free rectangle of the bin, which makes for very tight packing
+    class MaxRectsBin : public Bin
+    {
+    public:
+        MaxRectsBin(unsigned int width, unsigned int height, Heuristic heuristic) :
+        Bin(width, height),
+        m_heuristic(heuristic)
+        {
+            Rect all = {0, 0, width, height};
+            m_free.push_back(all);
+        }
+
+        bool insert(unsigned int width, unsigned int height, bool allowRotation, Placement& placement)
+        {
+            Rect best = {0, 0, 0, 0};
+            bool found = false;
+            bool bestRotated = false;
+            unsigned long bestPrimary = std::numeric_limits<unsigned long>::max();
+            unsigned long bestSecondary = std::numeric_limits<unsigned long>::max();
+
+            for (std::size_t i = 0; i < m_free.size(); ++i)
+            {
+                for (int rotation = 0; rotation < (allowRotation ? 2 : 1); ++rotation)
+                {
+                    unsigned int w = rotation ? height : width;
+                    unsigned int h = rotation ? width : height;
+                    const Rect& free = m_free[i];
+
+                    if ((w > free.width) || (h > free.height))
+                        continue;
+
+                    unsigned long primary, secondary;
+                    score(free, w, h, primary, secondary);
+
+                    if ((primary < bestPrimary) || ((primary == bestPrimary) && (secondary < bestSecondary)))
+                    {
+                        Rect rect = {free.x, free.y, w, h};
+                        best = rect;
+                        bestRotated = rotation != 0;
+                        bestPrimary = primary;
+                        bestSecondary = secondary;
+                        found = true;
+                    }
+                }
+            }
+
+            if (!found)
+                return false;
+
+            place(best);
+
+            placement.x = best.x;
+            placement.y = best.y;
+            placement.rotated = bestRotated;
+
+            return true;
+        }
+
+    private:
+        void score(const Rect& free, unsigned int w, unsigned int h, unsigned long& primary, unsigned long& secondary) const
+        {
+            unsigned long leftoverX = free.width - w;
+            unsigned long leftoverY = free.height - h;
+
+            switch (m_heuristic)
+            {
+                case BestAreaFit:
+                    primary = static_cast<unsigned long>(free.width) * free.height - static_cast<unsigned long>(w) * h;
+                    secondary = std::min(leftoverX, leftoverY);
+                    break;
+                case BottomLeft:
+                    primary = free.y + h;
+                    secondary = free.x;
+                    break;
+                default:
+                    primary = std::min(leftoverX, leftoverY);
+                    secondary = std::max(leftoverX, leftoverY);
+                    break;
+            }
+        }
+
+        void place(const Rect& used)
+        {
+            std::vector<Rect> split;
+
+            for (std::size_t i = 0; i < m_free.size();)
+            {
+                const Rect free = m_free[i];
+
+                bool overlaps = (used.x < free.x + free.width) && (used.x + used.width > free.x) &&
+                                (used.y < free.y + free.height) && (used.y + used.height > free.y);
+
+                if (!overlaps)
+                {
+                    ++i;
+                    continue;
+                }
+
+                //Keep the parts of the free rectangle on each side of the used one
+                if (used.x > free.x)
+                {
+                    Rect left = {free.x, free.y, used.x - free.x, free.height};
+                    split.push_back(left);
+                }
+                if (used.x + used.width < free.x + free.width)
+                {
+                    Rect right = {used.x + used.width, free.y, free.x + free.width - used.x - used.width, free.height};
+                    split.push_back(right);
+                }
+                if (used.y > free.y)
+                {
+                    Rect top = {free.x, free.y, free.width, used.y - free.y};
+                    split.push_back(top);
+                }
+                if (used.y + used.height < free.y + free.height)
+                {
+                    Rect bottom = {free.x, used.y + used.height, free.width, free.y + free.height - used.y - used.height};
+                    split.push_back(bottom);
+                }
+
+                m_free[i] = m_free.back();
+                m_free.pop_back();
+            }
+
+            m_free.insert(m_free.end(), split.begin(), split.end());
+            prune();
+            use(used);
+        }
+
+        static bool contains(const Rect& outer, const Rect& inner)
+        {
+            return (inner.x >= outer.x) && (inner.y >= outer.y) &&
+                   (inner.x + inner.width <= outer.x + outer.width) &&
+                   (inner.y + inner.height <= outer.y + outer.height);
+        }
+
+        //Remove the free rectangles that are inside another one
+        void prune()
+        {
+            for (std::size_t i = 0; i < m_free.size(); ++i)
+            {
+                for (std::size_t j = i + 1; j < m_free.size();)
+                {
+                    if (contains(m_free[j], m_free[i]))
+                    {
+                        m_free[i] = m_free.back();
+                        m_free.pop_back();
+                        j = i + 1;
+                        if (i >= m_free.size())
+                            break;
+                        continue;
+                    }
+
+                    if (contains(m_free[i], m_free[j]))
+                    {
+                        m_free[j] = m_free.back();
+                        m_free.pop_back();
+                        continue;
+                    }
+
+                    ++j;
+                }
+            }
+        }
+
+        Heuristic m_heuristic;
+        std::vector<Rect> m_free;
+    };
+
+    //Only keeps the top edge of what was packed so far, which is faster but wastes the space under overhangs
+    class SkylineBin : public Bin
+    {
+    public:
+        SkylineBin(unsigned int width, unsigned int height, Heuristic heuristic) :
+        Bin(width, height),
+        m_heuristic(heuristic)
+        {
+            Rect all = {0, 0, width, 0};
+            m_skyline.push_back(all);
+        }
+
+        bool insert(unsigned int width, unsigned int height, bool allowRotation, Placement& placement)
+        {
+            Rect best = {0, 0, 0, 0};
+            std::size_t bestIndex = 0;
+            bool found = false;
+            bool bestRotated = false;
+            unsigned long bestPrimary = std::numeric_limits<unsigned long>::max();
+            unsigned long bestSecondary = std::numeric_limits<unsigned long>::max();
+
+            for (std::size_t i = 0; i < m_skyline.size(); ++i)
+            {
+                for (int rotation = 0; rotation < (allowRotation ? 2 : 1); ++rotation)
+                {
+                    unsigned int w = rotation ? height : width;
+                    unsigned int h = rotation ? width : height;
+                    unsigned int y;
+                    unsigned long waste;
+
+                    if (!fit(i, w, h, y, waste))
+                        continue;
+
+                    unsigned long primary = (m_heuristic == MinWaste) ? waste : y + h;
+                    unsigned long secondary = (m_heuristic == MinWaste) ? y + h : m_skyline[i].width;
+
+                    if ((primary < bestPrimary) || ((primary == bestPrimary) && (secondary < bestSecondary)))
+                    {
+                        Rect rect = {m_skyline[i].x, y, w, h};
+                        best = rect;
+                        bestIndex = i;
+                        bestRotated = rotation != 0;
+                        bestPrimary = primary;
+                        bestSecondary = secondary;
+                        found = true;
+                    }
+                }
+            }
+
+            if (!found)
+                return false;
+
+            place(bestIndex, best);
+
+            placement.x = best.x;
+            placement.y = best.y;
+            placement.rotated = bestRotated;
+
+            return true;
+        }
+
+    private:
+        //Find how high a rectangle starting at a node has to sit, and the space it leaves under it
+        bool fit(std::size_t index, unsigned int width, unsigned int height, unsigned int& y, unsigned long& waste) const
+        {
+            unsigned int x = m_skyline[index].x;
+            if (x + width > m_width)
+                return false;
+
+            y = 0;
+            for (std::size_t i = index; (i < m_skyline.size()) && (m_skyline[i].x < x + width); ++i)
+                y = std::max(y, m_skyline[i].y);
+
+            if (y + height > m_height)
+                return false;
+
+            waste = 0;
+            for (std::size_t i = index; (i < m_skyline.size()) && (m_skyline[i].x < x + width); ++i)
+            {
+                unsigned int right = std::min(m_skyline[i].x + m_skyline[i].width, x + width);
+                waste += static_cast<unsigned long>(right - m_skyline[i].x) * (y - m_skyline[i].y);
+            }
+
+            return true;
+        }
+
+        void place(std::size_t index, const Rect& used)
+        {
+            Rect node = {used.x, used.y + used.height, used.width, 0};
+            m_skyline.insert(m_skyline.begin() + index, node);
+
+            //Cut the nodes that are now under the new one
+            unsigned int right = used.x + used.width;
+            for (std::size_t i = index + 1; i < m_skyline.size();)
+            {
+                Rect& next = m_skyline[i];
+
+                if (next.x >= right)
+                    break;
+
+                unsigned int nextRight = next.x + next.width;
+                if (nextRight <= right)
+                {
+                    m_skyline.erase(m_skyline.begin() + i);
+                    continue;
+                }
+
+                next.width = nextRight - right;
+                next.x = right;
+                break;
+            }
+
+            //Merge neighbours at the same height
+            for (std::size_t i = 0; i + 1 < m_skyline.size();)
+            {
+                if (m_skyline[i].y == m_skyline[i + 1].y)
+                {
+                    m_skyline[i].width += m_skyline[i + 1].width;
+                    m_skyline.erase(m_skyline.begin() + i + 1);
+                }
+                else
+                    ++i;
+            }
+
+            use(used);
+        }
+
+        Heuristic m_heuristic;
+        std::vector<Rect> m_skyline;
+    };
+
+    std::vector<std::size_t> sortSizes(const std::vector<sf::Vector2u>& sizes, SortOrder order)
+    {
+        std::vector<std::size_t> indices(sizes.size());
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            indices[i] = i;
+
+        std::stable_sort(indices.begin(), indices.end(), [&](std::size_t a, std::size_t b)
+        {
+            const sf::Vector2u& first = sizes[a];
+            const sf::Vector2u& second = sizes[b];
+
+            switch (order)
+            {
+                case ByLongestSide:
+                    if (std::max(first.x, first.y) != std::max(second.x, second.y))
+                        return std::max(first.x, first.y) > std::max(second.x, second.y);
+                    break;
+                case ByHeight:
+                    if (first.y != second.y)
+                        return first.y > second.y;
+                    break;
+                default:
+                    break;
+            }
+
+            return static_cast<unsigned long>(first.x) * first.y > static_cast<unsigned long>(second.x) * second.y;
+        });
+
+        return indices;
+    }
+
+    Result packCandidate(const std::vector<sf::Vector2u>& sizes, unsigned int binWidth, unsigned int binHeight,
+                         bool allowRotation, const Candidate& candidate)
+    {
+        Result result;
+        result.success = true;
+        result.placements.resize(sizes.size());
+
+        std::vector<std::unique_ptr<Bin>> bins;
+        std::vector<std::size_t> order = sortSizes(sizes, candidate.order);
+
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            const sf::Vector2u& size = sizes[order[i]];
+            Placement& placement = result.placements[order[i]];
+            bool placed = false;
+
+            for (std::size_t bin = 0; (bin < bins.size()) && !placed; ++bin)
+            {
+                placed = bins[bin]->insert(size.x, size.y, allowRotation, placement);
+                placement.bin = static_cast<unsigned int>(bin);
+            }
+
+            if (!placed)
+            {
+                if (candidate.algorithm == rectpacker::MaxRects)
+                    bins.push_back(std::unique_ptr<Bin>(new MaxRectsBin(binWidth, binHeight, candidate.heuristic)));
+                else
+                    bins.push_back(std::unique_ptr<Bin>(new SkylineBin(binWidth, binHeight, candidate.heuristic)));
+
+                placement.bin = static_cast<unsigned int>(bins.size() - 1);
+
+                //Too large for an empty bin
+                if (!bins.back()->insert(size.x, size.y, allowRotation, placement))
+                {
+                    result.success = false;
+                    return result;
+                }
+            }
+        }
+
+        for (std::size_t bin = 0; bin < bins.size(); ++bin)
+            result.binSizes.push_back(bins[bin]->getUsedSize());
+
+        return result;
+    }
+
+    unsigned long long getTotalArea(const Result& result)
+    {
+        unsigned long long area = 0;
+        for (std::size_t i = 0; i < result.binSizes.size(); ++i)
+            area += static_cast<unsigned long long>(result.binSizes[i].x) * result.binSizes[i].y;
+
+        return area;
+    }
+
+    bool isBetter(const Result& result, const Result& best)
+    {
+        if (result.success != best.success)
+            return result.success;
+
+        if (result.binSizes.size() != best.binSizes.size())
+            return result.binSizes.size() < best.binSizes.size();
+
+        return getTotalArea(result) < getTotalArea(best);
+    }
+}
+
+namespace rectpacker
+{
+    Result pack(const std::vector<sf::Vector2u>& sizes, unsigned int binWidth, unsigned int binHeight,
+                bool allowRotation, int algorithms)
+    {
+        std::vector<Candidate> candidates;
+
+        if (algorithms & MaxRects)
+        {
+            const Heuristic heuristics[] = {BestShortSideFit, BestAreaFit, BottomLeft};
+            for (int h = 0; h < 3; ++h)
+            {
+                for (int order = ByArea; order <= ByHeight; ++order)
+                {
+                    Candidate candidate = {MaxRects, heuristics[h], static_cast<SortOrder>(order)};
+                    candidates.push_back(candidate);
+                }
+            }
+        }
+
+        if (algorithms & Skyline)
+        {
+            const Heuristic heuristics[] = {BottomLeft, MinWaste};
+            for (int h = 0; h < 2; ++h)
+            {
+                for (int order = ByArea; order <= ByHeight; ++order)
+                {
+                    Candidate candidate = {Skyline, heuristics[h], static_cast<SortOrder>(order)};
+                    candidates.push_back(candidate);
+                }
+            }
+        }
+
+        std::vector<Result> results(candidates.size());
+        std::atomic<std::size_t> next(0);
+
+        auto work = [&]()
+        {
+            for (std::size_t i = next++; i < candidates.size(); i = next++)
+                results[i] = packCandidate(sizes, binWidth, binHeight, allowRotation, candidates[i]);
+        };
+
+        //Each candidate packs everything on its own, so they can run side by side
+        std::size_t threadCount = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), candidates.size());
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < threadCount; ++i)
+            threads.push_back(std::thread(work));
+
+        work();
+
+        for (std::size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+
+        Result best;
+        best.success = false;
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            if ((i == 0) || isBetter(results[i], best))
+                best = results[i];
+        }
+
+        return best;
+    }
+}
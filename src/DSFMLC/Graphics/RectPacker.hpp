@@ -0,0 +1,66 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_RECTPACKER_HPP
+#define DSFML_RECTPACKER_HPP
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+//Offline packing of rectangles into as few fixed size bins as possible
+namespace rectpacker
+{
+    enum Algorithm
+    {
+        MaxRects = 1,
+        Skyline = 2
+    };
+
+    //Where a rectangle ended up, its size is swapped in the bin when it is rotated
+    struct Placement
+    {
+        unsigned int bin;
+        unsigned int x;
+        unsigned int y;
+        bool rotated;
+    };
+
+    struct Result
+    {
+        bool success;
+        std::vector<Placement> placements;
+        std::vector<sf::Vector2u> binSizes;
+    };
+
+    //Pack the sizes into bins of at most binWidth x binHeight. Every heuristic of the
+    //requested algorithms is tried in parallel, and the result using the fewest and
+    //smallest bins is kept.
+    Result pack(const std::vector<sf::Vector2u>& sizes, unsigned int binWidth, unsigned int binHeight,
+                bool allowRotation, int algorithms);
+}
+
+#endif // DSFML_RECTPACKER_HPP
@@ -0,0 +1,120 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_RENDERSTATECACHE_HPP
+#define DSFML_RENDERSTATECACHE_HPP
+
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <DSFMLC/Config.h>
+#include <cstring>
+
+// Remembers the states last used by a render target, so that redundant
+// changes can be skipped and counted
+struct sfRenderStateCache
+{
+    // Kinds of state tracked by the cache
+    enum State
+    {
+        BlendModeState,
+        TextureState,
+        ShaderState,
+        TransformState,
+        ViewState,
+        StateCount
+    };
+
+    sfRenderStateCache() :
+    valid(false),
+    texture(NULL),
+    shader(NULL)
+    {
+        resetStatistics();
+    }
+
+    // Forget the cached states, because the GL states were changed behind our back
+    void invalidate()
+    {
+        valid = false;
+    }
+
+    void resetStatistics()
+    {
+        std::memset(issued, 0, sizeof(issued));
+        std::memset(skipped, 0, sizeof(skipped));
+    }
+
+    // Check if a view needs to be applied; returns false when it is the same
+    // as the one the target already uses
+    bool updateView(const sf::View& current, const sf::View& view)
+    {
+        bool changed = (current.getCenter() != view.getCenter()) ||
+                       (current.getSize() != view.getSize()) ||
+                       (current.getRotation() != view.getRotation()) ||
+                       (current.getViewport() != view.getViewport());
+
+        count(ViewState, changed);
+
+        return changed;
+    }
+
+    // Record the states used by a draw call
+    void update(const sf::RenderStates& states)
+    {
+        const float* matrix = states.transform.getMatrix();
+
+        count(BlendModeState, !valid || (states.blendMode != blendMode));
+        count(TextureState, !valid || (states.texture != texture));
+        count(ShaderState, !valid || (states.shader != shader));
+        count(TransformState, !valid || (std::memcmp(matrix, transform, sizeof(transform)) != 0));
+
+        blendMode = states.blendMode;
+        texture = states.texture;
+        shader = states.shader;
+        std::memcpy(transform, matrix, sizeof(transform));
+        valid = true;
+    }
+
+    void count(State state, bool changed)
+    {
+        if (changed)
+            ++issued[state];
+        else
+            ++skipped[state];
+    }
+
+    bool               valid;
+    sf::BlendMode      blendMode;
+    const sf::Texture* texture;
+    const sf::Shader*  shader;
+    float              transform[16];
+    DUint              issued[StateCount];
+    DUint              skipped[StateCount];
+};
+
+#endif // DSFML_RENDERSTATECACHE_HPP
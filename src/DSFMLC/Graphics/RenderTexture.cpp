@@ -31,6 +31,8 @@ All Libraries used by SFML - For a full list see http://www.sfml-dev.org/license
 #include <DSFMLC/Graphics/RenderTexture.h>
 #include <DSFMLC/Graphics/RenderTextureStruct.h>
 #include <DSFMLC/Graphics/CreateRenderStates.hpp>
+#include <DSFMLC/Graphics/DrawBatch.hpp>
+#include <DSFMLC/Graphics/VertexBufferStruct.h>
 
 sfRenderTexture* sfRenderTexture_construct(void)
 {
@@ -56,6 +58,8 @@ void sfRenderTexture_getSize(const sfRenderTexture* renderTexture, DUint* x, DUi
 
 DBool sfRenderTexture_setActive(sfRenderTexture* renderTexture, DBool active)
 {
+    renderTexture->StateCache.invalidate();
+
     return renderTexture->This.setActive(active == DTrue)?DTrue: DFalse;
 }
 
@@ -71,48 +75,23 @@ void sfRenderTexture_clear(sfRenderTexture* renderTexture, DUbyte r, DUbyte g, D
     renderTexture->This.clear(SFMLColor);
 }
 
-void sfRenderTexture_setView(sfRenderTexture* renderTexture, float centerX, float centerY, float sizeX,
-		float sizeY, float rotation, float viewportLeft, float viewportTop, float viewportWidth,
-		float viewportHeight)
+void sfRenderTexture_setView(sfRenderTexture* renderTexture, const sfViewData* view)
 {
-	sf::View view;
-	view.setCenter(centerX, centerY);
-	view.setSize(sizeX, sizeY);
-	view.setRotation(rotation);
-	view.setViewport(sf::FloatRect(viewportLeft, viewportTop, viewportWidth, viewportHeight));
-    renderTexture->This.setView(view);
+    const sf::View& cachedView = renderTexture->ViewCache.get(*view);
+
+    //Applying the same view again would make SFML reload the projection
+    if (renderTexture->StateCache.updateView(renderTexture->This.getView(), cachedView))
+        renderTexture->This.setView(cachedView);
 }
 
-void sfRenderTexture_getView(const sfRenderTexture* renderTexture, float* centerX, float* centerY, float* sizeX,
-		float* sizeY, float* rotation, float* viewportLeft, float* viewportTop, float* viewportWidth,
-		float* viewportHeight)
+void sfRenderTexture_getView(const sfRenderTexture* renderTexture, sfViewData* view)
 {
-    sf::View view = renderTexture->This.getView();
-    *centerX = view.getCenter().x;
-    *centerY = view.getCenter().y;
-    *sizeX = view.getSize().x;
-    *sizeY = view.getSize().y;
-    *rotation = view.getRotation();
-    *viewportLeft = view.getViewport().left;
-    *viewportTop = view.getViewport().top;
-    *viewportWidth = view.getViewport().width;
-    *viewportHeight = view.getViewport().height;
+    sfViewCache::getViewData(renderTexture->This.getView(), view);
 }
 
-void sfRenderTexture_getDefaultView(const sfRenderTexture* renderTexture, float* centerX, float* centerY, float* sizeX,
-		float* sizeY, float* rotation, float* viewportLeft, float* viewportTop, float* viewportWidth,
-		float* viewportHeight)
+void sfRenderTexture_getDefaultView(const sfRenderTexture* renderTexture, sfViewData* view)
 {
-    sf::View view = renderTexture->This.getDefaultView();
-    *centerX = view.getCenter().x;
-    *centerY = view.getCenter().y;
-    *sizeX = view.getSize().x;
-    *sizeY = view.getSize().y;
-    *rotation = view.getRotation();
-    *viewportLeft = view.getViewport().left;
-    *viewportTop = view.getViewport().top;
-    *viewportWidth = view.getViewport().width;
-    *viewportHeight = view.getViewport().height;
+    sfViewCache::getViewData(renderTexture->This.getDefaultView(), view);
 }
 
 void sfRenderTexture_drawPrimitives(sfRenderTexture* renderTexture,
@@ -122,23 +101,67 @@ void sfRenderTexture_drawPrimitives(sfRenderTexture* renderTexture,
 									DInt alphaEquation, const float* transform, const sfTexture*
 									texture, const sfShader* shader)
 {
-    renderTexture->This.draw(reinterpret_cast<const sf::Vertex*>(vertices), vertexCount, static_cast<sf::PrimitiveType>(type), createRenderStates(colorSrcFactor,
-    		colorDstFactor, colorEquation, alphaSrcFactor, alphaDstFactor, alphaEquation, transform, texture, shader));
+    sf::RenderStates states = createRenderStates(colorSrcFactor,
+    		colorDstFactor, colorEquation, alphaSrcFactor, alphaDstFactor, alphaEquation, transform, texture, shader);
+
+    renderTexture->StateCache.update(states);
+    renderTexture->This.draw(reinterpret_cast<const sf::Vertex*>(vertices), vertexCount, static_cast<sf::PrimitiveType>(type), states);
+}
+
+void sfRenderTexture_drawVertexBuffer(sfRenderTexture* renderTexture, const sfVertexBuffer* vertexBuffer,
+                                    DUint firstVertex, DUint vertexCount,
+                                    DInt type, DInt colorSrcFactor, DInt colorDstFactor, DInt colorEquation,
+                                    DInt alphaSrcFactor, DInt alphaDstFactor, DInt alphaEquation,
+                                    const float* transform, const sfTexture* texture, const sfShader* shader)
+{
+    sf::RenderStates states = createRenderStates(colorSrcFactor,
+            colorDstFactor, colorEquation, alphaSrcFactor, alphaDstFactor, alphaEquation, transform, texture, shader);
+
+    if (!renderTexture->This.setActive(true))
+        return;
+
+    renderTexture->StateCache.update(states);
+    vertexBuffer->draw(renderTexture->This, firstVertex, vertexCount, static_cast<sf::PrimitiveType>(type), states);
+
+    //The vertex buffer resets the GL states after drawing
+    renderTexture->StateCache.invalidate();
+}
+
+void sfRenderTexture_drawBatch(sfRenderTexture* renderTexture, const sfDrawCommand* commands, size_t commandCount)
+{
+    drawBatch(renderTexture->This, renderTexture->StateCache, commands, commandCount);
 }
 
 void sfRenderTexture_pushGLStates(sfRenderTexture* renderTexture)
 {
     renderTexture->This.pushGLStates();
+    renderTexture->StateCache.invalidate();
 }
 
 void sfRenderTexture_popGLStates(sfRenderTexture* renderTexture)
 {
     renderTexture->This.popGLStates();
+    renderTexture->StateCache.invalidate();
 }
 
 void sfRenderTexture_resetGLStates(sfRenderTexture* renderTexture)
 {
     renderTexture->This.resetGLStates();
+    renderTexture->StateCache.invalidate();
+}
+
+void sfRenderTexture_getStateStatistics(const sfRenderTexture* renderTexture, DUint* issued, DUint* skipped)
+{
+    for (int i = 0; i < sfRenderStateCache::StateCount; ++i)
+    {
+        issued[i] = renderTexture->StateCache.issued[i];
+        skipped[i] = renderTexture->StateCache.skipped[i];
+    }
+}
+
+void sfRenderTexture_resetStateStatistics(sfRenderTexture* renderTexture)
+{
+    renderTexture->StateCache.resetStatistics();
 }
 
 sfTexture* sfRenderTexture_getTexture(const sfRenderTexture* renderTexture)
@@ -30,6 +30,9 @@
 
 #include <DSFMLC/Graphics/Export.h>
 #include <DSFMLC/Graphics/Types.h>
+#include <DSFMLC/Graphics/DrawCommand.h>
+#include <DSFMLC/Graphics/ViewData.h>
+#include <stddef.h>
 
 //Construct a new render texture
 DSFML_GRAPHICS_API sfRenderTexture* sfRenderTexture_construct(void);
@@ -53,19 +56,13 @@ DSFML_GRAPHICS_API void sfRenderTexture_display(sfRenderTexture* renderTexture);
 DSFML_GRAPHICS_API void sfRenderTexture_clear(sfRenderTexture* renderTexture, DUbyte r, DUbyte g, DUbyte b, DUbyte a);
 
 //  Change the current active view of a render texture
-DSFML_GRAPHICS_API void sfRenderTexture_setView(sfRenderTexture* renderTexture, float centerX, float centerY, float sizeX,
-												float sizeY, float rotation, float viewportLeft, float viewportTop, float viewportWidth,
-												float viewportHeight);
+DSFML_GRAPHICS_API void sfRenderTexture_setView(sfRenderTexture* renderTexture, const sfViewData* view);
 
 //  Get the current active view of a render texture
-DSFML_GRAPHICS_API void sfRenderTexture_getView(const sfRenderTexture* renderTexture, float* centerX, float* centerY, float* sizeX,
-												float* sizeY, float* rotation, float* viewportLeft, float* viewportTop, float* viewportWidth,
-												float* viewportHeight);
+DSFML_GRAPHICS_API void sfRenderTexture_getView(const sfRenderTexture* renderTexture, sfViewData* view);
 
 //  Get the default view of a render texture
-DSFML_GRAPHICS_API void sfRenderTexture_getDefaultView(const sfRenderTexture* renderTexture, float* centerX, float* centerY, float* sizeX,
-														float* sizeY, float* rotation, float* viewportLeft, float* viewportTop, float* viewportWidth,
-														float* viewportHeight);
+DSFML_GRAPHICS_API void sfRenderTexture_getDefaultView(const sfRenderTexture* renderTexture, sfViewData* view);
 
 //  Draw primitives defined by an array of vertices to a render texture
 DSFML_GRAPHICS_API void sfRenderTexture_drawPrimitives(sfRenderTexture* renderTexture,
@@ -74,6 +71,15 @@ DSFML_GRAPHICS_API void sfRenderTexture_drawPrimitives(sfRenderTexture* renderTe
 														DInt colorEquation, DInt alphaSrcFactor, DInt alphaDstFactor,
 														DInt alphaEquation,const float* transform, const sfTexture* texture, const sfShader* shader);
 
+//  Draw a range of a vertex buffer to a render texture
+DSFML_GRAPHICS_API void sfRenderTexture_drawVertexBuffer(sfRenderTexture* renderTexture, const sfVertexBuffer* vertexBuffer,
+                                                      DUint firstVertex, DUint vertexCount,
+                                                      DInt type, DInt colorSrcFactor, DInt colorDstFactor, DInt colorEquation,
+                                                      DInt alphaSrcFactor, DInt alphaDstFactor, DInt alphaEquation, const float* transform, const sfTexture* texture, const sfShader* shader);
+
+//  Draw a list of primitives with their own render states to a render texture in a single call
+DSFML_GRAPHICS_API void sfRenderTexture_drawBatch(sfRenderTexture* renderTexture, const sfDrawCommand* commands, size_t commandCount);
+
 //  Save the current OpenGL render states and matrices
 DSFML_GRAPHICS_API void sfRenderTexture_pushGLStates(sfRenderTexture* renderTexture);
 
@@ -83,6 +89,12 @@ DSFML_GRAPHICS_API void sfRenderTexture_popGLStates(sfRenderTexture* renderTextu
 //  Reset the internal OpenGL states so that the target is ready for drawing
 DSFML_GRAPHICS_API void sfRenderTexture_resetGLStates(sfRenderTexture* renderTexture);
 
+//  Get the number of state changes issued and skipped by a render texture, by kind of state
+DSFML_GRAPHICS_API void sfRenderTexture_getStateStatistics(const sfRenderTexture* renderTexture, DUint* issued, DUint* skipped);
+
+//  Reset the state change statistics of a render texture
+DSFML_GRAPHICS_API void sfRenderTexture_resetStateStatistics(sfRenderTexture* renderTexture);
+
 //  Get the target texture of a render texture
 DSFML_GRAPHICS_API sfTexture* sfRenderTexture_getTexture(const sfRenderTexture* renderTexture);
 
@@ -29,13 +29,17 @@
 #define SFML_RENDERTEXTURESTRUCT_H
 
 #include <SFML/Graphics/RenderTexture.hpp>
+#include <DSFMLC/Graphics/RenderStateCache.hpp>
+#include <DSFMLC/Graphics/ViewCache.hpp>
 #include <DSFMLC/Graphics/TextureStruct.h>
 
 //Internal structure of sfRenderTexture
 struct sfRenderTexture
 {
-    sf::RenderTexture This;
-    const sfTexture*  Target;
+    sf::RenderTexture  This;
+    const sfTexture*   Target;
+    sfRenderStateCache StateCache;
+    sfViewCache        ViewCache;
 };
 
 #endif // SFML_RENDERTEXTURESTRUCT_H
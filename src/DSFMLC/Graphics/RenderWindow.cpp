@@ -29,6 +29,8 @@
 #include <DSFMLC/Graphics/RenderWindowStruct.h>
 #include <DSFMLC/Graphics/ImageStruct.h>
 #include <DSFMLC/Graphics/CreateRenderStates.hpp>
+#include <DSFMLC/Graphics/DrawBatch.hpp>
+#include <DSFMLC/Graphics/VertexBufferStruct.h>
 #include <DSFMLC/ConvertEvent.h>
 #include <SFML/System/String.hpp>
 
@@ -226,6 +228,8 @@ void sfRenderWindow_setKeyRepeatEnabled(sfRenderWindow* renderWindow, DBool enab
 
 DBool sfRenderWindow_setActive(sfRenderWindow* renderWindow, DBool active)
 {
+    renderWindow->StateCache.invalidate();
+
     return renderWindow->This.setActive(active == DTrue)?DTrue: DFalse;
 }
 
@@ -256,49 +260,23 @@ void sfRenderWindow_clear(sfRenderWindow* renderWindow, DUbyte r, DUbyte g, DUby
     renderWindow->This.clear(SFMLColor);
 }
 
-void sfRenderWindow_setView(sfRenderWindow* renderWindow, float centerX, float centerY, float sizeX,
-		float sizeY, float rotation, float viewportLeft, float viewportTop, float viewportWidth,
-		float viewportHeight)
+void sfRenderWindow_setView(sfRenderWindow* renderWindow, const sfViewData* view)
 {
-	sf::View view;
-	view.setCenter(centerX, centerY);
-	view.setSize(sizeX, sizeY);
-	view.setRotation(rotation);
-	view.setViewport(sf::FloatRect(viewportLeft, viewportTop, viewportWidth, viewportHeight));
-    renderWindow->This.setView(view);
-}
+    const sf::View& cachedView = renderWindow->ViewCache.get(*view);
 
+    //Applying the same view again would make SFML reload the projection
+    if (renderWindow->StateCache.updateView(renderWindow->This.getView(), cachedView))
+        renderWindow->This.setView(cachedView);
+}
 
-void sfRenderWindow_getView(const sfRenderWindow* renderWindow, float* centerX, float* centerY, float* sizeX,
-		float* sizeY, float* rotation, float* viewportLeft, float* viewportTop, float* viewportWidth,
-		float* viewportHeight)
+void sfRenderWindow_getView(const sfRenderWindow* renderWindow, sfViewData* view)
 {
-    sf::View view = renderWindow->This.getView();
-    *centerX = view.getCenter().x;
-    *centerY = view.getCenter().y;
-    *sizeX = view.getSize().x;
-    *sizeY = view.getSize().y;
-    *rotation = view.getRotation();
-    *viewportLeft = view.getViewport().left;
-    *viewportTop = view.getViewport().top;
-    *viewportWidth = view.getViewport().width;
-    *viewportHeight = view.getViewport().height;
+    sfViewCache::getViewData(renderWindow->This.getView(), view);
 }
 
-void sfRenderWindow_getDefaultView(const sfRenderWindow* renderWindow, float* centerX, float* centerY, float* sizeX,
-		float* sizeY, float* rotation, float* viewportLeft, float* viewportTop, float* viewportWidth,
-		float* viewportHeight)
+void sfRenderWindow_getDefaultView(const sfRenderWindow* renderWindow, sfViewData* view)
 {
-    sf::View view = renderWindow->This.getDefaultView();
-    *centerX = view.getCenter().x;
-    *centerY = view.getCenter().y;
-    *sizeX = view.getSize().x;
-    *sizeY = view.getSize().y;
-    *rotation = view.getRotation();
-    *viewportLeft = view.getViewport().left;
-    *viewportTop = view.getViewport().top;
-    *viewportWidth = view.getViewport().width;
-    *viewportHeight = view.getViewport().height;
+    sfViewCache::getViewData(renderWindow->This.getDefaultView(), view);
 }
 
 void sfRenderWindow_drawPrimitives(sfRenderWindow* renderWindow,
@@ -306,23 +284,67 @@ void sfRenderWindow_drawPrimitives(sfRenderWindow* renderWindow,
 													  DInt alphaSrcFactor, DInt alphaDstFactor, DInt alphaEquation,
 													  const float* transform, const sfTexture* texture, const sfShader* shader)
 {
-    renderWindow->This.draw(static_cast<const sf::Vertex*>(vertices), vertexCount, static_cast<sf::PrimitiveType>(type), createRenderStates(colorSrcFactor, colorDstFactor,
-    		colorEquation, alphaSrcFactor, alphaDstFactor, alphaEquation, transform, texture, shader));
+    sf::RenderStates states = createRenderStates(colorSrcFactor, colorDstFactor,
+    		colorEquation, alphaSrcFactor, alphaDstFactor, alphaEquation, transform, texture, shader);
+
+    renderWindow->StateCache.update(states);
+    renderWindow->This.draw(static_cast<const sf::Vertex*>(vertices), vertexCount, static_cast<sf::PrimitiveType>(type), states);
+}
+
+void sfRenderWindow_drawVertexBuffer(sfRenderWindow* renderWindow, const sfVertexBuffer* vertexBuffer,
+                                    DUint firstVertex, DUint vertexCount,
+                                    DInt type, DInt colorSrcFactor, DInt colorDstFactor, DInt colorEquation,
+                                    DInt alphaSrcFactor, DInt alphaDstFactor, DInt alphaEquation,
+                                    const float* transform, const sfTexture* texture, const sfShader* shader)
+{
+    sf::RenderStates states = createRenderStates(colorSrcFactor,
+            colorDstFactor, colorEquation, alphaSrcFactor, alphaDstFactor, alphaEquation, transform, texture, shader);
+
+    if (!renderWindow->This.setActive(true))
+        return;
+
+    renderWindow->StateCache.update(states);
+    vertexBuffer->draw(renderWindow->This, firstVertex, vertexCount, static_cast<sf::PrimitiveType>(type), states);
+
+    //The vertex buffer resets the GL states after drawing
+    renderWindow->StateCache.invalidate();
+}
+
+void sfRenderWindow_drawBatch(sfRenderWindow* renderWindow, const sfDrawCommand* commands, size_t commandCount)
+{
+    drawBatch(renderWindow->This, renderWindow->StateCache, commands, commandCount);
 }
 
 void sfRenderWindow_pushGLStates(sfRenderWindow* renderWindow)
 {
     renderWindow->This.pushGLStates();
+    renderWindow->StateCache.invalidate();
 }
 
 void sfRenderWindow_popGLStates(sfRenderWindow* renderWindow)
 {
     renderWindow->This.popGLStates();
+    renderWindow->StateCache.invalidate();
 }
 
 void sfRenderWindow_resetGLStates(sfRenderWindow* renderWindow)
 {
     renderWindow->This.resetGLStates();
+    renderWindow->StateCache.invalidate();
+}
+
+void sfRenderWindow_getStateStatistics(const sfRenderWindow* renderWindow, DUint* issued, DUint* skipped)
+{
+    for (int i = 0; i < sfRenderStateCache::StateCount; ++i)
+    {
+        issued[i] = renderWindow->StateCache.issued[i];
+        skipped[i] = renderWindow->StateCache.skipped[i];
+    }
+}
+
+void sfRenderWindow_resetStateStatistics(sfRenderWindow* renderWindow)
+{
+    renderWindow->StateCache.resetStatistics();
 }
 
 sfImage* sfRenderWindow_capture(const sfRenderWindow* renderWindow)
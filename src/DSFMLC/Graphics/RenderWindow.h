@@ -30,6 +30,8 @@
 
 #include <DSFMLC/Graphics/Export.h>
 #include <DSFMLC/Graphics/Types.h>
+#include <DSFMLC/Graphics/DrawCommand.h>
+#include <DSFMLC/Graphics/ViewData.h>
 #include <DSFMLC/Window/Event.h>
 #include <DSFMLC/Window/VideoMode.h>
 #include <DSFMLC/Window/WindowHandle.h>
@@ -121,19 +123,13 @@ DSFML_GRAPHICS_API sfWindowHandle sfRenderWindow_getSystemHandle(const sfRenderW
 DSFML_GRAPHICS_API void sfRenderWindow_clear(sfRenderWindow* renderWindow, DUbyte r, DUbyte g, DUbyte b, DUbyte a);
 
 //Change the current active view of a render window
-DSFML_GRAPHICS_API void sfRenderWindow_setView(sfRenderWindow* renderWindow, float centerX, float centerY, float sizeX,
-												float sizeY, float rotation, float viewportLeft, float viewportTop, float viewportWidth,
-												float viewportHeight);
+DSFML_GRAPHICS_API void sfRenderWindow_setView(sfRenderWindow* renderWindow, const sfViewData* view);
 
 //Get the current active view of a render window
-DSFML_GRAPHICS_API void sfRenderWindow_getView(const sfRenderWindow* renderWindow, float* centerX, float* centerY, float* sizeX,
-												float* sizeY, float* rotation, float* viewportLeft, float* viewportTop, float* viewportWidth,
-												float* viewportHeight);
+DSFML_GRAPHICS_API void sfRenderWindow_getView(const sfRenderWindow* renderWindow, sfViewData* view);
 
 //Get the default view of a render window
-DSFML_GRAPHICS_API void sfRenderWindow_getDefaultView(const sfRenderWindow* renderWindow, float* centerX, float* centerY, float* sizeX,
-														float* sizeY, float* rotation, float* viewportLeft, float* viewportTop, float* viewportWidth,
-														float* viewportHeight);
+DSFML_GRAPHICS_API void sfRenderWindow_getDefaultView(const sfRenderWindow* renderWindow, sfViewData* view);
 
 //Draw primitives defined by an array of vertices to a render window
 DSFML_GRAPHICS_API void sfRenderWindow_drawPrimitives(sfRenderWindow* renderWindow,
@@ -141,6 +137,15 @@ DSFML_GRAPHICS_API void sfRenderWindow_drawPrimitives(sfRenderWindow* renderWind
                                                       DInt type, DInt colorSrcFactor, DInt colorDstFactor, DInt colorEquation,
 													  DInt alphaSrcFactor, DInt alphaDstFactor, DInt alphaEquation, const float* transform, const sfTexture* texture, const sfShader* shader);
 
+//Draw a range of a vertex buffer to a render window
+DSFML_GRAPHICS_API void sfRenderWindow_drawVertexBuffer(sfRenderWindow* renderWindow, const sfVertexBuffer* vertexBuffer,
+                                                      DUint firstVertex, DUint vertexCount,
+                                                      DInt type, DInt colorSrcFactor, DInt colorDstFactor, DInt colorEquation,
+                                                      DInt alphaSrcFactor, DInt alphaDstFactor, DInt alphaEquation, const float* transform, const sfTexture* texture, const sfShader* shader);
+
+//Draw a list of primitives with their own render states to a render window in a single call
+DSFML_GRAPHICS_API void sfRenderWindow_drawBatch(sfRenderWindow* renderWindow, const sfDrawCommand* commands, size_t commandCount);
+
 //Save the current OpenGL render states and matrices
 DSFML_GRAPHICS_API void sfRenderWindow_pushGLStates(sfRenderWindow* renderWindow);
 
@@ -150,6 +155,12 @@ DSFML_GRAPHICS_API void sfRenderWindow_popGLStates(sfRenderWindow* renderWindow)
 //Reset the internal OpenGL states so that the target is ready for drawing
 DSFML_GRAPHICS_API void sfRenderWindow_resetGLStates(sfRenderWindow* renderWindow);
 
+//Get the number of state changes issued and skipped by a render window, by kind of state
+DSFML_GRAPHICS_API void sfRenderWindow_getStateStatistics(const sfRenderWindow* renderWindow, DUint* issued, DUint* skipped);
+
+//Reset the state change statistics of a render window
+DSFML_GRAPHICS_API void sfRenderWindow_resetStateStatistics(sfRenderWindow* renderWindow);
+
 //Copy the current contents of a render window to an image
 DSFML_GRAPHICS_API sfImage* sfRenderWindow_capture(const sfRenderWindow* renderWindow);
 
@@ -29,11 +29,15 @@
 #define SFML_RENDERWINDOWSTRUCT_H
 
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <DSFMLC/Graphics/RenderStateCache.hpp>
+#include <DSFMLC/Graphics/ViewCache.hpp>
 
 //Internal structure of sfRenderWindow
 struct sfRenderWindow
 {
-    sf::RenderWindow This;
+    sf::RenderWindow   This;
+    sfRenderStateCache StateCache;
+    sfViewCache        ViewCache;
 };
 
 #endif // SFML_RENDERWINDOWSTRUCT_H
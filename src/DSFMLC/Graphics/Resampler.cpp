@@ -0,0 +1,288 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/Resampler.hpp>
+#include <DSFMLC/Graphics/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define DSFML_RESAMPLER_SSE2
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define DSFML_RESAMPLER_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace
+{
+    //The filters work on one RGBA pixel at a time, which fits in a single vector register
+#if defined(DSFML_RESAMPLER_SSE2)
+    typedef __m128 Float4;
+
+    inline Float4 load(const float* values) { return _mm_loadu_ps(values); }
+    inline void store(float* values, Float4 vector) { _mm_storeu_ps(values, vector); }
+    inline Float4 splat(float value) { return _mm_set1_ps(value); }
+    inline Float4 multiplyAdd(Float4 sum, Float4 a, Float4 b) { return _mm_add_ps(sum, _mm_mul_ps(a, b)); }
+#elif defined(DSFML_RESAMPLER_NEON)
+    typedef float32x4_t Float4;
+
+    inline Float4 load(const float* values) { return vld1q_f32(values); }
+    inline void store(float* values, Float4 vector) { vst1q_f32(values, vector); }
+    inline Float4 splat(float value) { return vdupq_n_f32(value); }
+    inline Float4 multiplyAdd(Float4 sum, Float4 a, Float4 b) { return vmlaq_f32(sum, a, b); }
+#else
+    struct Float4
+    {
+        float v[4];
+    };
+
+    inline Float4 load(const float* values)
+    {
+        Float4 vector = {{values[0], values[1], values[2], values[3]}};
+        return vector;
+    }
+
+    inline void store(float* values, Float4 vector)
+    {
+        for (int i = 0; i < 4; ++i)
+            values[i] = vector.v[i];
+    }
+
+    inline Float4 splat(float value)
+    {
+        Float4 vector = {{value, value, value, value}};
+        return vector;
+    }
+
+    inline Float4 multiplyAdd(Float4 sum, Float4 a, Float4 b)
+    {
+        for (int i = 0; i < 4; ++i)
+            sum.v[i] += a.v[i] * b.v[i];
+        return sum;
+    }
+#endif
+
+    const float pi = 3.14159265358979f;
+
+    float support(resampler::Filter filter)
+    {
+        switch (filter)
+        {
+            case resampler::Bilinear: return 1.f;
+            case resampler::Bicubic:  return 2.f;
+            case resampler::Lanczos:  return 3.f;
+            default:                  return 0.5f;
+        }
+    }
+
+    float weigh(resampler::Filter filter, float x)
+    {
+        switch (filter)
+        {
+            case resampler::Bilinear:
+                return std::max(0.f, 1.f - std::abs(x));
+
+            //Catmull-Rom, which keeps edges sharper than a B-spline
+            case resampler::Bicubic:
+                x = std::abs(x);
+                if (x < 1.f)
+                    return (1.5f * x - 2.5f) * x * x + 1.f;
+                if (x < 2.f)
+                    return ((-0.5f * x + 2.5f) * x - 4.f) * x + 2.f;
+                return 0.f;
+
+            case resampler::Lanczos:
+                if (x == 0.f)
+                    return 1.f;
+                if (std::abs(x) >= 3.f)
+                    return 0.f;
+                return 3.f * std::sin(pi * x) * std::sin(pi * x / 3.f) / (pi * pi * x * x);
+
+            default:
+                return ((x >= -0.5f) && (x < 0.5f)) ? 1.f : 0.f;
+        }
+    }
+
+    //Source pixels and weights contributing to each destination pixel along one axis
+    struct Contributions
+    {
+        std::vector<unsigned int> first;
+        std::vector<unsigned int> count;
+        std::vector<float> weights;
+        unsigned int stride;
+    };
+
+    Contributions contribute(unsigned int sourceSize, unsigned int size, resampler::Filter filter)
+    {
+        //When shrinking, the filter is stretched to cover every source pixel
+        float scale = static_cast<float>(sourceSize) / size;
+        float filterScale = std::max(1.f, scale);
+        float radius = support(filter) * filterScale;
+
+        Contributions contributions;
+        contributions.stride = static_cast<unsigned int>(std::ceil(radius)) * 2 + 2;
+        contributions.first.resize(size);
+        contributions.count.resize(size);
+        contributions.weights.resize(static_cast<std::size_t>(size) * contributions.stride);
+
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            float center = (i + 0.5f) * scale;
+            int left = std::max(0, static_cast<int>(std::floor(center - radius)));
+            int right = std::min(static_cast<int>(sourceSize), static_cast<int>(std::ceil(center + radius)));
+            float* weights = &contributions.weights[static_cast<std::size_t>(i) * contributions.stride];
+
+            float total = 0.f;
+            unsigned int count = 0;
+            for (int j = left; (j < right) && (count < contributions.stride); ++j)
+            {
+                weights[count] = weigh(filter, (j + 0.5f - center) / filterScale);
+                total += weights[count++];
+            }
+
+            //A box narrower than a pixel can miss every center, fall back to the nearest pixel
+            if (total == 0.f)
+            {
+                left = std::min(static_cast<int>(center), static_cast<int>(sourceSize) - 1);
+                weights[0] = total = 1.f;
+                count = 1;
+            }
+
+            for (unsigned int j = 0; j < count; ++j)
+                weights[j] /= total;
+
+            contributions.first[i] = static_cast<unsigned int>(left);
+            contributions.count[i] = count;
+        }
+
+        return contributions;
+    }
+
+    //Split rows in chunks big enough to be worth a thread
+    std::size_t rowsPerChunk(unsigned int width)
+    {
+        return std::max<std::size_t>(1, 65536 / std::max(1u, width));
+    }
+
+    void premultiplyRow(const sf::Uint8* pixels, unsigned int width, float* row)
+    {
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            float alpha = pixels[x * 4 + 3] / 255.f;
+
+            row[x * 4] = pixels[x * 4] * alpha;
+            row[x * 4 + 1] = pixels[x * 4 + 1] * alpha;
+            row[x * 4 + 2] = pixels[x * 4 + 2] * alpha;
+            row[x * 4 + 3] = pixels[x * 4 + 3];
+        }
+    }
+
+    inline sf::Uint8 toByte(float value)
+    {
+        return static_cast<sf::Uint8>(std::min(255.f, std::max(0.f, value)) + 0.5f);
+    }
+
+    void unpremultiplyRow(const float* row, unsigned int width, sf::Uint8* pixels)
+    {
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            float alpha = row[x * 4 + 3];
+            float factor = (alpha > 0.f) ? 255.f / alpha : 0.f;
+
+            pixels[x * 4] = toByte(row[x * 4] * factor);
+            pixels[x * 4 + 1] = toByte(row[x * 4 + 1] * factor);
+            pixels[x * 4 + 2] = toByte(row[x * 4 + 2] * factor);
+            pixels[x * 4 + 3] = toByte(alpha);
+        }
+    }
+}
+
+namespace resampler
+{
+    void resize(const sf::Uint8* source, unsigned int sourceWidth, unsigned int sourceHeight,
+                sf::Uint8* destination, unsigned int width, unsigned int height, Filter filter)
+    {
+        Contributions columns = contribute(sourceWidth, width, filter);
+        Contributions rows = contribute(sourceHeight, height, filter);
+
+        //Horizontal pass, every source row is filtered to the new width
+        std::vector<float> filtered(static_cast<std::size_t>(sourceHeight) * width * 4);
+        std::size_t chunk = rowsPerChunk(width);
+
+        parallel::forEach((sourceHeight + chunk - 1) / chunk, [&](std::size_t index)
+        {
+            std::vector<float> row(static_cast<std::size_t>(sourceWidth) * 4);
+            std::size_t end = std::min<std::size_t>(sourceHeight, (index + 1) * chunk);
+
+            for (std::size_t y = index * chunk; y < end; ++y)
+            {
+                premultiplyRow(source + y * sourceWidth * 4, sourceWidth, &row[0]);
+                float* output = &filtered[y * width * 4];
+
+                for (unsigned int x = 0; x < width; ++x)
+                {
+                    const float* weights = &columns.weights[static_cast<std::size_t>(x) * columns.stride];
+                    const float* pixel = &row[static_cast<std::size_t>(columns.first[x]) * 4];
+                    Float4 sum = splat(0.f);
+
+                    for (unsigned int tap = 0; tap < columns.count[x]; ++tap)
+                        sum = multiplyAdd(sum, splat(weights[tap]), load(pixel + tap * 4));
+
+                    store(output + x * 4, sum);
+                }
+            }
+        });
+
+        //Vertical pass, the filtered rows are combined 4 floats at a time
+        parallel::forEach((height + chunk - 1) / chunk, [&](std::size_t index)
+        {
+            std::size_t length = static_cast<std::size_t>(width) * 4;
+            std::vector<float> row(length);
+            std::size_t end = std::min<std::size_t>(height, (index + 1) * chunk);
+
+            for (std::size_t y = index * chunk; y < end; ++y)
+            {
+                const float* weights = &rows.weights[y * rows.stride];
+                const float* input = &filtered[static_cast<std::size_t>(rows.first[y]) * length];
+
+                for (std::size_t i = 0; i < length; i += 4)
+                {
+                    Float4 sum = splat(0.f);
+
+                    for (unsigned int tap = 0; tap < rows.count[y]; ++tap)
+                        sum = multiplyAdd(sum, splat(weights[tap]), load(input + tap * length + i));
+
+                    store(&row[i], sum);
+                }
+
+                unpremultiplyRow(&row[0], width, destination + y * length);
+            }
+        });
+    }
+}
@@ -28,6 +28,227 @@
 #include <DSFMLC/Graphics/Shader.h>
 #include <DSFMLC/Graphics/ShaderStruct.h>
 #include <DSFMLC/Graphics/TextureStruct.h>
+#include <DSFMLC/Graphics/GLFunctions.hpp>
+#include <DSFMLC/Graphics/ShaderCache.hpp>
+#include <DSFMLC/Graphics/ShaderLoader.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    //Binding points are global, so each uniform block gets its own and gives it back when its shader is destroyed
+    std::mutex blockBindingMutex;
+    GLuint nextBlockBinding = 0;
+    std::vector<GLuint> freeBlockBindings;
+
+    bool acquireBlockBinding(GLuint maxBindings, GLuint& binding)
+    {
+        std::lock_guard<std::mutex> lock(blockBindingMutex);
+
+        if (!freeBlockBindings.empty())
+        {
+            binding = freeBlockBindings.back();
+            freeBlockBindings.pop_back();
+            return true;
+        }
+
+        if (nextBlockBinding >= maxBindings)
+            return false;
+
+        binding = nextBlockBinding++;
+        return true;
+    }
+
+    void releaseBlockBinding(GLuint binding)
+    {
+        std::lock_guard<std::mutex> lock(blockBindingMutex);
+        freeBlockBindings.push_back(binding);
+    }
+
+    //Uniform locations belong to the previous program once a shader is reloaded
+    DBool finishLoading(sfShader* shader, bool success)
+    {
+        for (std::size_t i = 0; i < shader->Uniforms.size(); ++i)
+            shader->Uniforms[i].resolved = false;
+
+        for (std::size_t i = 0; i < shader->UniformBlocks.size(); ++i)
+            shader->UniformBlocks[i].resolved = false;
+
+        return success?DTrue:DFalse;
+    }
+
+    //Read a whole shader file, so that its source can be looked up in the program cache
+    bool readFile(const std::string& filename, std::string& contents)
+    {
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        if (!file)
+            return false;
+
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        return !file.bad();
+    }
+
+    //Load a single stage through the program cache
+    bool loadType(sfShader* shader, const std::string& source, sf::Shader::Type type)
+    {
+        std::string sources[3];
+        sources[type] = source;
+
+        return shadercache::load(shader->This, sources[sf::Shader::Vertex], sources[sf::Shader::Geometry],
+                                 sources[sf::Shader::Fragment]);
+    }
+
+    //Make a program current for the lifetime of the binder, like sf::Shader does for its uniforms
+    class ProgramBinder
+    {
+    public:
+        explicit ProgramBinder(GLuint program) :
+        m_program(program),
+        m_previous(0)
+        {
+            glGetIntegerv(GL_CURRENT_PROGRAM, &m_previous);
+
+            if (static_cast<GLuint>(m_previous) != m_program)
+                glext::useProgram(m_program);
+        }
+
+        ~ProgramBinder()
+        {
+            if (static_cast<GLuint>(m_previous) != m_program)
+                glext::useProgram(m_previous);
+        }
+
+    private:
+        GLuint m_program;
+        GLint m_previous;
+    };
+
+    //Get the location of a uniform in the current program, looking it up the first time
+    GLint getLocation(sfShaderUniform& uniform, GLuint program)
+    {
+        if (!uniform.resolved)
+        {
+            uniform.location = glext::getUniformLocation(program, uniform.name.c_str());
+            uniform.resolved = true;
+
+            if (uniform.location == -1)
+                sf::err() << "Uniform \"" << uniform.name << "\" not found in shader" << std::endl;
+        }
+
+        return uniform.location;
+    }
+
+    //Set a uniform through its handle, making the program current only for the upload.
+    //Without an active context, the name is passed on to SFML instead.
+    template <typename Fallback, typename Upload>
+    void setUniform(sfShader* shader, DUint handle, Fallback fallback, Upload upload)
+    {
+        if (handle >= shader->Uniforms.size())
+            return;
+
+        sfShaderUniform& uniform = shader->Uniforms[handle];
+
+        if (!sf::Context::getActiveContext() || !glext::hasUniforms())
+        {
+            fallback(uniform.name);
+            return;
+        }
+
+        GLuint program = shader->This.getNativeHandle();
+        if (!program)
+            return;
+
+        GLint location = getLocation(uniform, program);
+        if (location == -1)
+            return;
+
+        ProgramBinder binder(program);
+        upload(location);
+    }
+
+    //Size in bytes of a single value of a batched uniform
+    std::size_t getUniformSize(DUint type)
+    {
+        switch (type)
+        {
+            case sfUniformFloat: return sizeof(GLfloat);
+            case sfUniformVec2: return 2 * sizeof(GLfloat);
+            case sfUniformVec3: return 3 * sizeof(GLfloat);
+            case sfUniformVec4: return 4 * sizeof(GLfloat);
+            case sfUniformInt: return sizeof(GLint);
+            case sfUniformIvec2: return 2 * sizeof(GLint);
+            case sfUniformIvec3: return 3 * sizeof(GLint);
+            case sfUniformIvec4: return 4 * sizeof(GLint);
+            case sfUniformMat3: return 9 * sizeof(GLfloat);
+            case sfUniformMat4: return 16 * sizeof(GLfloat);
+            default: return 0;
+        }
+    }
+
+    //Upload a batched uniform while its program is current
+    void uploadUniform(GLint location, const sfUniformRecord& record, const void* value)
+    {
+        GLsizei count = static_cast<GLsizei>(record.count);
+        const GLfloat* floats = static_cast<const GLfloat*>(value);
+        const GLint* ints = static_cast<const GLint*>(value);
+
+        switch (record.type)
+        {
+            case sfUniformFloat: glext::uniform1fv(location, count, floats); break;
+            case sfUniformVec2: glext::uniform2fv(location, count, floats); break;
+            case sfUniformVec3: glext::uniform3fv(location, count, floats); break;
+            case sfUniformVec4: glext::uniform4fv(location, count, floats); break;
+            case sfUniformInt: glext::uniform1iv(location, count, ints); break;
+            case sfUniformIvec2: glext::uniform2iv(location, count, ints); break;
+            case sfUniformIvec3: glext::uniform3iv(location, count, ints); break;
+            case sfUniformIvec4: glext::uniform4iv(location, count, ints); break;
+            case sfUniformMat3: glext::uniformMatrix3fv(location, count, GL_FALSE, floats); break;
+            case sfUniformMat4: glext::uniformMatrix4fv(location, count, GL_FALSE, floats); break;
+            default: break;
+        }
+    }
+
+    //Set a batched uniform through sf::Shader, which has no int array setters
+    void setUniformFallback(sf::Shader& shader, const std::string& name, const sfUniformRecord& record, const void* value)
+    {
+        const float* floats = static_cast<const float*>(value);
+        const int* ints = static_cast<const int*>(value);
+
+        switch (record.type)
+        {
+            case sfUniformFloat: shader.setUniformArray(name, floats, record.count); return;
+            case sfUniformVec2: shader.setUniformArray(name, static_cast<const sf::Glsl::Vec2*>(value), record.count); return;
+            case sfUniformVec3: shader.setUniformArray(name, static_cast<const sf::Glsl::Vec3*>(value), record.count); return;
+            case sfUniformVec4: shader.setUniformArray(name, static_cast<const sf::Glsl::Vec4*>(value), record.count); return;
+            case sfUniformMat3: shader.setUniformArray(name, static_cast<const sf::Glsl::Mat3*>(value), record.count); return;
+            case sfUniformMat4: shader.setUniformArray(name, static_cast<const sf::Glsl::Mat4*>(value), record.count); return;
+            default: break;
+        }
+
+        for (DUint i = 0; i < record.count; ++i)
+        {
+            std::string element = record.count > 1 ? name + "[" + std::to_string(i) + "]" : name;
+
+            switch (record.type)
+            {
+                case sfUniformInt: shader.setUniform(element, ints[i]); break;
+                case sfUniformIvec2: shader.setUniform(element, sf::Glsl::Ivec2(ints[2 * i], ints[2 * i + 1])); break;
+                case sfUniformIvec3: shader.setUniform(element, sf::Glsl::Ivec3(ints[3 * i], ints[3 * i + 1], ints[3 * i + 2])); break;
+                case sfUniformIvec4: shader.setUniform(element, sf::Glsl::Ivec4(ints[4 * i], ints[4 * i + 1], ints[4 * i + 2], ints[4 * i + 3])); break;
+                default: break;
+            }
+        }
+    }
+}
 
 sfShader* sfShader_construct(void)
 {
@@ -36,94 +257,178 @@ sfShader* sfShader_construct(void)
 
 DBool sfShader_loadTypeFromFile(sfShader* shader, const char* shaderFilename, size_t shaderFilenameLength, DInt type)
 {
+    waitForPendingLoad(shader);
+
     sf::Shader::Type shaderType = static_cast<sf::Shader::Type>(type);
+    std::string filename(shaderFilename, shaderFilenameLength);
+    std::string source;
 
-    bool success = shader->This.loadFromFile(std::string(shaderFilename, shaderFilenameLength), shaderType);
+    bool success;
+    if (shadercache::isEnabled() && readFile(filename, source))
+        success = loadType(shader, source, shaderType);
+    else
+        success = shader->This.loadFromFile(filename, shaderType);
 
-    return success?DTrue:DFalse;
+    return finishLoading(shader, success);
 }
 
 DBool sfShader_loadVertexAndFragmentFromFile(sfShader* shader, const char* vertexFilename, size_t vertexFilenameLength, const char* fragmentFilename, size_t fragmentFilenameLength)
 {
-    bool success = shader->This.loadFromFile(std::string(vertexFilename, vertexFilenameLength),
-            			std::string(fragmentFilename, fragmentFilenameLength));
+    waitForPendingLoad(shader);
 
-    return success?DTrue:DFalse;
+    std::string vertexFile(vertexFilename, vertexFilenameLength);
+    std::string fragmentFile(fragmentFilename, fragmentFilenameLength);
+    std::string vertex, fragment;
+
+    bool success;
+    if (shadercache::isEnabled() && readFile(vertexFile, vertex) && readFile(fragmentFile, fragment))
+        success = shadercache::load(shader->This, vertex, std::string(), fragment);
+    else
+        success = shader->This.loadFromFile(vertexFile, fragmentFile);
+
+    return finishLoading(shader, success);
 }
 
 DBool sfShader_loadAllFromFile(sfShader* shader, const char* vertexFilename, size_t vertexFilenameLength, const char* geometryFilename, size_t geometryFilenameLength, const char* fragmentFilename, size_t fragmentFilenameLength)
 {
-    bool success = shader->This.loadFromFile(std::string(vertexFilename, vertexFilenameLength),
-                        std::string(geometryFilename, geometryFilenameLength),
-            			std::string(fragmentFilename, fragmentFilenameLength));
+    waitForPendingLoad(shader);
+
+    std::string vertexFile(vertexFilename, vertexFilenameLength);
+    std::string geometryFile(geometryFilename, geometryFilenameLength);
+    std::string fragmentFile(fragmentFilename, fragmentFilenameLength);
+    std::string vertex, geometry, fragment;
+
+    bool success;
+    if (shadercache::isEnabled() && readFile(vertexFile, vertex) && readFile(geometryFile, geometry) &&
+        readFile(fragmentFile, fragment))
+        success = shadercache::load(shader->This, vertex, geometry, fragment);
+    else
+        success = shader->This.loadFromFile(vertexFile, geometryFile, fragmentFile);
 
-    return success?DTrue:DFalse;
+    return finishLoading(shader, success);
 }
 
 DBool sfShader_loadTypeFromMemory(sfShader* shader, const char* shaderSource, size_t shaderSourceLength, DInt type)
 {
+    waitForPendingLoad(shader);
+
     sf::Shader::Type shaderType = static_cast<sf::Shader::Type>(type);
+    std::string source(shaderSource, shaderSourceLength);
 
-    bool success = shader->This.loadFromMemory(std::string(shaderSource, shaderSourceLength), shaderType);
+    bool success;
+    if (shadercache::isEnabled())
+        success = loadType(shader, source, shaderType);
+    else
+        success = shader->This.loadFromMemory(source, shaderType);
 
-    return success?DTrue:DFalse;
+    return finishLoading(shader, success);
 }
 
 DBool sfShader_loadVertexAndFragmentFromMemory(sfShader* shader, const char* vertexSource, size_t vertexSourceLength, const char* fragmentSource, size_t fragmentSourceLength)
 {
-    bool success = shader->This.loadFromMemory(std::string(vertexSource, vertexSourceLength),
-            			std::string(fragmentSource, fragmentSourceLength));
+    waitForPendingLoad(shader);
+
+    std::string vertex(vertexSource, vertexSourceLength);
+    std::string fragment(fragmentSource, fragmentSourceLength);
+
+    bool success;
+    if (shadercache::isEnabled())
+        success = shadercache::load(shader->This, vertex, std::string(), fragment);
+    else
+        success = shader->This.loadFromMemory(vertex, fragment);
 
-    return success?DTrue:DFalse;
+    return finishLoading(shader, success);
 }
 
 DBool sfShader_loadAllFromMemory(sfShader* shader, const char* vertexSource, size_t vertexSourceLength, const char* geometrySource, size_t geometrySourceLength,const char* fragmentSource, size_t fragmentSourceLength)
 {
-    bool success = shader->This.loadFromFile(std::string(vertexSource, vertexSourceLength),
-                        std::string(geometrySource, geometrySourceLength),
-            			std::string(fragmentSource, fragmentSourceLength));
+    waitForPendingLoad(shader);
 
-    return success?DTrue:DFalse;
+    std::string vertex(vertexSource, vertexSourceLength);
+    std::string geometry(geometrySource, geometrySourceLength);
+    std::string fragment(fragmentSource, fragmentSourceLength);
+
+    bool success;
+    if (shadercache::isEnabled())
+        success = shadercache::load(shader->This, vertex, geometry, fragment);
+    else
+        success = shader->This.loadFromMemory(vertex, geometry, fragment);
+
+    return finishLoading(shader, success);
 }
 
 DBool sfShader_loadTypeFromStream(sfShader* shader, DStream* shaderStream, DInt type)
 {
+    waitForPendingLoad(shader);
+
     sf::Shader::Type shaderType = static_cast<sf::Shader::Type>(type);
 
     sfmlStream stream(shaderStream);
 
     bool success = shader->This.loadFromStream(stream, shaderType);
 
-    return success?DTrue:DFalse;
+    return finishLoading(shader, success);
 }
 
 DBool sfShader_loadVertexAndFragmentFromStream(sfShader* shader, DStream* vertexStream, DStream* fragmentStream)
 {
+    waitForPendingLoad(shader);
+
     sfmlStream vStream(vertexStream);
     sfmlStream fStream(fragmentStream);
     bool success = shader->This.loadFromStream(vStream, fStream);
 
-    return success?DTrue:DFalse;
+    return finishLoading(shader, success);
 
 }
 
 DBool sfShader_loadAllFromStream(sfShader* shader, DStream* vertexStream, DStream* geometryStream, DStream* fragmentStream)
 {
+    waitForPendingLoad(shader);
+
     sfmlStream vStream(vertexStream);
     sfmlStream gStream(geometryStream);
     sfmlStream fStream(fragmentStream);
     bool success = shader->This.loadFromStream(vStream, gStream, fStream);
 
-    return success?DTrue:DFalse;
+    return finishLoading(shader, success);
 }
 
 void sfShader_destroy(sfShader* shader)
 {
+    waitForPendingLoad(shader);
+
+    bool hasBuffers = false;
+    for (std::size_t i = 0; i < shader->UniformBlocks.size(); ++i)
+        hasBuffers = hasBuffers || shader->UniformBlocks[i].buffer;
+
+    if (hasBuffers)
+    {
+        std::unique_ptr<sf::Context> context;
+        if (!sf::Context::getActiveContext())
+            context.reset(new sf::Context);
+
+        for (std::size_t i = 0; i < shader->UniformBlocks.size(); ++i)
+        {
+            if (shader->UniformBlocks[i].buffer)
+                glext::deleteBuffers(1, &shader->UniformBlocks[i].buffer);
+        }
+    }
+
+    for (std::size_t i = 0; i < shader->UniformBlocks.size(); ++i)
+    {
+        if (shader->UniformBlocks[i].binding != GL_INVALID_INDEX)
+            releaseBlockBinding(shader->UniformBlocks[i].binding);
+    }
+
     delete shader;
 }
 
 void sfShader_bind(const sfShader* shader)
 {
+    if (shader)
+        waitForPendingLoad(shader);
+
     sf::Shader::bind(shader ? &shader->This : 0);
 }
 
@@ -137,59 +442,92 @@ DBool sfShader_isGeometryAvailable(void)
     return sf::Shader::isGeometryAvailable() ? DTrue : DFalse;
 }
 
+DUint sfShader_getUniformLocation(sfShader* shader, const char* name, size_t length)
+{
+    waitForPendingLoad(shader);
+
+    for (std::size_t i = 0; i < shader->Uniforms.size(); ++i)
+    {
+        const std::string& uniformName = shader->Uniforms[i].name;
+        if (uniformName.size() == length && uniformName.compare(0, length, name, length) == 0)
+            return static_cast<DUint>(i);
+    }
+
+    sfShaderUniform uniform;
+    uniform.name.assign(name, length);
+    uniform.location = -1;
+    uniform.resolved = false;
+    shader->Uniforms.push_back(uniform);
+
+    return static_cast<DUint>(shader->Uniforms.size() - 1);
+}
+
 void sfShader_setFloatUniform(sfShader* shader, const char* name, size_t length, float x)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), x);
 }
 
 void sfShader_setVec2Uniform(sfShader* shader, const char* name, size_t length, const sf::Glsl::Vec2* vec2)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), *vec2);
 }
 
 void sfShader_setVec3Uniform(sfShader* shader, const char* name, size_t length, const sf::Glsl::Vec3* vec3)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), *vec3);
 }
 
 void sfShader_setVec4Uniform(sfShader* shader, const char* name, size_t length, const sf::Glsl::Vec4* vec4)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), *vec4);
 }
 
 void sfShader_setIntUniform(sfShader* shader, const char* name, size_t length, int x)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), x);
 }
 
 void sfShader_setIvec2Uniform(sfShader* shader, const char* name, size_t length, const sf::Glsl::Ivec2* ivec2)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), *ivec2);
 }
 
 void sfShader_setIvec3Uniform(sfShader* shader, const char* name, size_t length, const sf::Glsl::Ivec3* ivec3)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), *ivec3);
 }
 
 void sfShader_setIvec4Uniform(sfShader* shader, const char* name, size_t length, const sf::Glsl::Ivec4* ivec4)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), *ivec4);
 }
 
 void sfShader_setBoolUniform(sfShader* shader, const char* name, size_t length, DBool x)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), static_cast<bool>(x));
 }
 
 void sfShader_setBvec2Uniform(sfShader* shader, const char* name, size_t length, DBool x, DBool y)
 {
+    waitForPendingLoad(shader);
+
     shader->This.setUniform(std::string(name, length),
                    sf::Glsl::Bvec2(static_cast<bool>(x), static_cast<bool>(y)));
 }
 
 void sfShader_setBvec3Uniform(sfShader* shader, const char* name, size_t length, DBool x, DBool y, DBool z)
 {
+    waitForPendingLoad(shader);
+
     shader->This.setUniform(std::string(name, length),
                     sf::Glsl::Bvec3(static_cast<bool>(x), static_cast<bool>(y),
                                     static_cast<bool>(z)));
@@ -197,6 +535,8 @@ void sfShader_setBvec3Uniform(sfShader* shader, const char* name, size_t length,
 
 void sfShader_setBvec4Uniform(sfShader* shader, const char* name, size_t length, DBool x, DBool y, DBool z, DBool w)
 {
+    waitForPendingLoad(shader);
+
     shader->This.setUniform(std::string(name, length),
                    sf::Glsl::Bvec4(static_cast<bool>(x), static_cast<bool>(y),
                                    static_cast<bool>(z), static_cast<bool>(w)));
@@ -204,92 +544,568 @@ void sfShader_setBvec4Uniform(sfShader* shader, const char* name, size_t length,
 
 void sfShader_setMat3Uniform(sfShader* shader, const char* name, size_t length, const sf::Glsl::Mat3* mat3)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length),*mat3);
 }
 
 void sfShader_setMat4Uniform(sfShader* shader, const char* name, size_t length, const sf::Glsl::Mat4* mat4)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length),*mat4);
 }
 
 void sfShader_setTextureUniform(sfShader* shader, const char* name, size_t length, const sfTexture* texture)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), *texture->This);
 }
 
 void sfShader_setCurrentTextureUniform(sfShader* shader, const char* name, size_t length)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniform(std::string(name, length), sf::Shader::CurrentTextureType());
 }
 
 void sfShader_setFloatArrayUniform(sfShader* shader, const char* name, size_t nlength, const float* array, size_t alength)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniformArray(std::string(name, nlength), array, alength);
 }
 
 void sfShader_setVec2ArrayUniform(sfShader* shader, const char* name, size_t nlength, const sf::Glsl::Vec2* array, size_t alength)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniformArray(std::string(name, nlength), array, alength);
 }
 
 void sfShader_setVec3ArrayUniform(sfShader* shader, const char* name, size_t nlength, const sf::Glsl::Vec3* array, size_t alength)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniformArray(std::string(name, nlength), array, alength);
 }
 
 void sfShader_setVec4ArrayUniform(sfShader* shader, const char* name, size_t nlength, const sf::Glsl::Vec4* array, size_t alength)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniformArray(std::string(name, nlength), array, alength);
 }
 
 void sfShader_setMat3ArrayUniform(sfShader* shader, const char* name, size_t nlength, const sf::Glsl::Mat3* array, size_t alength)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniformArray(std::string(name, nlength), array, alength);
 }
 
 void sfShader_setMat4ArrayUniform(sfShader* shader, const char* name, size_t nlength, const sf::Glsl::Mat4* array, size_t alength)
 {
+    waitForPendingLoad(shader);
     shader->This.setUniformArray(std::string(name, nlength), array, alength);
 }
 
+void sfShader_setFloatUniformLocation(sfShader* shader, DUint location, float x)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, x); },
+        [&](GLint uniform) { glext::uniform1fv(uniform, 1, &x); });
+}
+
+void sfShader_setVec2UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec2* vec2)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, *vec2); },
+        [&](GLint uniform) { glext::uniform2fv(uniform, 1, &vec2->x); });
+}
+
+void sfShader_setVec3UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec3* vec3)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, *vec3); },
+        [&](GLint uniform) { glext::uniform3fv(uniform, 1, &vec3->x); });
+}
+
+void sfShader_setVec4UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec4* vec4)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, *vec4); },
+        [&](GLint uniform) { glext::uniform4fv(uniform, 1, &vec4->x); });
+}
+
+void sfShader_setIntUniformLocation(sfShader* shader, DUint location, int x)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, x); },
+        [&](GLint uniform) { glext::uniform1iv(uniform, 1, &x); });
+}
+
+void sfShader_setIvec2UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Ivec2* ivec2)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, *ivec2); },
+        [&](GLint uniform) { glext::uniform2iv(uniform, 1, &ivec2->x); });
+}
+
+void sfShader_setIvec3UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Ivec3* ivec3)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, *ivec3); },
+        [&](GLint uniform) { glext::uniform3iv(uniform, 1, &ivec3->x); });
+}
+
+void sfShader_setIvec4UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Ivec4* ivec4)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, *ivec4); },
+        [&](GLint uniform) { glext::uniform4iv(uniform, 1, &ivec4->x); });
+}
+
+void sfShader_setBoolUniformLocation(sfShader* shader, DUint location, DBool x)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, static_cast<bool>(x)); },
+        [&](GLint uniform) { GLint value = x ? 1 : 0; glext::uniform1iv(uniform, 1, &value); });
+}
+
+void sfShader_setBvec2UniformLocation(sfShader* shader, DUint location, DBool x, DBool y)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name)
+        {
+            shader->This.setUniform(name, sf::Glsl::Bvec2(static_cast<bool>(x), static_cast<bool>(y)));
+        },
+        [&](GLint uniform)
+        {
+            GLint values[2] = {x ? 1 : 0, y ? 1 : 0};
+            glext::uniform2iv(uniform, 1, values);
+        });
+}
+
+void sfShader_setBvec3UniformLocation(sfShader* shader, DUint location, DBool x, DBool y, DBool z)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name)
+        {
+            shader->This.setUniform(name, sf::Glsl::Bvec3(static_cast<bool>(x), static_cast<bool>(y),
+                                                          static_cast<bool>(z)));
+        },
+        [&](GLint uniform)
+        {
+            GLint values[3] = {x ? 1 : 0, y ? 1 : 0, z ? 1 : 0};
+            glext::uniform3iv(uniform, 1, values);
+        });
+}
+
+void sfShader_setBvec4UniformLocation(sfShader* shader, DUint location, DBool x, DBool y, DBool z, DBool w)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name)
+        {
+            shader->This.setUniform(name, sf::Glsl::Bvec4(static_cast<bool>(x), static_cast<bool>(y),
+                                                          static_cast<bool>(z), static_cast<bool>(w)));
+        },
+        [&](GLint uniform)
+        {
+            GLint values[4] = {x ? 1 : 0, y ? 1 : 0, z ? 1 : 0, w ? 1 : 0};
+            glext::uniform4iv(uniform, 1, values);
+        });
+}
+
+void sfShader_setMat3UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Mat3* mat3)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, *mat3); },
+        [&](GLint uniform) { glext::uniformMatrix3fv(uniform, 1, GL_FALSE, mat3->array); });
+}
+
+void sfShader_setMat4UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Mat4* mat4)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniform(name, *mat4); },
+        [&](GLint uniform) { glext::uniformMatrix4fv(uniform, 1, GL_FALSE, mat4->array); });
+}
+
+void sfShader_setTextureUniformLocation(sfShader* shader, DUint location, const sfTexture* texture)
+{
+    waitForPendingLoad(shader);
+
+    //Texture units are managed by sf::Shader, so textures always go through the stored name
+    if (location < shader->Uniforms.size())
+        shader->This.setUniform(shader->Uniforms[location].name, *texture->This);
+}
+
+void sfShader_setCurrentTextureUniformLocation(sfShader* shader, DUint location)
+{
+    waitForPendingLoad(shader);
+
+    if (location < shader->Uniforms.size())
+        shader->This.setUniform(shader->Uniforms[location].name, sf::Shader::CurrentTextureType());
+}
+
+void sfShader_setFloatArrayUniformLocation(sfShader* shader, DUint location, const float* array, size_t length)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniformArray(name, array, length); },
+        [&](GLint uniform) { glext::uniform1fv(uniform, static_cast<GLsizei>(length), array); });
+}
+
+void sfShader_setVec2ArrayUniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec2* array, size_t length)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniformArray(name, array, length); },
+        [&](GLint uniform) { glext::uniform2fv(uniform, static_cast<GLsizei>(length), &array->x); });
+}
+
+void sfShader_setVec3ArrayUniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec3* array, size_t length)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniformArray(name, array, length); },
+        [&](GLint uniform) { glext::uniform3fv(uniform, static_cast<GLsizei>(length), &array->x); });
+}
+
+void sfShader_setVec4ArrayUniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec4* array, size_t length)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniformArray(name, array, length); },
+        [&](GLint uniform) { glext::uniform4fv(uniform, static_cast<GLsizei>(length), &array->x); });
+}
+
+void sfShader_setMat3ArrayUniformLocation(sfShader* shader, DUint location, const sf::Glsl::Mat3* array, size_t length)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniformArray(name, array, length); },
+        [&](GLint uniform) { glext::uniformMatrix3fv(uniform, static_cast<GLsizei>(length), GL_FALSE, array->array); });
+}
+
+void sfShader_setMat4ArrayUniformLocation(sfShader* shader, DUint location, const sf::Glsl::Mat4* array, size_t length)
+{
+    waitForPendingLoad(shader);
+
+    setUniform(shader, location,
+        [&](const std::string& name) { shader->This.setUniformArray(name, array, length); },
+        [&](GLint uniform) { glext::uniformMatrix4fv(uniform, static_cast<GLsizei>(length), GL_FALSE, array->array); });
+}
+
+void sfShader_setUniformBatch(sfShader* shader, const sfUniformRecord* records, size_t recordCount, const void* data, size_t dataSize)
+{
+    waitForPendingLoad(shader);
+
+    const char* bytes = static_cast<const char*>(data);
+    bool direct = sf::Context::getActiveContext() && glext::hasUniforms();
+
+    GLuint program = shader->This.getNativeHandle();
+    if (direct && !program)
+        return;
+
+    //The program stays current for the whole batch instead of once per uniform
+    std::unique_ptr<ProgramBinder> binder;
+    if (direct)
+        binder.reset(new ProgramBinder(program));
+
+    for (size_t i = 0; i < recordCount; ++i)
+    {
+        const sfUniformRecord& record = records[i];
+
+        if (record.location >= shader->Uniforms.size())
+            continue;
+
+        sfShaderUniform& uniform = shader->Uniforms[record.location];
+        std::size_t size = getUniformSize(record.type) * record.count;
+
+        if (!size || record.offset > dataSize || size > dataSize - record.offset)
+        {
+            sf::err() << "Invalid value for uniform \"" << uniform.name << "\" in uniform batch" << std::endl;
+            continue;
+        }
+
+        if (!direct)
+        {
+            setUniformFallback(shader->This, uniform.name, record, bytes + record.offset);
+            continue;
+        }
+
+        GLint location = getLocation(uniform, program);
+        if (location != -1)
+            uploadUniform(location, record, bytes + record.offset);
+    }
+}
+
+DUint sfShader_getUniformBlock(sfShader* shader, const char* name, size_t length)
+{
+    waitForPendingLoad(shader);
+
+    for (std::size_t i = 0; i < shader->UniformBlocks.size(); ++i)
+    {
+        const std::string& blockName = shader->UniformBlocks[i].name;
+        if (blockName.size() == length && blockName.compare(0, length, name, length) == 0)
+            return static_cast<DUint>(i);
+    }
+
+    sfShaderUniformBlock block;
+    block.name.assign(name, length);
+    block.index = GL_INVALID_INDEX;
+    block.resolved = false;
+    block.binding = GL_INVALID_INDEX;
+    block.buffer = 0;
+    block.size = 0;
+    shader->UniformBlocks.push_back(block);
+
+    return static_cast<DUint>(shader->UniformBlocks.size() - 1);
+}
+
+DBool sfShader_setUniformBlock(sfShader* shader, DUint handle, const void* data, size_t size)
+{
+    waitForPendingLoad(shader);
+
+    if (handle >= shader->UniformBlocks.size())
+        return DFalse;
+
+    if (!sf::Context::getActiveContext() || !glext::hasUniformBuffers())
+    {
+        sf::err() << "Failed to set uniform block: uniform buffer objects are not supported" << std::endl;
+        return DFalse;
+    }
+
+    GLuint program = shader->This.getNativeHandle();
+    if (!program)
+        return DFalse;
+
+    sfShaderUniformBlock& block = shader->UniformBlocks[handle];
+
+    if (block.binding == GL_INVALID_INDEX)
+    {
+        GLint maxBindings = 0;
+        glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &maxBindings);
+
+        if (!acquireBlockBinding(static_cast<GLuint>(std::max(maxBindings, 0)), block.binding))
+        {
+            sf::err() << "Failed to set uniform block \"" << block.name << "\": all " << maxBindings
+                      << " uniform buffer bindings are used by other blocks" << std::endl;
+            return DFalse;
+        }
+    }
+
+    if (!block.resolved)
+    {
+        block.index = glext::getUniformBlockIndex(program, block.name.c_str());
+        block.resolved = true;
+
+        if (block.index == GL_INVALID_INDEX)
+            sf::err() << "Uniform block \"" << block.name << "\" not found in shader" << std::endl;
+        else
+            glext::uniformBlockBinding(program, block.index, block.binding);
+    }
+
+    if (block.index == GL_INVALID_INDEX)
+        return DFalse;
+
+    if (!block.buffer)
+        glext::genBuffers(1, &block.buffer);
+
+    glext::bindBuffer(GL_UNIFORM_BUFFER, block.buffer);
+
+    if (size != block.size)
+    {
+        glext::bufferData(GL_UNIFORM_BUFFER, static_cast<glext::GLsizeiptr>(size), data, GL_DYNAMIC_DRAW);
+        block.size = size;
+    }
+    else
+        glext::bufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<glext::GLsizeiptr>(size), data);
+
+    glext::bindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    //Indexed bindings are not shared between contexts, so bind again on every update
+    glext::bindBufferBase(GL_UNIFORM_BUFFER, block.binding, block.buffer);
+
+    return DTrue;
+}
+
+DBool sfShader_isUniformBufferAvailable(void)
+{
+    std::unique_ptr<sf::Context> context;
+    if (!sf::Context::getActiveContext())
+        context.reset(new sf::Context);
+
+    return glext::hasUniformBuffers() ? DTrue : DFalse;
+}
+
+void sfShader_setBinaryCacheDirectory(const char* directory, size_t length)
+{
+    shadercache::setDirectory(std::string(directory, length));
+}
+
+void sfShader_getBinaryCacheStatistics(DUint* hits, DUint* misses)
+{
+    unsigned int hitCount = 0;
+    unsigned int missCount = 0;
+    shadercache::getStatistics(hitCount, missCount);
+
+    *hits = hitCount;
+    *misses = missCount;
+}
+
+void sfShader_resetBinaryCacheStatistics(void)
+{
+    shadercache::resetStatistics();
+}
+
+DBool sfShader_isBinaryCacheAvailable(void)
+{
+    std::unique_ptr<sf::Context> context;
+    if (!sf::Context::getActiveContext())
+        context.reset(new sf::Context);
+
+    return glext::hasProgramBinaries() ? DTrue : DFalse;
+}
+
+sfShaderLoad* sfShader_loadFromMemoryAsync(sfShader* shader, const char* vertexSource, size_t vertexSourceLength, const char* geometrySource, size_t geometrySourceLength, const char* fragmentSource, size_t fragmentSourceLength)
+{
+    waitForPendingLoad(shader);
+
+    std::string vertex(vertexSource, vertexSourceLength);
+    std::string geometry(geometrySource, geometrySourceLength);
+    std::string fragment(fragmentSource, fragmentSourceLength);
+
+    sfShaderLoad* load = new sfShaderLoad;
+    load->Result = shaderloader::enqueue([shader, vertex, geometry, fragment]()
+    {
+        return finishLoading(shader, shadercache::load(shader->This, vertex, geometry, fragment)) == DTrue;
+    });
+
+    shader->PendingLoad = load->Result;
+
+    return load;
+}
+
+sfShaderLoad* sfShader_loadFromFileAsync(sfShader* shader, const char* vertexFilename, size_t vertexFilenameLength, const char* geometryFilename, size_t geometryFilenameLength, const char* fragmentFilename, size_t fragmentFilenameLength)
+{
+    waitForPendingLoad(shader);
+
+    std::string vertexFile(vertexFilename, vertexFilenameLength);
+    std::string geometryFile(geometryFilename, geometryFilenameLength);
+    std::string fragmentFile(fragmentFilename, fragmentFilenameLength);
+
+    sfShaderLoad* load = new sfShaderLoad;
+    load->Result = shaderloader::enqueue([shader, vertexFile, geometryFile, fragmentFile]()
+    {
+        //Files are read on the background thread too, an empty name means the stage isn't used
+        const std::string* files[3] = {&vertexFile, &geometryFile, &fragmentFile};
+        std::string sources[3];
+
+        for (int i = 0; i < 3; ++i)
+        {
+            if (!files[i]->empty() && !readFile(*files[i], sources[i]))
+            {
+                sf::err() << "Failed to open shader file \"" << *files[i] << "\"" << std::endl;
+                return finishLoading(shader, false) == DTrue;
+            }
+        }
+
+        return finishLoading(shader, shadercache::load(shader->This, sources[0], sources[1], sources[2])) == DTrue;
+    });
+
+    shader->PendingLoad = load->Result;
+
+    return load;
+}
+
+DBool sfShaderLoad_isReady(const sfShaderLoad* load)
+{
+    return (load->Result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) ? DTrue : DFalse;
+}
+
+DBool sfShaderLoad_wait(const sfShaderLoad* load)
+{
+    return load->Result.get() ? DTrue : DFalse;
+}
+
+void sfShaderLoad_destroy(sfShaderLoad* load)
+{
+    delete load;
+}
+
 /******************Deprecated******************/
 
 void sfShader_setFloatParameter(sfShader* shader, const char* name, size_t length , float x)
 {
+    waitForPendingLoad(shader);
     shader->This.setParameter(std::string(name, length), x);
 }
 
 void sfShader_setFloat2Parameter(sfShader* shader, const char* name, size_t length, float x, float y)
 {
+    waitForPendingLoad(shader);
     shader->This.setParameter(std::string(name, length), x, y);
 }
 
 void sfShader_setFloat3Parameter(sfShader* shader, const char* name, size_t length, float x, float y, float z)
 {
+    waitForPendingLoad(shader);
     shader->This.setParameter(std::string(name, length), x, y, z);
 }
 
 void sfShader_setFloat4Parameter(sfShader* shader, const char* name, size_t length, float x, float y, float z, float w)
 {
+    waitForPendingLoad(shader);
     shader->This.setParameter(std::string(name, length), x, y, z, w);
 }
 
 void sfShader_setColorParameter(sfShader* shader, const char* name, size_t length, DUbyte r, DUbyte g, DUbyte b, DUbyte a)
 {
+    waitForPendingLoad(shader);
     shader->This.setParameter(std::string(name, length), sf::Color(r, g, b, a));
 }
 
 void sfShader_setTransformParameter(sfShader* shader, const char* name, size_t length, float* transform)
 {
+    waitForPendingLoad(shader);
     shader->This.setParameter(std::string(name, length),*reinterpret_cast<sf::Transform*>(transform));
 }
 
 void sfShader_setTextureParameter(sfShader* shader, const char* name, size_t length, const sfTexture* texture)
 {
+    waitForPendingLoad(shader);
     shader->This.setParameter(std::string(name, length), *texture->This);
 }
 
 void sfShader_setCurrentTextureParameter(sfShader* shader, const char* name, size_t length)
 {
+    waitForPendingLoad(shader);
     shader->This.setParameter(std::string(name, length), sf::Shader::CurrentTextureType());
 }
@@ -30,6 +30,7 @@
 
 #include <DSFMLC/Graphics/Export.h>
 #include <DSFMLC/Graphics/Types.h>
+#include <DSFMLC/Graphics/UniformRecord.h>
 #include <DSFMLC/System/DStream.hpp>
 #include<SFML/Graphics/Glsl.hpp>
 #include <stddef.h>
@@ -64,6 +65,21 @@ DSFML_GRAPHICS_API DBool sfShader_loadVertexAndFragmentFromStream(sfShader* shad
 //Load the vertex, geometry, and fragment shaders from custom streams
 DSFML_GRAPHICS_API DBool sfShader_loadAllFromStream(sfShader* shader, DStream* vertexStream, DStream* geometryStream, DStream* fragmentStream);
 
+//Start loading the shaders from source code in memory on a background thread, an empty source means the stage isn't used
+DSFML_GRAPHICS_API sfShaderLoad* sfShader_loadFromMemoryAsync(sfShader* shader, const char* vertexSource, size_t vertexSourceLength, const char* geometrySource, size_t geometrySourceLength, const char* fragmentSource, size_t fragmentSourceLength);
+
+//Start loading the shaders from files on a background thread, an empty filename means the stage isn't used
+DSFML_GRAPHICS_API sfShaderLoad* sfShader_loadFromFileAsync(sfShader* shader, const char* vertexFilename, size_t vertexFilenameLength, const char* geometryFilename, size_t geometryFilenameLength, const char* fragmentFilename, size_t fragmentFilenameLength);
+
+//Tell whether or not a background load has finished
+DSFML_GRAPHICS_API DBool sfShaderLoad_isReady(const sfShaderLoad* load);
+
+//Wait for a background load to finish and tell whether or not it succeeded
+DSFML_GRAPHICS_API DBool sfShaderLoad_wait(const sfShaderLoad* load);
+
+//Destroy a background load handle, the load itself keeps running
+DSFML_GRAPHICS_API void sfShaderLoad_destroy(sfShaderLoad* load);
+
 //Destroy an existing shader
 DSFML_GRAPHICS_API void sfShader_destroy(sfShader* shader);
 
@@ -133,6 +149,99 @@ DSFML_GRAPHICS_API void sfShader_setMat3ArrayUniform(sfShader* shader, const cha
 //Specify values for mat4[] array uniform.
 DSFML_GRAPHICS_API void sfShader_setMat4ArrayUniform(sfShader* shader, const char* name, size_t nlength, const sf::Glsl::Mat4*, size_t alength);
 
+//Get a handle to a uniform, which can be used in place of its name
+DSFML_GRAPHICS_API DUint sfShader_getUniformLocation(sfShader* shader, const char* name, size_t length);
+
+//Specify value for float uniform by handle
+DSFML_GRAPHICS_API void sfShader_setFloatUniformLocation(sfShader* shader, DUint location, float x);
+
+//Specify value for vec2 uniform by handle
+DSFML_GRAPHICS_API void sfShader_setVec2UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec2* vec2);
+
+//Specify value for vec3 uniform by handle
+DSFML_GRAPHICS_API void sfShader_setVec3UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec3* vec3);
+
+//Specify value for vec4 uniform by handle
+DSFML_GRAPHICS_API void sfShader_setVec4UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec4* vec4);
+
+//Specify value for int uniform by handle
+DSFML_GRAPHICS_API void sfShader_setIntUniformLocation(sfShader* shader, DUint location, int x);
+
+//Specify value for ivec2 uniform by handle
+DSFML_GRAPHICS_API void sfShader_setIvec2UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Ivec2* ivec2);
+
+//Specify value for ivec3 uniform by handle
+DSFML_GRAPHICS_API void sfShader_setIvec3UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Ivec3* ivec3);
+
+//Specify value for ivec4 uniform by handle
+DSFML_GRAPHICS_API void sfShader_setIvec4UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Ivec4* ivec4);
+
+//Specify value for bool uniform by handle
+DSFML_GRAPHICS_API void sfShader_setBoolUniformLocation(sfShader* shader, DUint location, DBool x);
+
+//Specify value for bvec2 uniform by handle
+DSFML_GRAPHICS_API void sfShader_setBvec2UniformLocation(sfShader* shader, DUint location, DBool x, DBool y);
+
+//Specify value for bvec3 uniform by handle
+DSFML_GRAPHICS_API void sfShader_setBvec3UniformLocation(sfShader* shader, DUint location, DBool x, DBool y, DBool z);
+
+//Specify value for bvec4 uniform by handle
+DSFML_GRAPHICS_API void sfShader_setBvec4UniformLocation(sfShader* shader, DUint location, DBool x, DBool y, DBool z, DBool w);
+
+//Specify value for mat3 matrix by handle
+DSFML_GRAPHICS_API void sfShader_setMat3UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Mat3* mat3);
+
+//Specify value for mat4 matrix by handle
+DSFML_GRAPHICS_API void sfShader_setMat4UniformLocation(sfShader* shader, DUint location, const sf::Glsl::Mat4* mat4);
+
+//Specify a texture as sampler2D uniform by handle
+DSFML_GRAPHICS_API void sfShader_setTextureUniformLocation(sfShader* shader, DUint location, const sfTexture* texture);
+
+//Specify current texture as sampler2D uniform by handle
+DSFML_GRAPHICS_API void sfShader_setCurrentTextureUniformLocation(sfShader* shader, DUint location);
+
+//Specify values for float[] array uniform by handle
+DSFML_GRAPHICS_API void sfShader_setFloatArrayUniformLocation(sfShader* shader, DUint location, const float* array, size_t length);
+
+//Specify values for vec2[] array uniform by handle
+DSFML_GRAPHICS_API void sfShader_setVec2ArrayUniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec2* array, size_t length);
+
+//Specify values for vec3[] array uniform by handle
+DSFML_GRAPHICS_API void sfShader_setVec3ArrayUniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec3* array, size_t length);
+
+//Specify values for vec4[] array uniform by handle
+DSFML_GRAPHICS_API void sfShader_setVec4ArrayUniformLocation(sfShader* shader, DUint location, const sf::Glsl::Vec4* array, size_t length);
+
+//Specify values for mat3[] array uniform by handle
+DSFML_GRAPHICS_API void sfShader_setMat3ArrayUniformLocation(sfShader* shader, DUint location, const sf::Glsl::Mat3* array, size_t length);
+
+//Specify values for mat4[] array uniform by handle
+DSFML_GRAPHICS_API void sfShader_setMat4ArrayUniformLocation(sfShader* shader, DUint location, const sf::Glsl::Mat4* array, size_t length);
+
+//Upload a list of uniforms, whose values are packed in data, while binding the shader only once
+DSFML_GRAPHICS_API void sfShader_setUniformBatch(sfShader* shader, const sfUniformRecord* records, size_t recordCount, const void* data, size_t dataSize);
+
+//Get a handle to a uniform block
+DSFML_GRAPHICS_API DUint sfShader_getUniformBlock(sfShader* shader, const char* name, size_t length);
+
+//Upload the contents of a uniform block to its uniform buffer object
+DSFML_GRAPHICS_API DBool sfShader_setUniformBlock(sfShader* shader, DUint block, const void* data, size_t size);
+
+//Tell whether or not the system supports uniform buffer objects
+DSFML_GRAPHICS_API DBool sfShader_isUniformBufferAvailable(void);
+
+//Set the directory where linked programs are cached, an empty path disables the cache
+DSFML_GRAPHICS_API void sfShader_setBinaryCacheDirectory(const char* directory, size_t length);
+
+//Get the number of programs loaded from the cache and compiled from source
+DSFML_GRAPHICS_API void sfShader_getBinaryCacheStatistics(DUint* hits, DUint* misses);
+
+//Reset the program cache statistics
+DSFML_GRAPHICS_API void sfShader_resetBinaryCacheStatistics(void);
+
+//Tell whether or not the system supports program binaries, which the program cache needs
+DSFML_GRAPHICS_API DBool sfShader_isBinaryCacheAvailable(void);
+
 //Bind a shader for rendering (activate it)
 DSFML_GRAPHICS_API void sfShader_bind(const sfShader* shader);
 
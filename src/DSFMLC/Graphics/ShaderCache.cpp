@@ -0,0 +1,271 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/ShaderCache.hpp>
+#include <DSFMLC/Graphics/GLFunctions.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/Window/Context.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const char fileMagic[8] = {'D', 'S', 'F', 'M', 'L', 'S', 'P', 'B'};
+    const sf::Uint32 fileVersion = 1;
+
+    //Compiles quickly, so that sf::Shader owns a program the cached binary can be loaded into
+    const char placeholderSource[] = "void main() { gl_FragColor = vec4(0.0); }";
+
+    sf::Mutex mutex;
+    std::string cacheDirectory;
+
+    std::atomic<unsigned int> hitCount(0);
+    std::atomic<unsigned int> missCount(0);
+
+    //64 bit FNV-1a
+    sf::Uint64 hash(sf::Uint64 value, const void* data, std::size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            value ^= bytes[i];
+            value *= 1099511628211ULL;
+        }
+
+        return value;
+    }
+
+    sf::Uint64 hash(sf::Uint64 value, const std::string& text)
+    {
+        //Hashing the length keeps stages from running into each other
+        sf::Uint64 length = text.size();
+        value = hash(value, &length, sizeof(length));
+
+        return hash(value, text.data(), text.size());
+    }
+
+    sf::Uint64 hash(sf::Uint64 value, GLenum name)
+    {
+        const GLubyte* text = glGetString(name);
+
+        return hash(value, text ? std::string(reinterpret_cast<const char*>(text)) : std::string());
+    }
+
+    //A driver update invalidates the binaries it produced, so the driver is part of the key
+    sf::Uint64 computeKey(const std::string& vertex, const std::string& geometry, const std::string& fragment)
+    {
+        sf::Uint64 key = 14695981039346656037ULL;
+
+        key = hash(key, GL_VENDOR);
+        key = hash(key, GL_RENDERER);
+        key = hash(key, GL_VERSION);
+        key = hash(key, vertex);
+        key = hash(key, geometry);
+        key = hash(key, fragment);
+
+        return key;
+    }
+
+    std::string getPath(const std::string& directory, sf::Uint64 key)
+    {
+        char name[17];
+        std::sprintf(name, "%08x%08x", static_cast<unsigned int>(key >> 32), static_cast<unsigned int>(key));
+
+        char last = directory[directory.size() - 1];
+        bool separated = (last == '/') || (last == '\\');
+
+        return directory + (separated ? "" : "/") + name + ".bin";
+    }
+
+    //Compile the sources with the sf::Shader overload matching the stages that are used
+    bool compile(sf::Shader& shader, const std::string& vertex, const std::string& geometry, const std::string& fragment)
+    {
+        if (!geometry.empty())
+        {
+            if (vertex.empty() && fragment.empty())
+                return shader.loadFromMemory(geometry, sf::Shader::Geometry);
+
+            return shader.loadFromMemory(vertex, geometry, fragment);
+        }
+
+        if (vertex.empty())
+            return shader.loadFromMemory(fragment, sf::Shader::Fragment);
+
+        if (fragment.empty())
+            return shader.loadFromMemory(vertex, sf::Shader::Vertex);
+
+        return shader.loadFromMemory(vertex, fragment);
+    }
+
+    bool readBinary(const std::string& path, sf::Uint64 key, GLenum& format, std::vector<char>& binary)
+    {
+        std::ifstream file(path.c_str(), std::ios::binary);
+        if (!file)
+            return false;
+
+        char magic[8];
+        sf::Uint32 version = 0;
+        sf::Uint64 fileKey = 0;
+        sf::Uint32 fileFormat = 0;
+        sf::Uint32 length = 0;
+
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        file.read(reinterpret_cast<char*>(&fileKey), sizeof(fileKey));
+        file.read(reinterpret_cast<char*>(&fileFormat), sizeof(fileFormat));
+        file.read(reinterpret_cast<char*>(&length), sizeof(length));
+
+        if (!file || !std::equal(magic, magic + sizeof(magic), fileMagic) ||
+            (version != fileVersion) || (fileKey != key) || !length)
+            return false;
+
+        binary.resize(length);
+        file.read(&binary[0], length);
+
+        format = static_cast<GLenum>(fileFormat);
+
+        return static_cast<bool>(file);
+    }
+
+    void writeBinary(const std::string& path, sf::Uint64 key, GLuint program)
+    {
+        GLint length = 0;
+        glext::getProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLenum format = 0;
+        GLsizei written = 0;
+        glext::getProgramBinary(program, length, &written, &format, &binary[0]);
+        if (written <= 0)
+            return;
+
+        std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            sf::err() << "Failed to write shader cache file \"" << path << "\"" << std::endl;
+            return;
+        }
+
+        sf::Uint32 fileFormat = static_cast<sf::Uint32>(format);
+        sf::Uint32 fileLength = static_cast<sf::Uint32>(written);
+
+        file.write(fileMagic, sizeof(fileMagic));
+        file.write(reinterpret_cast<const char*>(&fileVersion), sizeof(fileVersion));
+        file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        file.write(reinterpret_cast<const char*>(&fileFormat), sizeof(fileFormat));
+        file.write(reinterpret_cast<const char*>(&fileLength), sizeof(fileLength));
+        file.write(&binary[0], written);
+    }
+
+    //Replace the program of the shader with a cached one, the driver may reject it after an update
+    bool loadBinary(sf::Shader& shader, GLenum format, const std::vector<char>& binary)
+    {
+        if (!shader.loadFromMemory(placeholderSource, sf::Shader::Fragment))
+            return false;
+
+        GLuint program = shader.getNativeHandle();
+        glext::programBinary(program, format, &binary[0], static_cast<GLsizei>(binary.size()));
+
+        GLint linked = 0;
+        glext::getProgramiv(program, GL_LINK_STATUS, &linked);
+
+        return linked != 0;
+    }
+}
+
+namespace shadercache
+{
+    void setDirectory(const std::string& directory)
+    {
+        sf::Lock lock(mutex);
+        cacheDirectory = directory;
+    }
+
+    bool isEnabled()
+    {
+        sf::Lock lock(mutex);
+        return !cacheDirectory.empty();
+    }
+
+    bool load(sf::Shader& shader, const std::string& vertex, const std::string& geometry, const std::string& fragment)
+    {
+        std::string directory;
+        {
+            sf::Lock lock(mutex);
+            directory = cacheDirectory;
+        }
+
+        std::unique_ptr<sf::Context> context;
+        if (!sf::Context::getActiveContext())
+            context.reset(new sf::Context);
+
+        if (directory.empty() || !glext::hasProgramBinaries())
+            return compile(shader, vertex, geometry, fragment);
+
+        sf::Uint64 key = computeKey(vertex, geometry, fragment);
+        std::string path = getPath(directory, key);
+
+        GLenum format = 0;
+        std::vector<char> binary;
+
+        if (readBinary(path, key, format, binary) && loadBinary(shader, format, binary))
+        {
+            ++hitCount;
+            return true;
+        }
+
+        ++missCount;
+
+        if (!compile(shader, vertex, geometry, fragment))
+            return false;
+
+        writeBinary(path, key, shader.getNativeHandle());
+
+        return true;
+    }
+
+    void getStatistics(unsigned int& hits, unsigned int& misses)
+    {
+        hits = hitCount;
+        misses = missCount;
+    }
+
+    void resetStatistics()
+    {
+        hitCount = 0;
+        missCount = 0;
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_SHADERCACHE_HPP
+#define DSFML_SHADERCACHE_HPP
+
+#include <SFML/Graphics/Shader.hpp>
+#include <string>
+
+//On-disk cache of linked shader programs, keyed by their sources and the driver
+namespace shadercache
+{
+    //Set the directory where programs are cached, an empty path disables the cache
+    void setDirectory(const std::string& directory);
+
+    //Check if a cache directory was set
+    bool isEnabled();
+
+    //Load a shader from the cache, compiling its sources and caching the result on a miss.
+    //Stages that are not used are given as empty strings.
+    bool load(sf::Shader& shader, const std::string& vertex, const std::string& geometry, const std::string& fragment);
+
+    //Get the number of programs that were loaded from the cache, and that had to be compiled
+    void getStatistics(unsigned int& hits, unsigned int& misses);
+
+    //Reset the cache statistics
+    void resetStatistics();
+}
+
+#endif // DSFML_SHADERCACHE_HPP
@@ -0,0 +1,127 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/ShaderLoader.hpp>
+#include <DSFMLC/Window/ContextStruct.h>
+#include <SFML/OpenGL.hpp>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    class Worker
+    {
+    public:
+        Worker() :
+        m_stopping(false),
+        m_thread(&Worker::run, this)
+        {
+        }
+
+        ~Worker()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+
+            m_condition.notify_one();
+            m_thread.join();
+        }
+
+        std::shared_future<bool> enqueue(const std::function<bool()>& task)
+        {
+            //Other contexts only see the finished program once the commands have completed,
+            //so they are waited for before the result is made available
+            std::shared_ptr<std::packaged_task<bool()>> job = std::make_shared<std::packaged_task<bool()>>([task]()
+            {
+                bool result = task();
+                glFinish();
+
+                return result;
+            });
+            std::shared_future<bool> result = job->get_future().share();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_jobs.push_back(job);
+            }
+
+            m_condition.notify_one();
+
+            return result;
+        }
+
+    private:
+        void run()
+        {
+            //Created on this thread so that it stays active here for the lifetime of the worker
+            sfContext context;
+
+            while (true)
+            {
+                std::shared_ptr<std::packaged_task<bool()>> job;
+
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+
+                    if (m_jobs.empty())
+                        return;
+
+                    job = m_jobs.front();
+                    m_jobs.pop_front();
+                }
+
+                (*job)();
+            }
+        }
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<std::shared_ptr<std::packaged_task<bool()>>> m_jobs;
+        bool m_stopping;
+        std::thread m_thread;
+    };
+
+    Worker& getWorker()
+    {
+        static Worker worker;
+        return worker;
+    }
+}
+
+namespace shaderloader
+{
+    std::shared_future<bool> enqueue(const std::function<bool()>& task)
+    {
+        return getWorker().enqueue(task);
+    }
+}
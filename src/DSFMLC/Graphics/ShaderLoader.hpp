@@ -0,0 +1,41 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_SHADERLOADER_HPP
+#define DSFML_SHADERLOADER_HPP
+
+#include <functional>
+#include <future>
+
+//Background thread compiling shaders in its own context, which shares its objects with every other context
+namespace shaderloader
+{
+    //Queue a task to run on the background thread, tasks run one at a time in the order they were queued
+    std::shared_future<bool> enqueue(const std::function<bool()>& task);
+}
+
+#endif // DSFML_SHADERLOADER_HPP
@@ -29,11 +29,55 @@
 #define DSFML_SHADERSTRUCT_H
 
 #include <SFML/Graphics/Shader.hpp>
+#include <future>
+#include <string>
+#include <vector>
+
+//A uniform that was looked up through sfShader_getUniformLocation
+struct sfShaderUniform
+{
+    std::string name;
+    int location;
+    bool resolved;
+};
+
+//A uniform block that was looked up through sfShader_getUniformBlock
+struct sfShaderUniformBlock
+{
+    std::string name;
+    unsigned int index;
+    bool resolved;
+    unsigned int binding;
+    unsigned int buffer;
+    std::size_t size;
+};
 
 //Internal structure of sfShader
 struct sfShader
 {
     sf::Shader This;
+
+    //Indexed by the handles given out to D, which stay valid when the shader is reloaded
+    std::vector<sfShaderUniform> Uniforms;
+
+    //Uniform blocks backed by uniform buffer objects, indexed the same way
+    std::vector<sfShaderUniformBlock> UniformBlocks;
+
+    //The last load queued on the background thread, which must finish before the shader is used again
+    std::shared_future<bool> PendingLoad;
+};
+
+//A shader that is still compiling on the background thread can't be touched yet
+inline void waitForPendingLoad(const sfShader* shader)
+{
+    if (shader->PendingLoad.valid())
+        shader->PendingLoad.wait();
+}
+
+//Internal structure of sfShaderLoad
+struct sfShaderLoad
+{
+    std::shared_future<bool> Result;
 };
 
 #endif // SFML_SHADERSTRUCT_H
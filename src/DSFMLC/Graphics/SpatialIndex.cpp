@@ -0,0 +1,341 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/SpatialIndex.h>
+#include <DSFMLC/Graphics/SpatialIndexStruct.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    //Number of grids, each with cells twice as large as the previous one's
+    const int LevelCount = 12;
+
+    //Cell coordinates are clamped so that huge positions can't overflow them
+    const double MaxCell = 1 << 30;
+
+    int cellCoordinate(double position, float cellSize)
+    {
+        double cell = std::floor(position / cellSize);
+        return static_cast<int>(std::max(-MaxCell, std::min(MaxCell, cell)));
+    }
+
+    sf::Uint64 cellKey(int x, int y)
+    {
+        return (static_cast<sf::Uint64>(static_cast<sf::Uint32>(x)) << 32) | static_cast<sf::Uint32>(y);
+    }
+
+    //Same as the bounds, but with a positive width and height
+    sf::FloatRect normalize(float left, float top, float width, float height)
+    {
+        return sf::FloatRect(std::min(left, left + width), std::min(top, top + height), std::abs(width), std::abs(height));
+    }
+
+    bool touches(const sf::FloatRect& a, const sf::FloatRect& b)
+    {
+        return (a.left <= b.left + b.width) && (b.left <= a.left + a.width) &&
+               (a.top <= b.top + b.height) && (b.top <= a.top + a.height);
+    }
+
+    //Find the finest grid whose cells are as large as the bounds and the cell holding their center
+    void place(const sfSpatialIndex* index, const sf::FloatRect& bounds, int& level, sf::Uint64& cell)
+    {
+        float size = std::max(bounds.width, bounds.height);
+
+        level = 0;
+        while ((level < LevelCount) && (size > index->levels[level].cellSize))
+            ++level;
+
+        if (level == LevelCount)
+        {
+            level = -1;
+            cell = 0;
+            return;
+        }
+
+        float cellSize = index->levels[level].cellSize;
+        cell = cellKey(cellCoordinate(bounds.left + bounds.width / 2.0, cellSize),
+                       cellCoordinate(bounds.top + bounds.height / 2.0, cellSize));
+    }
+
+    std::vector<sfSpatialIndexItem>& itemsOf(sfSpatialIndex* index, const sfSpatialIndexEntry& entry)
+    {
+        return (entry.level < 0) ? index->oversized : index->levels[entry.level].cells[entry.cell];
+    }
+
+    void link(sfSpatialIndex* index, DUint id, sfSpatialIndexEntry& entry, const sf::FloatRect& bounds)
+    {
+        std::vector<sfSpatialIndexItem>& items = itemsOf(index, entry);
+
+        sfSpatialIndexItem item;
+        item.bounds = bounds;
+        item.id = id;
+
+        entry.position = items.size();
+        items.push_back(item);
+
+        if (entry.level >= 0)
+            ++index->levels[entry.level].objectCount;
+    }
+
+    //Fill the hole with the last object of the cell, empty cells are dropped so that objects
+    //moving through a large world don't leave them behind
+    void unlink(sfSpatialIndex* index, const sfSpatialIndexEntry& entry)
+    {
+        std::vector<sfSpatialIndexItem>& items = itemsOf(index, entry);
+
+        if (entry.position + 1 != items.size())
+        {
+            items[entry.position] = items.back();
+            index->entries[items[entry.position].id].position = entry.position;
+        }
+        items.pop_back();
+
+        if (entry.level >= 0)
+        {
+            sfSpatialIndexLevel& level = index->levels[entry.level];
+            --level.objectCount;
+
+            if (items.empty())
+                level.cells.erase(entry.cell);
+        }
+    }
+
+    void insert(sfSpatialIndex* index, DUint id, const sf::FloatRect& bounds)
+    {
+        sfSpatialIndexEntry& entry = index->entries[id];
+        place(index, bounds, entry.level, entry.cell);
+        link(index, id, entry, bounds);
+    }
+
+    void move(sfSpatialIndex* index, DUint id, sfSpatialIndexEntry& entry, const sf::FloatRect& bounds)
+    {
+        int level;
+        sf::Uint64 cell;
+        place(index, bounds, level, cell);
+
+        //Most moves stay within the same cell, which only needs the copy of the bounds updated
+        if ((level == entry.level) && (cell == entry.cell))
+        {
+            itemsOf(index, entry)[entry.position].bounds = bounds;
+            return;
+        }
+
+        unlink(index, entry);
+        entry.level = level;
+        entry.cell = cell;
+        link(index, id, entry, bounds);
+    }
+
+    void testItems(sfSpatialIndex* index, const std::vector<sfSpatialIndexItem>& items, const sf::FloatRect& area)
+    {
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            if (touches(items[i].bounds, area))
+                index->results.push_back(items[i].id);
+        }
+
+        index->candidateCount += static_cast<unsigned int>(items.size());
+    }
+
+    void queryLevel(sfSpatialIndex* index, const sfSpatialIndexLevel& level, const sf::FloatRect& area)
+    {
+        //Objects stick out of their cell by up to half of it, with a little more to be safe from rounding
+        double margin = level.cellSize * 0.5 * 1.001;
+
+        int firstX = cellCoordinate(area.left - margin, level.cellSize);
+        int firstY = cellCoordinate(area.top - margin, level.cellSize);
+        int lastX = cellCoordinate(static_cast<double>(area.left) + area.width + margin, level.cellSize);
+        int lastY = cellCoordinate(static_cast<double>(area.top) + area.height + margin, level.cellSize);
+
+        long long cellCount = (static_cast<long long>(lastX) - firstX + 1) * (static_cast<long long>(lastY) - firstY + 1);
+
+        //When zoomed far out, going through the non-empty cells is cheaper than looking up every cell of the area
+        if (cellCount > static_cast<long long>(level.cells.size()))
+        {
+            for (sfSpatialIndexCellMap::const_iterator cell = level.cells.begin(); cell != level.cells.end(); ++cell)
+            {
+                int x = static_cast<int>(static_cast<sf::Uint32>(cell->first >> 32));
+                int y = static_cast<int>(static_cast<sf::Uint32>(cell->first));
+
+                if ((x >= firstX) && (x <= lastX) && (y >= firstY) && (y <= lastY))
+                    testItems(index, cell->second, area);
+            }
+        }
+        else
+        {
+            for (int y = firstY; y <= lastY; ++y)
+            {
+                for (int x = firstX; x <= lastX; ++x)
+                {
+                    sfSpatialIndexCellMap::const_iterator cell = level.cells.find(cellKey(x, y));
+                    if (cell != level.cells.end())
+                        testItems(index, cell->second, area);
+                }
+            }
+        }
+    }
+}
+
+sfSpatialIndex* sfSpatialIndex_construct(float cellSize)
+{
+    sfSpatialIndex* index = new sfSpatialIndex;
+
+    if (!(cellSize > 0))
+        cellSize = 256;
+
+    index->levels.resize(LevelCount);
+    for (int i = 0; i < LevelCount; ++i)
+        index->levels[i].cellSize = cellSize * static_cast<float>(1 << i);
+
+    return index;
+}
+
+void sfSpatialIndex_destroy(sfSpatialIndex* index)
+{
+    delete index;
+}
+
+DBool sfSpatialIndex_insert(sfSpatialIndex* index, DUint id, float left, float top, float width, float height)
+{
+    if (index->entries.count(id))
+        return DFalse;
+
+    insert(index, id, normalize(left, top, width, height));
+    return DTrue;
+}
+
+DBool sfSpatialIndex_move(sfSpatialIndex* index, DUint id, float left, float top, float width, float height)
+{
+    std::unordered_map<DUint, sfSpatialIndexEntry>::iterator entry = index->entries.find(id);
+    if (entry == index->entries.end())
+        return DFalse;
+
+    move(index, id, entry->second, normalize(left, top, width, height));
+    return DTrue;
+}
+
+void sfSpatialIndex_setBounds(sfSpatialIndex* index, const DUint* ids, const float* bounds, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float* rect = bounds + i * 4;
+        sf::FloatRect normalized = normalize(rect[0], rect[1], rect[2], rect[3]);
+
+        std::unordered_map<DUint, sfSpatialIndexEntry>::iterator entry = index->entries.find(ids[i]);
+        if (entry == index->entries.end())
+            insert(index, ids[i], normalized);
+        else
+            move(index, ids[i], entry->second, normalized);
+    }
+}
+
+DBool sfSpatialIndex_remove(sfSpatialIndex* index, DUint id)
+{
+    std::unordered_map<DUint, sfSpatialIndexEntry>::iterator entry = index->entries.find(id);
+    if (entry == index->entries.end())
+        return DFalse;
+
+    unlink(index, entry->second);
+    index->entries.erase(entry);
+    return DTrue;
+}
+
+void sfSpatialIndex_clear(sfSpatialIndex* index)
+{
+    for (std::size_t i = 0; i < index->levels.size(); ++i)
+    {
+        index->levels[i].cells.clear();
+        index->levels[i].objectCount = 0;
+    }
+
+    index->entries.clear();
+    index->oversized.clear();
+    index->results.clear();
+}
+
+DBool sfSpatialIndex_getBounds(const sfSpatialIndex* index, DUint id, float* left, float* top, float* width, float* height)
+{
+    std::unordered_map<DUint, sfSpatialIndexEntry>::const_iterator entry = index->entries.find(id);
+    if (entry == index->entries.end())
+        return DFalse;
+
+    const sfSpatialIndexEntry& place = entry->second;
+    const std::vector<sfSpatialIndexItem>& items = (place.level < 0) ? index->oversized : index->levels[place.level].cells.find(place.cell)->second;
+    const sf::FloatRect& bounds = items[place.position].bounds;
+
+    *left = bounds.left;
+    *top = bounds.top;
+    *width = bounds.width;
+    *height = bounds.height;
+    return DTrue;
+}
+
+size_t sfSpatialIndex_query(sfSpatialIndex* index, float left, float top, float width, float height)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    sf::FloatRect area = normalize(left, top, width, height);
+    index->results.clear();
+    index->candidateCount = 0;
+
+    for (std::size_t i = 0; i < index->levels.size(); ++i)
+    {
+        if (index->levels[i].objectCount > 0)
+            queryLevel(index, index->levels[i], area);
+    }
+
+    testItems(index, index->oversized, area);
+
+    index->visibleCount = static_cast<unsigned int>(index->results.size());
+    index->queryTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    index->totalQueryTime += index->queryTime;
+    ++index->queryCount;
+
+    return index->results.size();
+}
+
+const DUint* sfSpatialIndex_getResults(const sfSpatialIndex* index)
+{
+    return index->results.empty() ? NULL : &index->results[0];
+}
+
+void sfSpatialIndex_getStatistics(const sfSpatialIndex* index, DUint* objectCount, DUint* cellCount, DUint* visibleCount, DUint* candidateCount, DLong* queryTime, DUint* queryCount, DLong* totalQueryTime)
+{
+    std::size_t cells = 0;
+    for (std::size_t i = 0; i < index->levels.size(); ++i)
+        cells += index->levels[i].cells.size();
+
+    *objectCount = static_cast<DUint>(index->entries.size());
+    *cellCount = static_cast<DUint>(cells);
+    *visibleCount = index->visibleCount;
+    *candidateCount = index->candidateCount;
+    *queryTime = index->queryTime / 1000;
+    *queryCount = index->queryCount;
+    *totalQueryTime = index->totalQueryTime / 1000;
+}
@@ -0,0 +1,68 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_SPATIALINDEX_H
+#define DSFML_SPATIALINDEX_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <DSFMLC/Graphics/Types.h>
+#include <stddef.h>
+
+//Construct a new spatial index, with loose grids whose smallest cells have the given size
+DSFML_GRAPHICS_API sfSpatialIndex* sfSpatialIndex_construct(float cellSize);
+
+//Destroy an existing spatial index
+DSFML_GRAPHICS_API void sfSpatialIndex_destroy(sfSpatialIndex* index);
+
+//Add an object with the given bounds, failing if the id is already used
+DSFML_GRAPHICS_API DBool sfSpatialIndex_insert(sfSpatialIndex* index, DUint id, float left, float top, float width, float height);
+
+//Change the bounds of an existing object
+DSFML_GRAPHICS_API DBool sfSpatialIndex_move(sfSpatialIndex* index, DUint id, float left, float top, float width, float height);
+
+//Set the bounds of an array of objects stored as left, top, width, height, inserting the ones that don't exist yet
+DSFML_GRAPHICS_API void sfSpatialIndex_setBounds(sfSpatialIndex* index, const DUint* ids, const float* bounds, size_t count);
+
+//Remove an object
+DSFML_GRAPHICS_API DBool sfSpatialIndex_remove(sfSpatialIndex* index, DUint id);
+
+//Remove all the objects
+DSFML_GRAPHICS_API void sfSpatialIndex_clear(sfSpatialIndex* index);
+
+//Get the bounds of an object
+DSFML_GRAPHICS_API DBool sfSpatialIndex_getBounds(const sfSpatialIndex* index, DUint id, float* left, float* top, float* width, float* height);
+
+//Find the objects whose bounds touch an area, returning how many there are
+DSFML_GRAPHICS_API size_t sfSpatialIndex_query(sfSpatialIndex* index, float left, float top, float width, float height);
+
+//Get the ids of the objects found by the last query
+DSFML_GRAPHICS_API const DUint* sfSpatialIndex_getResults(const sfSpatialIndex* index);
+
+//Get the number of objects and non-empty cells, what the last query found and tested and how long it took, and the number and total time of queries
+DSFML_GRAPHICS_API void sfSpatialIndex_getStatistics(const sfSpatialIndex* index, DUint* objectCount, DUint* cellCount, DUint* visibleCount, DUint* candidateCount, DLong* queryTime, DUint* queryCount, DLong* totalQueryTime);
+
+#endif // DSFML_SPATIALINDEX_H
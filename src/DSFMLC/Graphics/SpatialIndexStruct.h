@@ -0,0 +1,105 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_SPATIALINDEXSTRUCT_H
+#define DSFML_SPATIALINDEXSTRUCT_H
+
+#include <DSFMLC/Config.h>
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <unordered_map>
+#include <vector>
+
+//Where an object is stored in the index
+struct sfSpatialIndexEntry
+{
+    //Level of the grid holding the object, or -1 if it is too large for all of them
+    int level;
+
+    //Packed coordinates of the cell holding the object's center
+    sf::Uint64 cell;
+
+    //Position of the object in its cell, or in the oversized objects
+    std::size_t position;
+};
+
+//Copy of an object's bounds kept in its cell, so that queries only read the cells
+struct sfSpatialIndexItem
+{
+    sf::FloatRect bounds;
+    DUint id;
+};
+
+typedef std::unordered_map<sf::Uint64, std::vector<sfSpatialIndexItem> > sfSpatialIndexCellMap;
+
+//A loose grid, its cells hold the objects whose center is inside them and that are at most as large as them
+struct sfSpatialIndexLevel
+{
+    sfSpatialIndexLevel() :
+    cellSize(0),
+    objectCount(0)
+    {
+    }
+
+    float cellSize;
+    std::size_t objectCount;
+    sfSpatialIndexCellMap cells;
+};
+
+//Internal structure of sfSpatialIndex
+struct sfSpatialIndex
+{
+    sfSpatialIndex() :
+    visibleCount(0),
+    candidateCount(0),
+    queryCount(0),
+    queryTime(0),
+    totalQueryTime(0)
+    {
+    }
+
+    //Grids with cells twice as large as the previous one's
+    std::vector<sfSpatialIndexLevel> levels;
+
+    std::unordered_map<DUint, sfSpatialIndexEntry> entries;
+
+    //Objects too large for the coarsest grid, tested by every query
+    std::vector<sfSpatialIndexItem> oversized;
+
+    //Ids found by the last query
+    std::vector<DUint> results;
+
+    unsigned int visibleCount;
+    unsigned int candidateCount;
+    unsigned int queryCount;
+
+    //In nanoseconds
+    DLong queryTime;
+    DLong totalQueryTime;
+};
+
+#endif // DSFML_SPATIALINDEXSTRUCT_H
@@ -0,0 +1,232 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/SpriteBatch.h>
+#include <DSFMLC/Graphics/SpriteBatchStruct.h>
+#include <DSFMLC/Graphics/TextureStruct.h>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+
+namespace
+{
+    const float identity[16] = {1.f, 0.f, 0.f, 0.f,
+                                0.f, 1.f, 0.f, 0.f,
+                                0.f, 0.f, 1.f, 0.f,
+                                0.f, 0.f, 0.f, 1.f};
+
+    const sf::Texture* getTexture(const sfDrawCommand& command)
+    {
+        return command.texture ? command.texture->This : NULL;
+    }
+
+    //Strips and fans can't be joined together without changing what they look like
+    bool isMergeable(DInt type)
+    {
+        return (type == sf::Points) || (type == sf::Lines) ||
+               (type == sf::Triangles) || (type == sf::Quads);
+    }
+
+    //Check if two entries can be drawn with the same draw call
+    bool canShareDrawCall(const sfDrawCommand& left, const sfDrawCommand& right)
+    {
+        return (left.type == right.type) &&
+               (getTexture(left) == getTexture(right)) &&
+               (left.shader == right.shader) &&
+               (left.colorSrcFactor == right.colorSrcFactor) &&
+               (left.colorDstFactor == right.colorDstFactor) &&
+               (left.colorEquation == right.colorEquation) &&
+               (left.alphaSrcFactor == right.alphaSrcFactor) &&
+               (left.alphaDstFactor == right.alphaDstFactor) &&
+               (left.alphaEquation == right.alphaEquation);
+    }
+
+    //Orders entries by shader, then texture, then blend mode and primitive type
+    struct EntrySorter
+    {
+        bool operator()(const sfSpriteBatchEntry& left, const sfSpriteBatchEntry& right) const
+        {
+            const sfDrawCommand& l = left.states;
+            const sfDrawCommand& r = right.states;
+
+            if (l.shader != r.shader)
+                return std::less<const sfShader*>()(l.shader, r.shader);
+            if (getTexture(l) != getTexture(r))
+                return std::less<const sf::Texture*>()(getTexture(l), getTexture(r));
+
+            const DInt leftKey[7] = {l.colorSrcFactor, l.colorDstFactor, l.colorEquation,
+                                     l.alphaSrcFactor, l.alphaDstFactor, l.alphaEquation, l.type};
+            const DInt rightKey[7] = {r.colorSrcFactor, r.colorDstFactor, r.colorEquation,
+                                      r.alphaSrcFactor, r.alphaDstFactor, r.alphaEquation, r.type};
+
+            return std::lexicographical_compare(leftKey, leftKey + 7, rightKey, rightKey + 7);
+        }
+    };
+
+    void updateCommands(sfSpriteBatch* spriteBatch)
+    {
+        spriteBatch->commands.clear();
+
+        std::vector<sfSpriteBatchEntry> sortedEntries;
+        const std::vector<sfSpriteBatchEntry>* entries = &spriteBatch->entries;
+        const sf::Vertex* vertices = spriteBatch->vertices.empty() ? NULL : &spriteBatch->vertices[0];
+
+        if (spriteBatch->mode == sfSpriteBatch::TextureSorted)
+        {
+            sortedEntries = spriteBatch->entries;
+            std::stable_sort(sortedEntries.begin(), sortedEntries.end(), EntrySorter());
+
+            //Copy the vertices in their new order so that merged runs stay contiguous
+            spriteBatch->sortedVertices.clear();
+            spriteBatch->sortedVertices.reserve(spriteBatch->vertices.size());
+            for (std::size_t i = 0; i < sortedEntries.size(); ++i)
+            {
+                std::size_t first = sortedEntries[i].first;
+                sortedEntries[i].first = spriteBatch->sortedVertices.size();
+                spriteBatch->sortedVertices.insert(spriteBatch->sortedVertices.end(),
+                                                   spriteBatch->vertices.begin() + first,
+                                                   spriteBatch->vertices.begin() + first + sortedEntries[i].count);
+            }
+
+            entries = &sortedEntries;
+            vertices = spriteBatch->sortedVertices.empty() ? NULL : &spriteBatch->sortedVertices[0];
+        }
+
+        for (std::size_t i = 0; i < entries->size(); ++i)
+        {
+            const sfSpriteBatchEntry& entry = (*entries)[i];
+
+            if ((spriteBatch->mode != sfSpriteBatch::Immediate) && !spriteBatch->commands.empty() &&
+                isMergeable(entry.states.type) && canShareDrawCall(spriteBatch->commands.back(), entry.states))
+            {
+                sfDrawCommand& previous = spriteBatch->commands.back();
+                const sf::Vertex* previousEnd = static_cast<const sf::Vertex*>(previous.vertices) + previous.vertexCount;
+
+                if ((previousEnd == vertices + entry.first) && (previous.vertexCount + entry.count <= 0xFFFFFFFF))
+                {
+                    previous.vertexCount += static_cast<DUint>(entry.count);
+                    continue;
+                }
+            }
+
+            sfDrawCommand command = entry.states;
+            command.vertices = vertices + entry.first;
+            command.vertexCount = static_cast<DUint>(entry.count);
+            spriteBatch->commands.push_back(command);
+        }
+
+        spriteBatch->needsUpdate = false;
+    }
+}
+
+sfSpriteBatch* sfSpriteBatch_construct(void)
+{
+    return new sfSpriteBatch;
+}
+
+void sfSpriteBatch_destroy(sfSpriteBatch* spriteBatch)
+{
+    delete spriteBatch;
+}
+
+void sfSpriteBatch_setMode(sfSpriteBatch* spriteBatch, DInt mode)
+{
+    if (spriteBatch->mode != static_cast<sfSpriteBatch::Mode>(mode))
+    {
+        spriteBatch->mode = static_cast<sfSpriteBatch::Mode>(mode);
+        spriteBatch->needsUpdate = true;
+    }
+}
+
+DInt sfSpriteBatch_getMode(const sfSpriteBatch* spriteBatch)
+{
+    return spriteBatch->mode;
+}
+
+void sfSpriteBatch_add(sfSpriteBatch* spriteBatch, const sfDrawCommand* commands, size_t commandCount)
+{
+    for (size_t i = 0; i < commandCount; ++i)
+    {
+        const sfDrawCommand& command = commands[i];
+
+        if ((command.vertices == NULL) || (command.vertexCount == 0))
+            continue;
+
+        sfSpriteBatchEntry entry;
+        entry.states = command;
+        entry.states.vertices = NULL;
+        std::memcpy(entry.states.transform, identity, sizeof(identity));
+        entry.first = spriteBatch->vertices.size();
+        entry.count = command.vertexCount;
+
+        //Bake the transform into the vertices so that different sprites can share a draw call
+        const sf::Transform& transform = *reinterpret_cast<const sf::Transform*>(command.transform);
+        const sf::Vertex* source = static_cast<const sf::Vertex*>(command.vertices);
+
+        spriteBatch->vertices.resize(entry.first + entry.count);
+        for (std::size_t j = 0; j < entry.count; ++j)
+        {
+            sf::Vertex& vertex = spriteBatch->vertices[entry.first + j];
+            vertex = source[j];
+            vertex.position = transform.transformPoint(source[j].position);
+        }
+
+        spriteBatch->entries.push_back(entry);
+    }
+
+    spriteBatch->needsUpdate = true;
+}
+
+void sfSpriteBatch_clear(sfSpriteBatch* spriteBatch)
+{
+    spriteBatch->entries.clear();
+    spriteBatch->vertices.clear();
+    spriteBatch->sortedVertices.clear();
+    spriteBatch->commands.clear();
+    spriteBatch->needsUpdate = false;
+}
+
+const sfDrawCommand* sfSpriteBatch_getCommands(sfSpriteBatch* spriteBatch, const float* transform, size_t* commandCount)
+{
+    if (spriteBatch->needsUpdate)
+        updateCommands(spriteBatch);
+
+    for (std::size_t i = 0; i < spriteBatch->commands.size(); ++i)
+        std::memcpy(spriteBatch->commands[i].transform, transform, sizeof(identity));
+
+    *commandCount = spriteBatch->commands.size();
+
+    return spriteBatch->commands.empty() ? NULL : &spriteBatch->commands[0];
+}
+
+void sfSpriteBatch_getStatistics(const sfSpriteBatch* spriteBatch, DUint* spriteCount, DUint* drawCount)
+{
+    *spriteCount = static_cast<DUint>(spriteBatch->entries.size());
+    *drawCount = static_cast<DUint>(spriteBatch->commands.size());
+}
@@ -0,0 +1,60 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_SPRITEBATCH_H
+#define DSFML_SPRITEBATCH_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <DSFMLC/Graphics/Types.h>
+#include <DSFMLC/Graphics/DrawCommand.h>
+#include <stddef.h>
+
+//Construct a new sprite batch
+DSFML_GRAPHICS_API sfSpriteBatch* sfSpriteBatch_construct(void);
+
+//Destroy an existing sprite batch
+DSFML_GRAPHICS_API void sfSpriteBatch_destroy(sfSpriteBatch* spriteBatch);
+
+//Set the way a sprite batch merges its sprites into draw calls
+DSFML_GRAPHICS_API void sfSpriteBatch_setMode(sfSpriteBatch* spriteBatch, DInt mode);
+
+//Get the way a sprite batch merges its sprites into draw calls
+DSFML_GRAPHICS_API DInt sfSpriteBatch_getMode(const sfSpriteBatch* spriteBatch);
+
+//Add primitives to a sprite batch, transforming their vertices on the CPU
+DSFML_GRAPHICS_API void sfSpriteBatch_add(sfSpriteBatch* spriteBatch, const sfDrawCommand* commands, size_t commandCount);
+
+//Remove all the primitives from a sprite batch
+DSFML_GRAPHICS_API void sfSpriteBatch_clear(sfSpriteBatch* spriteBatch);
+
+//Merge the primitives of a sprite batch into as few draw commands as possible
+DSFML_GRAPHICS_API const sfDrawCommand* sfSpriteBatch_getCommands(sfSpriteBatch* spriteBatch, const float* transform, size_t* commandCount);
+
+//Get the number of primitives added to a sprite batch and the number of draw commands they were merged into
+DSFML_GRAPHICS_API void sfSpriteBatch_getStatistics(const sfSpriteBatch* spriteBatch, DUint* spriteCount, DUint* drawCount);
+
+#endif // DSFML_SPRITEBATCH_H
@@ -0,0 +1,68 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_SPRITEBATCHSTRUCT_H
+#define DSFML_SPRITEBATCHSTRUCT_H
+
+#include <SFML/Graphics/Vertex.hpp>
+#include <DSFMLC/Graphics/DrawCommand.h>
+#include <vector>
+#include <cstddef>
+
+//A run of vertices added to a sprite batch with a single set of render states
+struct sfSpriteBatchEntry
+{
+    sfDrawCommand states;
+    std::size_t first;
+    std::size_t count;
+};
+
+//Internal structure of sfSpriteBatch
+struct sfSpriteBatch
+{
+    enum Mode
+    {
+        Deferred,
+        TextureSorted,
+        Immediate
+    };
+
+    sfSpriteBatch() :
+    mode(Deferred),
+    needsUpdate(true)
+    {
+    }
+
+    Mode mode;
+    bool needsUpdate;
+    std::vector<sfSpriteBatchEntry> entries;
+    std::vector<sf::Vertex> vertices;
+    std::vector<sf::Vertex> sortedVertices;
+    std::vector<sfDrawCommand> commands;
+};
+
+#endif // DSFML_SPRITEBATCHSTRUCT_H
@@ -0,0 +1,418 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/Tessellator.h>
+#include <SFML/Graphics/Vertex.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    sf::Vector2f pointAt(const float* points, size_t index)
+    {
+        return sf::Vector2f(points[index * 2], points[index * 2 + 1]);
+    }
+
+    float cross(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c)
+    {
+        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    }
+
+    //Twice the signed area, positive when the points go clockwise on screen
+    float signedArea(const float* points, size_t count)
+    {
+        float area = 0.f;
+        for (size_t i = 0, j = count - 1; i < count; j = i++)
+            area += pointAt(points, j).x * pointAt(points, i).y - pointAt(points, i).x * pointAt(points, j).y;
+
+        return area;
+    }
+
+    sf::FloatRect computeBounds(const float* points, size_t count)
+    {
+        float left = points[0];
+        float top = points[1];
+        float right = left;
+        float bottom = top;
+
+        for (size_t i = 1; i < count; ++i)
+        {
+            left = std::min(left, points[i * 2]);
+            right = std::max(right, points[i * 2]);
+            top = std::min(top, points[i * 2 + 1]);
+            bottom = std::max(bottom, points[i * 2 + 1]);
+        }
+
+        return sf::FloatRect(left, top, right - left, bottom - top);
+    }
+
+    void storeBounds(const sf::FloatRect& rect, float* bounds)
+    {
+        bounds[0] = rect.left;
+        bounds[1] = rect.top;
+        bounds[2] = rect.width;
+        bounds[3] = rect.height;
+    }
+
+    //Fills vertices the same way sf::Shape does, mapping the bounds of the shape onto the texture rectangle
+    class FillVertex
+    {
+    public:
+        FillVertex(const sf::FloatRect& bounds, sf::Color color, const sf::IntRect& textureRect) :
+        m_color(color)
+        {
+            m_scale.x = (bounds.width != 0.f) ? textureRect.width / bounds.width : 0.f;
+            m_scale.y = (bounds.height != 0.f) ? textureRect.height / bounds.height : 0.f;
+            m_offset.x = textureRect.left - bounds.left * m_scale.x;
+            m_offset.y = textureRect.top - bounds.top * m_scale.y;
+        }
+
+        sf::Vertex operator ()(sf::Vector2f position) const
+        {
+            return sf::Vertex(position, m_color, sf::Vector2f(m_offset.x + position.x * m_scale.x, m_offset.y + position.y * m_scale.y));
+        }
+
+    private:
+        sf::Color m_color;
+        sf::Vector2f m_scale;
+        sf::Vector2f m_offset;
+    };
+
+    sf::Vector2f computeNormal(sf::Vector2f first, sf::Vector2f second)
+    {
+        sf::Vector2f normal(first.y - second.y, second.x - first.x);
+        float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+
+        if (length != 0.f)
+            normal /= length;
+
+        return normal;
+    }
+
+    //Doubly linked ring of the points of a polygon, from which ears are cut one after the other
+    class EarClipper
+    {
+    public:
+        EarClipper(const float* points, size_t count) :
+        m_points(points),
+        m_previous(count),
+        m_next(count),
+        m_reflex(count),
+        m_removed(count),
+        m_reflexCount(0),
+        m_remaining(count)
+        {
+            //Work on clockwise polygons, so that convex corners have a positive cross product
+            bool reversed = signedArea(points, count) < 0.f;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                m_previous[i] = reversed ? (i + 1) % count : (i + count - 1) % count;
+                m_next[i] = reversed ? (i + count - 1) % count : (i + 1) % count;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+                updateReflex(i);
+
+            buildGrid(count);
+        }
+
+        template <typename Emit>
+        void clip(Emit emit)
+        {
+            size_t current = 0;
+            size_t attempts = 0;
+
+            while (m_remaining > 3)
+            {
+                size_t previous = m_previous[current];
+                size_t next = m_next[current];
+
+                //A polygon crossing itself may have no ear left, cutting any corner keeps going
+                bool forced = attempts > m_remaining;
+
+                if (forced || isEar(previous, current, next))
+                {
+                    if (cross(point(previous), point(current), point(next)) != 0.f)
+                        emit(previous, current, next);
+
+                    remove(current);
+                    current = next;
+                    attempts = 0;
+                }
+                else
+                {
+                    current = next;
+                    ++attempts;
+                }
+            }
+
+            emit(m_previous[current], current, m_next[current]);
+        }
+
+    private:
+        sf::Vector2f point(size_t index) const
+        {
+            return pointAt(m_points, index);
+        }
+
+        void updateReflex(size_t index)
+        {
+            bool reflex = cross(point(m_previous[index]), point(index), point(m_next[index])) <= 0.f;
+
+            if (reflex != static_cast<bool>(m_reflex[index]))
+            {
+                m_reflexCount += reflex ? 1 : -1;
+                m_reflex[index] = reflex;
+            }
+        }
+
+        //Cutting ears never makes a corner reflex, so the reflex corners are bucketed once in a grid
+        void buildGrid(size_t count)
+        {
+            m_bounds = computeBounds(m_points, count);
+            m_gridSize = std::max<size_t>(1, static_cast<size_t>(std::sqrt(static_cast<float>(m_reflexCount) / 4.f)));
+            m_cellStart.assign(m_gridSize * m_gridSize + 1, 0);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (m_reflex[i])
+                    m_cellStart[cellOf(point(i)) + 1]++;
+            }
+
+            for (size_t i = 1; i < m_cellStart.size(); ++i)
+                m_cellStart[i] += m_cellStart[i - 1];
+
+            std::vector<size_t> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+            m_cells.resize(m_cellStart.back());
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (m_reflex[i])
+                    m_cells[fill[cellOf(point(i))]++] = i;
+            }
+        }
+
+        size_t column(float x) const
+        {
+            float cell = (m_bounds.width > 0.f) ? (x - m_bounds.left) / m_bounds.width * m_gridSize : 0.f;
+            return std::min(m_gridSize - 1, static_cast<size_t>(std::max(0.f, cell)));
+        }
+
+        size_t row(float y) const
+        {
+            float cell = (m_bounds.height > 0.f) ? (y - m_bounds.top) / m_bounds.height * m_gridSize : 0.f;
+            return std::min(m_gridSize - 1, static_cast<size_t>(std::max(0.f, cell)));
+        }
+
+        size_t cellOf(sf::Vector2f p) const
+        {
+            return row(p.y) * m_gridSize + column(p.x);
+        }
+
+        bool contains(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f p) const
+        {
+            return (cross(a, b, p) >= 0.f) && (cross(b, c, p) >= 0.f) && (cross(c, a, p) >= 0.f);
+        }
+
+        bool isEar(size_t previous, size_t current, size_t next) const
+        {
+            if (m_reflex[current])
+                return false;
+
+            //Only reflex corners can lie inside a convex corner's triangle
+            if (m_reflexCount == 0)
+                return true;
+
+            sf::Vector2f a = point(previous);
+            sf::Vector2f b = point(current);
+            sf::Vector2f c = point(next);
+
+            size_t left = column(std::min(a.x, std::min(b.x, c.x)));
+            size_t right = column(std::max(a.x, std::max(b.x, c.x)));
+            size_t top = row(std::min(a.y, std::min(b.y, c.y)));
+            size_t bottom = row(std::max(a.y, std::max(b.y, c.y)));
+
+            for (size_t y = top; y <= bottom; ++y)
+            {
+                for (size_t x = left; x <= right; ++x)
+                {
+                    size_t cell = y * m_gridSize + x;
+
+                    for (size_t j = m_cellStart[cell]; j < m_cellStart[cell + 1]; ++j)
+                    {
+                        size_t i = m_cells[j];
+                        if (m_removed[i] || !m_reflex[i] || (i == previous) || (i == current) || (i == next))
+                            continue;
+
+                        //Points on top of a corner of the ear don't block it
+                        sf::Vector2f p = point(i);
+                        if (contains(a, b, c, p) && (p != a) && (p != b) && (p != c))
+                            return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        void remove(size_t index)
+        {
+            size_t previous = m_previous[index];
+            size_t next = m_next[index];
+
+            m_next[previous] = next;
+            m_previous[next] = previous;
+            m_removed[index] = true;
+            --m_remaining;
+
+            if (m_reflex[index])
+                --m_reflexCount;
+
+            updateReflex(previous);
+            updateReflex(next);
+        }
+
+        const float* m_points;
+        std::vector<size_t> m_previous;
+        std::vector<size_t> m_next;
+        std::vector<char> m_reflex;
+        std::vector<char> m_removed;
+        long m_reflexCount;
+        size_t m_remaining;
+        sf::FloatRect m_bounds;
+        size_t m_gridSize;
+        std::vector<size_t> m_cellStart;
+        std::vector<size_t> m_cells;
+    };
+}
+
+size_t sfTessellator_fillConvex(const float* points, size_t count, DUbyte r, DUbyte g, DUbyte b, DUbyte a, DInt textureLeft, DInt textureTop, DInt textureWidth, DInt textureHeight, void* vertices, float* bounds)
+{
+    if (count < 3)
+        return 0;
+
+    sf::FloatRect rect = computeBounds(points, count);
+    FillVertex fill(rect, sf::Color(r, g, b, a), sf::IntRect(textureLeft, textureTop, textureWidth, textureHeight));
+    sf::Vertex* output = static_cast<sf::Vertex*>(vertices);
+
+    output[0] = fill(sf::Vector2f(rect.left + rect.width / 2, rect.top + rect.height / 2));
+    for (size_t i = 0; i < count; ++i)
+        output[i + 1] = fill(pointAt(points, i));
+    output[count + 1] = output[1];
+
+    storeBounds(rect, bounds);
+
+    return count + 2;
+}
+
+size_t sfTessellator_fillConcave(const float* points, size_t count, DUbyte r, DUbyte g, DUbyte b, DUbyte a, DInt textureLeft, DInt textureTop, DInt textureWidth, DInt textureHeight, void* vertices, float* bounds)
+{
+    if (count < 3)
+        return 0;
+
+    sf::FloatRect rect = computeBounds(points, count);
+    FillVertex fill(rect, sf::Color(r, g, b, a), sf::IntRect(textureLeft, textureTop, textureWidth, textureHeight));
+    sf::Vertex* output = static_cast<sf::Vertex*>(vertices);
+    size_t written = 0;
+
+    EarClipper clipper(points, count);
+    clipper.clip([&](size_t first, size_t second, size_t third)
+    {
+        output[written++] = fill(pointAt(points, first));
+        output[written++] = fill(pointAt(points, second));
+        output[written++] = fill(pointAt(points, third));
+    });
+
+    storeBounds(rect, bounds);
+
+    return written;
+}
+
+size_t sfTessellator_outline(const float* points, size_t count, float thickness, DInt join, float miterLimit, DUbyte r, DUbyte g, DUbyte b, DUbyte a, void* vertices, float* bounds)
+{
+    if (count < 3)
+        return 0;
+
+    sf::Color color(r, g, b, a);
+    sf::Vertex* output = static_cast<sf::Vertex*>(vertices);
+    size_t written = 0;
+
+    //The normals computed below point inwards on clockwise polygons
+    float direction = (signedArea(points, count) > 0.f) ? -1.f : 1.f;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        sf::Vector2f p0 = pointAt(points, (i + count - 1) % count);
+        sf::Vector2f p1 = pointAt(points, i);
+        sf::Vector2f p2 = pointAt(points, (i + 1) % count);
+
+        sf::Vector2f n1 = computeNormal(p0, p1) * direction;
+        sf::Vector2f n2 = computeNormal(p1, p2) * direction;
+
+        //The miter is 1 / cos(angle / 2) times longer than the thickness
+        float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
+        sf::Vector2f miter = (factor != 0.f) ? (n1 + n2) / factor : n1;
+        float length = std::sqrt(miter.x * miter.x + miter.y * miter.y);
+
+        if ((join == sfTessellatorMiter) && (factor != 0.f) && (length <= miterLimit))
+        {
+            output[written++] = sf::Vertex(p1, color);
+            output[written++] = sf::Vertex(p1 + miter * thickness, color);
+        }
+        else
+        {
+            output[written++] = sf::Vertex(p1, color);
+            output[written++] = sf::Vertex(p1 + n1 * thickness, color);
+            output[written++] = sf::Vertex(p1, color);
+            output[written++] = sf::Vertex(p1 + n2 * thickness, color);
+        }
+    }
+
+    //Repeat the first corner to close the strip
+    output[written] = output[0];
+    output[written + 1] = output[1];
+    written += 2;
+
+    sf::FloatRect rect(output[0].position, sf::Vector2f());
+    for (size_t i = 0; i < written; ++i)
+    {
+        sf::Vector2f position = output[i].position;
+        float right = std::max(rect.left + rect.width, position.x);
+        float bottom = std::max(rect.top + rect.height, position.y);
+
+        rect.left = std::min(rect.left, position.x);
+        rect.top = std::min(rect.top, position.y);
+        rect.width = right - rect.left;
+        rect.height = bottom - rect.top;
+    }
+
+    storeBounds(rect, bounds);
+
+    return written;
+}
@@ -0,0 +1,50 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_TESSELLATOR_H
+#define DSFML_TESSELLATOR_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <stddef.h>
+
+//Ways the corners of an outline can be joined
+typedef enum
+{
+    sfTessellatorMiter,
+    sfTessellatorBevel
+} sfTessellatorJoin;
+
+//Tessellate the inside of a convex polygon as a fan around the center of its bounds, writing count + 2 vertices
+DSFML_GRAPHICS_API size_t sfTessellator_fillConvex(const float* points, size_t count, DUbyte r, DUbyte g, DUbyte b, DUbyte a, DInt textureLeft, DInt textureTop, DInt textureWidth, DInt textureHeight, void* vertices, float* bounds);
+
+//Tessellate the inside of any simple polygon into triangles by ear clipping, writing at most (count - 2) * 3 vertices
+DSFML_GRAPHICS_API size_t sfTessellator_fillConcave(const float* points, size_t count, DUbyte r, DUbyte g, DUbyte b, DUbyte a, DInt textureLeft, DInt textureTop, DInt textureWidth, DInt textureHeight, void* vertices, float* bounds);
+
+//Tessellate the outline of a polygon as a triangle strip, writing at most count * 4 + 2 vertices
+DSFML_GRAPHICS_API size_t sfTessellator_outline(const float* points, size_t count, float thickness, DInt join, float miterLimit, DUbyte r, DUbyte g, DUbyte b, DUbyte a, void* vertices, float* bounds);
+
+#endif // DSFML_TESSELLATOR_H
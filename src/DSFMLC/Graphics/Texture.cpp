@@ -30,6 +30,11 @@
 #include <DSFMLC/Graphics/ImageStruct.h>
 #include <DSFMLC/Graphics/RenderWindowStruct.h>
 #include <DSFMLC/Window/WindowStruct.h>
+#include <DSFMLC/Graphics/GLFunctions.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <memory>
 
 //Construct a new texture
 sfTexture* sfTexture_construct(void)
@@ -73,6 +78,52 @@ DBool sfTexture_loadFromImage(sfTexture* texture, const sfImage* image, DInt lef
     return texture->This->loadFromImage(image->This, rect)?DTrue:DFalse;
 }
 
+DBool sfTexture_loadFromMipmaps(sfTexture* texture, const sfImage* const* levels, size_t count)
+{
+    if (count == 0)
+        return DFalse;
+
+    sf::Vector2u size = levels[0]->This.getSize();
+    for (size_t i = 1; i < count; ++i)
+    {
+        size = sf::Vector2u(std::max(1u, size.x / 2), std::max(1u, size.y / 2));
+        sf::Vector2u levelSize = levels[i]->This.getSize();
+
+        if ((levelSize.x != size.x) || (levelSize.y != size.y))
+        {
+            sf::err() << "Failed to load mipmaps, level " << i << " is " << levelSize.x << "x" << levelSize.y
+                      << " instead of " << size.x << "x" << size.y << std::endl;
+            return DFalse;
+        }
+    }
+
+    if (!texture->This->loadFromImage(levels[0]->This))
+        return DFalse;
+
+    std::unique_ptr<sf::Context> context;
+    if (!sf::Context::getActiveContext())
+        context.reset(new sf::Context);
+
+    GLint binding;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &binding);
+    glBindTexture(GL_TEXTURE_2D, texture->This->getNativeHandle());
+
+    for (size_t i = 1; i < count; ++i)
+    {
+        sf::Vector2u levelSize = levels[i]->This.getSize();
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), GL_RGBA, static_cast<GLsizei>(levelSize.x), static_cast<GLsizei>(levelSize.y),
+                     0, GL_RGBA, GL_UNSIGNED_BYTE, levels[i]->This.getPixelsPtr());
+    }
+
+    //SFML doesn't know about these levels, so changing the smoothness afterwards stops using them
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(count - 1));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, texture->This->isSmooth() ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST);
+
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(binding));
+
+    return DTrue;
+}
+
 sfTexture* sfTexture_copy(const sfTexture* texture)
 {
     return new sfTexture(*texture);
@@ -52,6 +52,9 @@ DSFML_GRAPHICS_API DBool sfTexture_loadFromStream(sfTexture* texture, DStream* s
 //Create a new texture from an image
 DSFML_GRAPHICS_API DBool sfTexture_loadFromImage(sfTexture* texture, const sfImage* image, DInt left, DInt top, DInt width, DInt height);
 
+//Create a new texture from an image and its mipmaps, each half the size of the previous one
+DSFML_GRAPHICS_API DBool sfTexture_loadFromMipmaps(sfTexture* texture, const sfImage* const* levels, size_t count);
+
 //Copy an existing texture
 DSFML_GRAPHICS_API sfTexture* sfTexture_copy(const sfTexture* texture);
 
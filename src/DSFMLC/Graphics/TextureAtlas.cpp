@@ -0,0 +1,278 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/TextureAtlas.h>
+#include <DSFMLC/Graphics/TextureAtlasStruct.h>
+#include <DSFMLC/Graphics/ImageStruct.h>
+#include <DSFMLC/Graphics/TextureStruct.h>
+#include <DSFMLC/Graphics/Parallel.hpp>
+#include <DSFMLC/Graphics/RectPacker.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+namespace
+{
+    //Turn an image a quarter turn clockwise
+    sf::Image rotate(const sf::Image& image)
+    {
+        sf::Vector2u size = image.getSize();
+        const sf::Uint8* source = image.getPixelsPtr();
+        std::vector<sf::Uint8> pixels(static_cast<std::size_t>(size.x) * size.y * 4);
+
+        for (unsigned int y = 0; y < size.y; ++y)
+        {
+            for (unsigned int x = 0; x < size.x; ++x)
+            {
+                std::size_t from = (static_cast<std::size_t>(y) * size.x + x) * 4;
+                std::size_t to = (static_cast<std::size_t>(x) * size.y + (size.y - 1 - y)) * 4;
+                std::copy(source + from, source + from + 4, pixels.begin() + to);
+            }
+        }
+
+        sf::Image rotated;
+        rotated.create(size.y, size.x, &pixels[0]);
+
+        return rotated;
+    }
+
+    DBool addSource(sfTextureAtlas* atlas, const sfTextureAtlasSource& source)
+    {
+        if (atlas->built)
+        {
+            sf::err() << "Failed to add \"" << source.key << "\" to texture atlas: the atlas was already built" << std::endl;
+            return DFalse;
+        }
+
+        if (!atlas->keys.insert(source.key).second)
+        {
+            sf::err() << "Failed to add \"" << source.key << "\" to texture atlas: the key is already used" << std::endl;
+            return DFalse;
+        }
+
+        atlas->sources.push_back(source);
+
+        return DTrue;
+    }
+}
+
+sfTextureAtlas* sfTextureAtlas_construct(DUint maxPageWidth, DUint maxPageHeight, DUint padding, DBool allowRotation, DInt packing)
+{
+    sfTextureAtlas* atlas = new sfTextureAtlas;
+
+    atlas->maxPageWidth = maxPageWidth;
+    atlas->maxPageHeight = maxPageHeight;
+    atlas->padding = padding;
+    atlas->allowRotation = allowRotation == DTrue;
+    atlas->packing = packing;
+
+    return atlas;
+}
+
+void sfTextureAtlas_destroy(sfTextureAtlas* atlas)
+{
+    delete atlas;
+}
+
+DBool sfTextureAtlas_addImage(sfTextureAtlas* atlas, const char* key, size_t keyLength, const sfImage* image)
+{
+    sfTextureAtlasSource source;
+    source.key.assign(key, keyLength);
+    source.image = image->This;
+
+    return addSource(atlas, source);
+}
+
+DBool sfTextureAtlas_addFile(sfTextureAtlas* atlas, const char* key, size_t keyLength, const char* filename, size_t filenameLength)
+{
+    sfTextureAtlasSource source;
+    source.key.assign(key, keyLength);
+    source.filename.assign(filename, filenameLength);
+
+    return addSource(atlas, source);
+}
+
+DBool sfTextureAtlas_build(sfTextureAtlas* atlas)
+{
+    if (atlas->built)
+    {
+        sf::err() << "Failed to build texture atlas: the atlas was already built" << std::endl;
+        return DFalse;
+    }
+
+    atlas->built = true;
+    std::vector<sfTextureAtlasSource>& sources = atlas->sources;
+
+    //Decoding is the slowest part, so files are loaded side by side
+    std::vector<char> loaded(sources.size(), 1);
+    parallel::forEach(sources.size(), [&](std::size_t i)
+    {
+        if (!sources[i].filename.empty())
+            loaded[i] = sources[i].image.loadFromFile(sources[i].filename);
+    });
+
+    bool success = true;
+    std::vector<std::size_t> packed;
+    std::vector<sf::Vector2u> sizes;
+    unsigned int padding = atlas->padding;
+
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+        sf::Vector2u size = sources[i].image.getSize();
+
+        if (!loaded[i] || !size.x || !size.y)
+        {
+            sf::err() << "Failed to add \"" << sources[i].key << "\" to texture atlas: the image is empty" << std::endl;
+            success = false;
+            continue;
+        }
+
+        //Each image keeps the padding on its right and bottom, the pages have it on their left and top
+        packed.push_back(i);
+        sizes.push_back(sf::Vector2u(size.x + padding, size.y + padding));
+    }
+
+    unsigned int maximumSize = sf::Texture::getMaximumSize();
+    unsigned int pageWidth = std::min(atlas->maxPageWidth, maximumSize);
+    unsigned int pageHeight = std::min(atlas->maxPageHeight, maximumSize);
+
+    if ((pageWidth <= padding) || (pageHeight <= padding))
+    {
+        sf::err() << "Failed to build texture atlas: the pages are smaller than the padding" << std::endl;
+        return DFalse;
+    }
+
+    int algorithms = atlas->packing ? atlas->packing : (rectpacker::MaxRects | rectpacker::Skyline);
+
+    sf::Clock clock;
+    rectpacker::Result result = rectpacker::pack(sizes, pageWidth - padding, pageHeight - padding,
+                                                 atlas->allowRotation, algorithms);
+    atlas->packTime = clock.getElapsedTime().asMicroseconds();
+
+    if (!result.success)
+    {
+        sf::err() << "Failed to build texture atlas: an image is larger than the maximum page size ("
+                  << pageWidth << "x" << pageHeight << ")" << std::endl;
+        return DFalse;
+    }
+
+    std::vector<sf::Image> pageImages(result.binSizes.size());
+    unsigned long long usedArea = 0;
+    unsigned long long pageArea = 0;
+
+    for (std::size_t page = 0; page < pageImages.size(); ++page)
+    {
+        sf::Vector2u size(result.binSizes[page].x + padding, result.binSizes[page].y + padding);
+        pageImages[page].create(size.x, size.y, sf::Color::Transparent);
+        pageArea += static_cast<unsigned long long>(size.x) * size.y;
+    }
+
+    for (std::size_t i = 0; i < packed.size(); ++i)
+    {
+        const sfTextureAtlasSource& source = sources[packed[i]];
+        const rectpacker::Placement& placement = result.placements[i];
+        sf::Vector2u size = source.image.getSize();
+
+        if (placement.rotated)
+            std::swap(size.x, size.y);
+
+        sfTextureAtlasRegion region;
+        region.page = placement.bin;
+        region.rect = sf::IntRect(placement.x + padding, placement.y + padding, size.x, size.y);
+        region.rotated = placement.rotated;
+        atlas->regions[source.key] = region;
+
+        usedArea += static_cast<unsigned long long>(size.x) * size.y;
+    }
+
+    //Every image covers its own part of its page, so they can be copied in at the same time
+    parallel::forEach(packed.size(), [&](std::size_t i)
+    {
+        const sfTextureAtlasSource& source = sources[packed[i]];
+        const sfTextureAtlasRegion& region = atlas->regions.find(source.key)->second;
+
+        if (region.rotated)
+            pageImages[region.page].copy(rotate(source.image), region.rect.left, region.rect.top);
+        else
+            pageImages[region.page].copy(source.image, region.rect.left, region.rect.top);
+    });
+
+    for (std::size_t page = 0; page < pageImages.size(); ++page)
+    {
+        std::unique_ptr<sf::Texture> texture(new sf::Texture);
+        if (!texture->loadFromImage(pageImages[page]))
+            success = false;
+
+        atlas->pages.push_back(std::move(texture));
+    }
+
+    atlas->occupancy = pageArea ? static_cast<float>(static_cast<double>(usedArea) / pageArea) : 0.f;
+
+    //The images now live on the graphics card
+    std::vector<sfTextureAtlasSource>().swap(atlas->sources);
+    std::unordered_set<std::string>().swap(atlas->keys);
+
+    return success ? DTrue : DFalse;
+}
+
+DUint sfTextureAtlas_getPageCount(const sfTextureAtlas* atlas)
+{
+    return static_cast<DUint>(atlas->pages.size());
+}
+
+sfTexture* sfTextureAtlas_getPage(const sfTextureAtlas* atlas, DUint index)
+{
+    if (index >= atlas->pages.size())
+        return NULL;
+
+    return new sfTexture(atlas->pages[index].get());
+}
+
+DBool sfTextureAtlas_find(const sfTextureAtlas* atlas, const char* key, size_t keyLength, DUint* page, DInt* left, DInt* top, DInt* width, DInt* height, DBool* rotated)
+{
+    std::map<std::string, sfTextureAtlasRegion>::const_iterator it = atlas->regions.find(std::string(key, keyLength));
+
+    if (it == atlas->regions.end())
+        return DFalse;
+
+    const sfTextureAtlasRegion& region = it->second;
+    *page = region.page;
+    *left = region.rect.left;
+    *top = region.rect.top;
+    *width = region.rect.width;
+    *height = region.rect.height;
+    *rotated = region.rotated ? DTrue : DFalse;
+
+    return DTrue;
+}
+
+void sfTextureAtlas_getStatistics(const sfTextureAtlas* atlas, DUint* imageCount, float* occupancy, DLong* packTime)
+{
+    *imageCount = static_cast<DUint>(atlas->regions.size());
+    *occupancy = atlas->occupancy;
+    *packTime = atlas->packTime;
+}
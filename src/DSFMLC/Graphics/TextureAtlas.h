@@ -0,0 +1,62 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_TEXTUREATLAS_H
+#define DSFML_TEXTUREATLAS_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <DSFMLC/Graphics/Types.h>
+#include <stddef.h>
+
+//Construct a new texture atlas
+DSFML_GRAPHICS_API sfTextureAtlas* sfTextureAtlas_construct(DUint maxPageWidth, DUint maxPageHeight, DUint padding, DBool allowRotation, DInt packing);
+
+//Destroy an existing texture atlas
+DSFML_GRAPHICS_API void sfTextureAtlas_destroy(sfTextureAtlas* atlas);
+
+//Add a copy of an image to be packed in the atlas
+DSFML_GRAPHICS_API DBool sfTextureAtlas_addImage(sfTextureAtlas* atlas, const char* key, size_t keyLength, const sfImage* image);
+
+//Add an image file to be loaded and packed in the atlas
+DSFML_GRAPHICS_API DBool sfTextureAtlas_addFile(sfTextureAtlas* atlas, const char* key, size_t keyLength, const char* filename, size_t filenameLength);
+
+//Load, pack and upload everything that was added to the atlas
+DSFML_GRAPHICS_API DBool sfTextureAtlas_build(sfTextureAtlas* atlas);
+
+//Get the number of textures the atlas was packed into
+DSFML_GRAPHICS_API DUint sfTextureAtlas_getPageCount(const sfTextureAtlas* atlas);
+
+//Get one of the textures of the atlas
+DSFML_GRAPHICS_API sfTexture* sfTextureAtlas_getPage(const sfTextureAtlas* atlas, DUint index);
+
+//Find where an image was packed in the atlas
+DSFML_GRAPHICS_API DBool sfTextureAtlas_find(const sfTextureAtlas* atlas, const char* key, size_t keyLength, DUint* page, DInt* left, DInt* top, DInt* width, DInt* height, DBool* rotated);
+
+//Get the number of images packed, the ratio of page area they cover, and the time spent packing in microseconds
+DSFML_GRAPHICS_API void sfTextureAtlas_getStatistics(const sfTextureAtlas* atlas, DUint* imageCount, float* occupancy, DLong* packTime);
+
+#endif // DSFML_TEXTUREATLAS_H
@@ -0,0 +1,89 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_TEXTUREATLASSTRUCT_H
+#define DSFML_TEXTUREATLASSTRUCT_H
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+//An image waiting to be packed, either copied in or still to be loaded from a file
+struct sfTextureAtlasSource
+{
+    std::string key;
+    std::string filename;
+    sf::Image image;
+};
+
+//Where an image was packed
+struct sfTextureAtlasRegion
+{
+    unsigned int page;
+    sf::IntRect rect;
+    bool rotated;
+};
+
+//Internal structure of sfTextureAtlas
+struct sfTextureAtlas
+{
+    sfTextureAtlas() :
+    maxPageWidth(2048),
+    maxPageHeight(2048),
+    padding(1),
+    allowRotation(false),
+    packing(0),
+    built(false),
+    occupancy(0),
+    packTime(0)
+    {
+    }
+
+    unsigned int maxPageWidth;
+    unsigned int maxPageHeight;
+    unsigned int padding;
+    bool allowRotation;
+    int packing;
+    bool built;
+
+    std::vector<sfTextureAtlasSource> sources;
+    std::unordered_set<std::string> keys;
+    std::map<std::string, sfTextureAtlasRegion> regions;
+
+    //Held by pointer so that the sfTexture wrappers given out stay valid
+    std::vector<std::unique_ptr<sf::Texture>> pages;
+
+    float occupancy;
+    long long packTime;
+};
+
+#endif // DSFML_TEXTUREATLASSTRUCT_H
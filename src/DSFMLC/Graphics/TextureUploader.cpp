@@ -0,0 +1,319 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/TextureUploader.h>
+#include <DSFMLC/Graphics/TextureUploaderStruct.h>
+#include <DSFMLC/Graphics/TextureStruct.h>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <memory>
+
+namespace
+{
+    //Restores the pixel unpack buffer and texture bindings when leaving a scope
+    class BindingSaver
+    {
+    public:
+        BindingSaver()
+        {
+            glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &m_buffer);
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &m_texture);
+        }
+
+        ~BindingSaver()
+        {
+            glext::bindBuffer(GL_PIXEL_UNPACK_BUFFER, static_cast<GLuint>(m_buffer));
+            glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(m_texture));
+        }
+
+    private:
+        GLint m_buffer;
+        GLint m_texture;
+    };
+
+    void initialize(sfTextureUploader* uploader)
+    {
+        if (uploader->initialized)
+            return;
+
+        uploader->initialized = true;
+        uploader->useBuffers = glext::hasMappedBuffers();
+
+        if (!uploader->useBuffers)
+            return;
+
+        BindingSaver saver;
+        glext::GLsizeiptr size = static_cast<glext::GLsizeiptr>(uploader->slotSize) * uploader->slots.size();
+
+        glext::genBuffers(1, &uploader->buffer);
+        glext::bindBuffer(GL_PIXEL_UNPACK_BUFFER, uploader->buffer);
+
+        if (glext::hasPersistentBuffers())
+        {
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glext::bufferStorage(GL_PIXEL_UNPACK_BUFFER, size, NULL, flags);
+            uploader->mapping = static_cast<DUbyte*>(glext::mapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags));
+
+            //Without a lasting mapping, each slot is mapped for the time of its upload instead
+            uploader->persistent = uploader->mapping != NULL;
+        }
+        else
+        {
+            glext::bufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        }
+    }
+
+    bool isSignaled(GLenum status)
+    {
+        return (status == GL_ALREADY_SIGNALED) || (status == GL_CONDITION_SATISFIED);
+    }
+
+    //Wait until the GPU is done reading from a slot
+    void waitForSlot(sfTextureUploader* uploader, sfTextureUploaderSlot& slot, bool countStall)
+    {
+        if (!slot.fence)
+            return;
+
+        GLenum status = glext::clientWaitSync(slot.fence, 0, 0);
+
+        if (!isSignaled(status))
+        {
+            if (countStall)
+                uploader->stallCount++;
+
+            do
+            {
+                status = glext::clientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+            }
+            while (!isSignaled(status) && (status != GL_WAIT_FAILED));
+        }
+
+        glext::deleteSync(slot.fence);
+        slot.fence = NULL;
+    }
+
+    sfTextureUploaderSlot* findSlot(sfTextureUploader* uploader, DUlong ticket)
+    {
+        for (std::size_t i = 0; i < uploader->slots.size(); ++i)
+        {
+            if ((uploader->slots[i].ticket == ticket) && uploader->slots[i].fence)
+                return &uploader->slots[i];
+        }
+
+        return NULL;
+    }
+}
+
+sfTextureUploader* sfTextureUploader_construct(DUint bufferSize, DUint bufferCount)
+{
+    sfTextureUploader* uploader = new sfTextureUploader;
+
+    uploader->slotSize = bufferSize;
+    uploader->slots.resize(bufferCount ? bufferCount : 1);
+
+    return uploader;
+}
+
+void sfTextureUploader_destroy(sfTextureUploader* uploader)
+{
+    if (uploader->buffer)
+    {
+        std::unique_ptr<sf::Context> context;
+        if (!sf::Context::getActiveContext())
+            context.reset(new sf::Context);
+
+        for (std::size_t i = 0; i < uploader->slots.size(); ++i)
+        {
+            if (uploader->slots[i].fence)
+                glext::deleteSync(uploader->slots[i].fence);
+        }
+
+        //Deleting the buffer also unmaps it
+        glext::deleteBuffers(1, &uploader->buffer);
+    }
+
+    delete uploader;
+}
+
+DUbyte* sfTextureUploader_begin(sfTextureUploader* uploader, DUint width, DUint height)
+{
+    if (uploader->staging)
+    {
+        sf::err() << "Failed to begin texture upload: the previous upload was not committed" << std::endl;
+        return NULL;
+    }
+
+    initialize(uploader);
+
+    std::size_t size = static_cast<std::size_t>(width) * height * 4;
+    uploader->stagingWidth = width;
+    uploader->stagingHeight = height;
+    uploader->stagingInBuffer = false;
+
+    if (uploader->useBuffers && (size <= uploader->slotSize))
+    {
+        sfTextureUploaderSlot& slot = uploader->slots[uploader->next];
+        std::size_t offset = static_cast<std::size_t>(uploader->next) * uploader->slotSize;
+
+        waitForSlot(uploader, slot, true);
+
+        if (uploader->persistent)
+        {
+            uploader->staging = uploader->mapping + offset;
+        }
+        else
+        {
+            BindingSaver saver;
+            glext::bindBuffer(GL_PIXEL_UNPACK_BUFFER, uploader->buffer);
+
+            //The fence was waited on, so there is no need for the driver to synchronize again
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+            uploader->staging = static_cast<DUbyte*>(glext::mapBufferRange(GL_PIXEL_UNPACK_BUFFER, offset, size, flags));
+        }
+
+        if (uploader->staging)
+        {
+            uploader->stagingSlot = uploader->next;
+            uploader->stagingInBuffer = true;
+            uploader->next = (uploader->next + 1) % uploader->slots.size();
+
+            return uploader->staging;
+        }
+    }
+
+    uploader->fallback.resize(size ? size : 1);
+    uploader->staging = &uploader->fallback[0];
+
+    return uploader->staging;
+}
+
+DUlong sfTextureUploader_commit(sfTextureUploader* uploader, sfTexture* texture, DUint x, DUint y)
+{
+    if (!uploader->staging)
+    {
+        sf::err() << "Failed to commit texture upload: no upload was begun" << std::endl;
+        return 0;
+    }
+
+    unsigned int width = uploader->stagingWidth;
+    unsigned int height = uploader->stagingHeight;
+    sf::Vector2u size = texture->This->getSize();
+    bool fits = (x + width <= size.x) && (y + height <= size.y);
+
+    if (!fits)
+        sf::err() << "Failed to commit texture upload: the pixels don't fit in the texture" << std::endl;
+
+    DUlong ticket = fits ? uploader->nextTicket++ : 0;
+
+    if (uploader->stagingInBuffer)
+    {
+        BindingSaver saver;
+        glext::bindBuffer(GL_PIXEL_UNPACK_BUFFER, uploader->buffer);
+
+        if (!uploader->persistent)
+            glext::unmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        if (fits)
+        {
+            //With a buffer bound the pixel pointer is an offset in it, and the copy happens on the GPU's time
+            std::size_t offset = static_cast<std::size_t>(uploader->stagingSlot) * uploader->slotSize;
+
+            glBindTexture(GL_TEXTURE_2D, texture->This->getNativeHandle());
+            glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<const void*>(offset));
+
+            sfTextureUploaderSlot& slot = uploader->slots[uploader->stagingSlot];
+            slot.fence = glext::fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            slot.ticket = ticket;
+        }
+    }
+    else if (fits)
+    {
+        texture->This->update(uploader->staging, width, height, x, y);
+        uploader->fallbackCount++;
+    }
+
+    uploader->staging = NULL;
+
+    if (fits)
+    {
+        uploader->uploadCount++;
+        uploader->uploadedBytes += static_cast<unsigned long long>(width) * height * 4;
+    }
+
+    return ticket;
+}
+
+DBool sfTextureUploader_isComplete(sfTextureUploader* uploader, DUlong ticket)
+{
+    if (!ticket || (ticket >= uploader->nextTicket))
+        return DFalse;
+
+    sfTextureUploaderSlot* slot = findSlot(uploader, ticket);
+
+    if (!slot)
+        return DTrue;
+
+    if (!isSignaled(glext::clientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0)))
+        return DFalse;
+
+    glext::deleteSync(slot->fence);
+    slot->fence = NULL;
+
+    return DTrue;
+}
+
+void sfTextureUploader_wait(sfTextureUploader* uploader, DUlong ticket)
+{
+    sfTextureUploaderSlot* slot = findSlot(uploader, ticket);
+
+    if (slot)
+        waitForSlot(uploader, *slot, false);
+}
+
+DBool sfTextureUploader_isPersistent(sfTextureUploader* uploader)
+{
+    initialize(uploader);
+
+    return uploader->persistent ? DTrue : DFalse;
+}
+
+void sfTextureUploader_getStatistics(const sfTextureUploader* uploader, DUint* uploadCount, DUlong* uploadedBytes, DUint* stallCount, DUint* fallbackCount)
+{
+    *uploadCount = uploader->uploadCount;
+    *uploadedBytes = uploader->uploadedBytes;
+    *stallCount = uploader->stallCount;
+    *fallbackCount = uploader->fallbackCount;
+}
+
+DBool sfTextureUploader_isAvailable(void)
+{
+    std::unique_ptr<sf::Context> context;
+    if (!sf::Context::getActiveContext())
+        context.reset(new sf::Context);
+
+    return glext::hasMappedBuffers() ? DTrue : DFalse;
+}
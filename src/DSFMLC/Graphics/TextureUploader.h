@@ -0,0 +1,61 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_TEXTUREUPLOADER_H
+#define DSFML_TEXTUREUPLOADER_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <DSFMLC/Graphics/Types.h>
+
+//Construct a new texture uploader with a ring of staging buffers
+DSFML_GRAPHICS_API sfTextureUploader* sfTextureUploader_construct(DUint bufferSize, DUint bufferCount);
+
+//Destroy an existing texture uploader
+DSFML_GRAPHICS_API void sfTextureUploader_destroy(sfTextureUploader* uploader);
+
+//Get a staging area to write the RGBA pixels of the next upload to
+DSFML_GRAPHICS_API DUbyte* sfTextureUploader_begin(sfTextureUploader* uploader, DUint width, DUint height);
+
+//Start copying the staged pixels to a texture, returning a ticket for the upload or 0 on failure
+DSFML_GRAPHICS_API DUlong sfTextureUploader_commit(sfTextureUploader* uploader, sfTexture* texture, DUint x, DUint y);
+
+//Tell whether an upload has finished, without waiting
+DSFML_GRAPHICS_API DBool sfTextureUploader_isComplete(sfTextureUploader* uploader, DUlong ticket);
+
+//Wait until an upload has finished
+DSFML_GRAPHICS_API void sfTextureUploader_wait(sfTextureUploader* uploader, DUlong ticket);
+
+//Tell whether the staging buffers stay mapped the whole time
+DSFML_GRAPHICS_API DBool sfTextureUploader_isPersistent(sfTextureUploader* uploader);
+
+//Get the number of uploads and bytes, how many times the CPU waited on the GPU, and how many uploads went through client memory
+DSFML_GRAPHICS_API void sfTextureUploader_getStatistics(const sfTextureUploader* uploader, DUint* uploadCount, DUlong* uploadedBytes, DUint* stallCount, DUint* fallbackCount);
+
+//Tell whether the system can upload through buffers in the background
+DSFML_GRAPHICS_API DBool sfTextureUploader_isAvailable(void);
+
+#endif // DSFML_TEXTUREUPLOADER_H
@@ -0,0 +1,101 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_TEXTUREUPLOADERSTRUCT_H
+#define DSFML_TEXTUREUPLOADERSTRUCT_H
+
+#include <DSFMLC/Graphics/GLFunctions.hpp>
+#include <DSFMLC/Config.h>
+#include <vector>
+
+//A part of the staging buffer and the fence of the last upload read from it
+struct sfTextureUploaderSlot
+{
+    sfTextureUploaderSlot() :
+    fence(NULL),
+    ticket(0)
+    {
+    }
+
+    glext::GLsync fence;
+    DUlong ticket;
+};
+
+//Internal structure of sfTextureUploader
+struct sfTextureUploader
+{
+    sfTextureUploader() :
+    slotSize(0),
+    initialized(false),
+    useBuffers(false),
+    persistent(false),
+    buffer(0),
+    mapping(NULL),
+    next(0),
+    staging(NULL),
+    stagingSlot(0),
+    stagingInBuffer(false),
+    stagingWidth(0),
+    stagingHeight(0),
+    nextTicket(1),
+    uploadCount(0),
+    uploadedBytes(0),
+    stallCount(0),
+    fallbackCount(0)
+    {
+    }
+
+    unsigned int slotSize;
+    std::vector<sfTextureUploaderSlot> slots;
+
+    //Buffers are created on first use, when a context is active
+    bool initialized;
+    bool useBuffers;
+    bool persistent;
+    GLuint buffer;
+    DUbyte* mapping;
+    unsigned int next;
+
+    //The upload between begin and commit
+    DUbyte* staging;
+    unsigned int stagingSlot;
+    bool stagingInBuffer;
+    unsigned int stagingWidth;
+    unsigned int stagingHeight;
+
+    //Used when buffers are unavailable or an upload doesn't fit in a slot
+    std::vector<DUbyte> fallback;
+
+    DUlong nextTicket;
+
+    unsigned int uploadCount;
+    unsigned long long uploadedBytes;
+    unsigned int stallCount;
+    unsigned int fallbackCount;
+};
+
+#endif // DSFML_TEXTUREUPLOADERSTRUCT_H
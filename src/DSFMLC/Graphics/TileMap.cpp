@@ -0,0 +1,417 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/TileMap.h>
+#include <DSFMLC/Graphics/TileMapStruct.h>
+#include <DSFMLC/Graphics/VertexBufferStruct.h>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    std::size_t tileIndex(const sfTileMap* tileMap, unsigned int layer, unsigned int x, unsigned int y)
+    {
+        return (static_cast<std::size_t>(layer) * tileMap->height + y) * tileMap->width + x;
+    }
+
+    void markDirty(sfTileMap* tileMap, unsigned int x, unsigned int y)
+    {
+        tileMap->chunks[(y / tileMap->chunkSize) * tileMap->chunkColumns + x / tileMap->chunkSize].dirty = true;
+    }
+
+    void markAllDirty(sfTileMap* tileMap)
+    {
+        for (std::size_t i = 0; i < tileMap->chunks.size(); ++i)
+            tileMap->chunks[i].dirty = true;
+    }
+
+    //The tile shown in place of a tile, which is another one when it is animated
+    DInt displayedTile(const sfTileMap* tileMap, DInt tile, bool& animated)
+    {
+        animated = false;
+        if (tileMap->animations.empty())
+            return tile;
+
+        std::unordered_map<DInt, sfTileMapAnimation>::const_iterator animation = tileMap->animations.find(tile);
+        if (animation == tileMap->animations.end())
+            return tile;
+
+        animated = true;
+        return animation->second.frames[animation->second.frame];
+    }
+
+    void setTextureCoordinates(const sfTileMap* tileMap, sf::Vertex* quad, DInt tile)
+    {
+        float left = 0;
+        float top = 0;
+
+        if (tileMap->textureColumns > 0)
+        {
+            left = static_cast<float>((static_cast<unsigned int>(tile) % tileMap->textureColumns) * tileMap->textureTileWidth);
+            top = static_cast<float>((static_cast<unsigned int>(tile) / tileMap->textureColumns) * tileMap->textureTileHeight);
+        }
+
+        float right = left + tileMap->textureTileWidth;
+        float bottom = top + tileMap->textureTileHeight;
+
+        quad[0].texCoords = sf::Vector2f(left, top);
+        quad[1].texCoords = sf::Vector2f(right, top);
+        quad[2].texCoords = sf::Vector2f(right, bottom);
+        quad[3].texCoords = sf::Vector2f(left, bottom);
+    }
+
+    void rebuild(sfTileMap* tileMap, DUint index)
+    {
+        sfTileMapChunk& chunk = tileMap->chunks[index];
+        chunk.vertices.clear();
+        chunk.animatedTiles.clear();
+
+        unsigned int firstX = (index % tileMap->chunkColumns) * tileMap->chunkSize;
+        unsigned int firstY = (index / tileMap->chunkColumns) * tileMap->chunkSize;
+        unsigned int lastX = std::min(firstX + tileMap->chunkSize, tileMap->width);
+        unsigned int lastY = std::min(firstY + tileMap->chunkSize, tileMap->height);
+
+        std::size_t tileCount = 0;
+        for (unsigned int layer = 0; layer < tileMap->layerCount; ++layer)
+            for (unsigned int y = firstY; y < lastY; ++y)
+                for (unsigned int x = firstX; x < lastX; ++x)
+                    tileCount += tileMap->tiles[tileIndex(tileMap, layer, x, y)] >= 0;
+        chunk.vertices.resize(tileCount * 4);
+        sf::Vertex* quad = tileCount ? &chunk.vertices[0] : NULL;
+
+        //Layers are drawn in order within the chunk, chunks don't overlap so their order doesn't matter
+        for (unsigned int layer = 0; layer < tileMap->layerCount; ++layer)
+        {
+            for (unsigned int y = firstY; y < lastY; ++y)
+            {
+                const DInt* row = &tileMap->tiles[tileIndex(tileMap, layer, 0, y)];
+
+                for (unsigned int x = firstX; x < lastX; ++x)
+                {
+                    if (row[x] < 0)
+                        continue;
+
+                    bool animated;
+                    DInt tile = displayedTile(tileMap, row[x], animated);
+                    if (animated)
+                        chunk.animatedTiles.push_back(std::make_pair(static_cast<std::size_t>(quad - &chunk.vertices[0]), row[x]));
+
+                    float left = x * tileMap->tileWidth;
+                    float top = y * tileMap->tileHeight;
+                    float right = left + tileMap->tileWidth;
+                    float bottom = top + tileMap->tileHeight;
+
+                    quad[0].position = sf::Vector2f(left, top);
+                    quad[1].position = sf::Vector2f(right, top);
+                    quad[2].position = sf::Vector2f(right, bottom);
+                    quad[3].position = sf::Vector2f(left, bottom);
+                    setTextureCoordinates(tileMap, quad, tile);
+                    quad += 4;
+                }
+            }
+        }
+
+        chunk.dirty = false;
+        chunk.animationVersion = tileMap->animationVersion;
+        chunk.patchBegin = chunk.patchEnd = 0;
+    }
+
+    //Point the animated tiles of a chunk at their current frame
+    void patch(sfTileMap* tileMap, sfTileMapChunk& chunk)
+    {
+        chunk.animationVersion = tileMap->animationVersion;
+
+        for (std::size_t i = 0; i < chunk.animatedTiles.size(); ++i)
+        {
+            std::size_t vertex = chunk.animatedTiles[i].first;
+
+            bool animated;
+            DInt tile = displayedTile(tileMap, chunk.animatedTiles[i].second, animated);
+            setTextureCoordinates(tileMap, &chunk.vertices[vertex], tile);
+
+            if (chunk.patchBegin == chunk.patchEnd)
+            {
+                chunk.patchBegin = vertex;
+                chunk.patchEnd = vertex + 4;
+            }
+            else
+            {
+                chunk.patchBegin = std::min(chunk.patchBegin, vertex);
+                chunk.patchEnd = std::max(chunk.patchEnd, vertex + 4);
+            }
+        }
+    }
+
+    unsigned int chunkCoordinate(float position, float chunkLength, unsigned int count)
+    {
+        float chunk = std::floor(position / chunkLength);
+        return static_cast<unsigned int>(std::max(0.f, std::min(static_cast<float>(count - 1), chunk)));
+    }
+}
+
+sfTileMap* sfTileMap_construct(DUint width, DUint height, DUint layerCount, DUint chunkSize, float tileWidth, float tileHeight)
+{
+    sfTileMap* tileMap = new sfTileMap;
+
+    tileMap->width = width;
+    tileMap->height = height;
+    tileMap->layerCount = layerCount;
+    tileMap->chunkSize = std::max(chunkSize, 1u);
+    tileMap->chunkColumns = (width + tileMap->chunkSize - 1) / tileMap->chunkSize;
+    tileMap->chunkRows = (height + tileMap->chunkSize - 1) / tileMap->chunkSize;
+    tileMap->tileWidth = tileWidth;
+    tileMap->tileHeight = tileHeight;
+
+    tileMap->tiles.assign(static_cast<std::size_t>(width) * height * layerCount, -1);
+    tileMap->chunks.resize(static_cast<std::size_t>(tileMap->chunkColumns) * tileMap->chunkRows);
+
+    return tileMap;
+}
+
+void sfTileMap_destroy(sfTileMap* tileMap)
+{
+    delete tileMap;
+}
+
+void sfTileMap_setTileset(sfTileMap* tileMap, DUint tileWidth, DUint tileHeight, DUint columns)
+{
+    tileMap->textureTileWidth = tileWidth;
+    tileMap->textureTileHeight = tileHeight;
+    tileMap->textureColumns = columns;
+
+    markAllDirty(tileMap);
+}
+
+DBool sfTileMap_setTile(sfTileMap* tileMap, DUint layer, DUint x, DUint y, DInt tile)
+{
+    if ((layer >= tileMap->layerCount) || (x >= tileMap->width) || (y >= tileMap->height))
+        return DFalse;
+
+    DInt& current = tileMap->tiles[tileIndex(tileMap, layer, x, y)];
+    if (current != tile)
+    {
+        current = tile;
+        markDirty(tileMap, x, y);
+    }
+
+    return DTrue;
+}
+
+DInt sfTileMap_getTile(const sfTileMap* tileMap, DUint layer, DUint x, DUint y)
+{
+    if ((layer >= tileMap->layerCount) || (x >= tileMap->width) || (y >= tileMap->height))
+        return -1;
+
+    return tileMap->tiles[tileIndex(tileMap, layer, x, y)];
+}
+
+DBool sfTileMap_setTiles(sfTileMap* tileMap, DUint layer, DUint left, DUint top, DUint width, DUint height, const DInt* tiles)
+{
+    if ((layer >= tileMap->layerCount) || (left > tileMap->width) || (top > tileMap->height) ||
+        (width > tileMap->width - left) || (height > tileMap->height - top))
+    {
+        sf::err() << "Failed to set tiles, the area (" << left << ", " << top << ", " << width << ", " << height
+                  << ") of layer " << layer << " is outside of the map" << std::endl;
+        return DFalse;
+    }
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        const DInt* source = tiles + static_cast<std::size_t>(y) * width;
+        DInt* destination = &tileMap->tiles[tileIndex(tileMap, layer, left, top + y)];
+
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            if (destination[x] != source[x])
+            {
+                destination[x] = source[x];
+                markDirty(tileMap, left + x, top + y);
+            }
+        }
+    }
+
+    return DTrue;
+}
+
+DBool sfTileMap_setAnimation(sfTileMap* tileMap, DInt tile, const DInt* frames, size_t frameCount, DLong frameDuration)
+{
+    if ((tile < 0) || (frameCount == 0) || (frameDuration <= 0))
+    {
+        sf::err() << "Failed to animate tile " << tile << ", it needs at least one frame and a positive frame duration" << std::endl;
+        return DFalse;
+    }
+
+    sfTileMapAnimation& animation = tileMap->animations[tile];
+    animation.frames.assign(frames, frames + frameCount);
+    animation.frameDuration = frameDuration;
+    animation.elapsed = 0;
+    animation.frame = 0;
+
+    //Chunks only remember which of their tiles are animated when they are built
+    markAllDirty(tileMap);
+    return DTrue;
+}
+
+DBool sfTileMap_removeAnimation(sfTileMap* tileMap, DInt tile)
+{
+    if (!tileMap->animations.erase(tile))
+        return DFalse;
+
+    markAllDirty(tileMap);
+    return DTrue;
+}
+
+void sfTileMap_update(sfTileMap* tileMap, DLong elapsed)
+{
+    //Animations only go forward, a negative step would give a frame before the first one
+    if (elapsed <= 0)
+        return;
+
+    bool changed = false;
+
+    for (std::unordered_map<DInt, sfTileMapAnimation>::iterator it = tileMap->animations.begin(); it != tileMap->animations.end(); ++it)
+    {
+        sfTileMapAnimation& animation = it->second;
+        DLong cycle = animation.frameDuration * static_cast<DLong>(animation.frames.size());
+
+        animation.elapsed = (animation.elapsed + elapsed % cycle) % cycle;
+        std::size_t frame = static_cast<std::size_t>(animation.elapsed / animation.frameDuration);
+
+        if (frame != animation.frame)
+        {
+            animation.frame = frame;
+            changed = true;
+        }
+    }
+
+    //Chunks catch up with the new frames when they are next drawn
+    if (changed)
+        ++tileMap->animationVersion;
+}
+
+size_t sfTileMap_prepare(sfTileMap* tileMap, float left, float top, float width, float height)
+{
+    tileMap->visibleChunks.clear();
+    tileMap->rebuiltChunkCount = 0;
+    tileMap->patchedChunkCount = 0;
+    tileMap->visibleTileCount = 0;
+
+    float chunkWidth = tileMap->chunkSize * tileMap->tileWidth;
+    float chunkHeight = tileMap->chunkSize * tileMap->tileHeight;
+
+    if (tileMap->chunks.empty() || !(chunkWidth > 0) || !(chunkHeight > 0))
+        return 0;
+
+    //Nothing to draw when the area is entirely outside of the map
+    if ((left + width < 0) || (top + height < 0) ||
+        (left > tileMap->width * tileMap->tileWidth) || (top > tileMap->height * tileMap->tileHeight))
+        return 0;
+
+    unsigned int firstX = chunkCoordinate(left, chunkWidth, tileMap->chunkColumns);
+    unsigned int firstY = chunkCoordinate(top, chunkHeight, tileMap->chunkRows);
+    unsigned int lastX = chunkCoordinate(left + width, chunkWidth, tileMap->chunkColumns);
+    unsigned int lastY = chunkCoordinate(top + height, chunkHeight, tileMap->chunkRows);
+
+    for (unsigned int y = firstY; y <= lastY; ++y)
+        for (unsigned int x = firstX; x <= lastX; ++x)
+            tileMap->visibleChunks.push_back(y * tileMap->chunkColumns + x);
+
+    return tileMap->visibleChunks.size();
+}
+
+const DUint* sfTileMap_getVisibleChunks(const sfTileMap* tileMap)
+{
+    return tileMap->visibleChunks.empty() ? NULL : &tileMap->visibleChunks[0];
+}
+
+DUint sfTileMap_updateChunk(sfTileMap* tileMap, DUint index, sfVertexBuffer* vertexBuffer, DBool* uploaded)
+{
+    *uploaded = DFalse;
+
+    if (index >= tileMap->chunks.size())
+        return 0;
+
+    sfTileMapChunk& chunk = tileMap->chunks[index];
+    bool patched = false;
+
+    if (chunk.dirty)
+    {
+        rebuild(tileMap, index);
+        ++tileMap->rebuiltChunkCount;
+        ++tileMap->totalRebuildCount;
+        chunk.uploaded = false;
+    }
+    else if ((chunk.animationVersion != tileMap->animationVersion) && !chunk.animatedTiles.empty())
+    {
+        patch(tileMap, chunk);
+        ++tileMap->patchedChunkCount;
+        patched = true;
+    }
+
+    if (vertexBuffer && !chunk.vertices.empty())
+    {
+        if (!chunk.uploaded)
+        {
+            //Buffers start without any storage, and grow when a chunk gets more tiles
+            if (!vertexBuffer->buffer || (vertexBuffer->size < chunk.vertices.size()))
+                vertexBuffer->create(chunk.vertices.size());
+
+            chunk.uploaded = vertexBuffer->update(&chunk.vertices[0], chunk.vertices.size(), 0);
+        }
+        else if (patched && (chunk.patchEnd > chunk.patchBegin))
+        {
+            //Only the vertices of the animated tiles are uploaded again
+            chunk.uploaded = vertexBuffer->update(&chunk.vertices[chunk.patchBegin], chunk.patchEnd - chunk.patchBegin, chunk.patchBegin);
+        }
+
+        *uploaded = chunk.uploaded ? DTrue : DFalse;
+    }
+
+    chunk.patchBegin = chunk.patchEnd = 0;
+    tileMap->visibleTileCount += static_cast<unsigned int>(chunk.vertices.size() / 4);
+
+    return static_cast<DUint>(chunk.vertices.size());
+}
+
+const void* sfTileMap_getChunkVertices(const sfTileMap* tileMap, DUint index)
+{
+    if ((index >= tileMap->chunks.size()) || tileMap->chunks[index].vertices.empty())
+        return NULL;
+
+    return &tileMap->chunks[index].vertices[0];
+}
+
+void sfTileMap_getStatistics(const sfTileMap* tileMap, DUint* chunkCount, DUint* visibleChunkCount, DUint* rebuiltChunkCount, DUint* patchedChunkCount, DUint* totalRebuildCount, DUint* visibleTileCount)
+{
+    *chunkCount = static_cast<DUint>(tileMap->chunks.size());
+    *visibleChunkCount = static_cast<DUint>(tileMap->visibleChunks.size());
+    *rebuiltChunkCount = tileMap->rebuiltChunkCount;
+    *patchedChunkCount = tileMap->patchedChunkCount;
+    *totalRebuildCount = tileMap->totalRebuildCount;
+    *visibleTileCount = tileMap->visibleTileCount;
+}
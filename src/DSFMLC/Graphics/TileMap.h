@@ -0,0 +1,77 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_TILEMAP_H
+#define DSFML_TILEMAP_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <DSFMLC/Graphics/Types.h>
+#include <stddef.h>
+
+//Construct a new tile map of empty tiles, split in square chunks
+DSFML_GRAPHICS_API sfTileMap* sfTileMap_construct(DUint width, DUint height, DUint layerCount, DUint chunkSize, float tileWidth, float tileHeight);
+
+//Destroy an existing tile map
+DSFML_GRAPHICS_API void sfTileMap_destroy(sfTileMap* tileMap);
+
+//Set the size of the tiles in the tileset texture and how many of them a row of the texture holds
+DSFML_GRAPHICS_API void sfTileMap_setTileset(sfTileMap* tileMap, DUint tileWidth, DUint tileHeight, DUint columns);
+
+//Set a tile, negative for an empty tile
+DSFML_GRAPHICS_API DBool sfTileMap_setTile(sfTileMap* tileMap, DUint layer, DUint x, DUint y, DInt tile);
+
+//Get a tile, negative for an empty or out of range tile
+DSFML_GRAPHICS_API DInt sfTileMap_getTile(const sfTileMap* tileMap, DUint layer, DUint x, DUint y);
+
+//Set a rectangle of tiles from an array stored row by row
+DSFML_GRAPHICS_API DBool sfTileMap_setTiles(sfTileMap* tileMap, DUint layer, DUint left, DUint top, DUint width, DUint height, const DInt* tiles);
+
+//Show a list of tiles in turn in place of a tile, each for frameDuration microseconds
+DSFML_GRAPHICS_API DBool sfTileMap_setAnimation(sfTileMap* tileMap, DInt tile, const DInt* frames, size_t frameCount, DLong frameDuration);
+
+//Stop animating a tile
+DSFML_GRAPHICS_API DBool sfTileMap_removeAnimation(sfTileMap* tileMap, DInt tile);
+
+//Advance the animations by some microseconds
+DSFML_GRAPHICS_API void sfTileMap_update(sfTileMap* tileMap, DLong elapsed);
+
+//Find the chunks touching an area of the map, returning how many there are
+DSFML_GRAPHICS_API size_t sfTileMap_prepare(sfTileMap* tileMap, float left, float top, float width, float height);
+
+//Get the chunks found by the last call to prepare
+DSFML_GRAPHICS_API const DUint* sfTileMap_getVisibleChunks(const sfTileMap* tileMap);
+
+//Rebuild a chunk if its tiles changed and upload what changed to its vertex buffer if there is one, returning its number of vertices and whether the buffer holds them
+DSFML_GRAPHICS_API DUint sfTileMap_updateChunk(sfTileMap* tileMap, DUint chunk, sfVertexBuffer* vertexBuffer, DBool* uploaded);
+
+//Get the vertices of a chunk
+DSFML_GRAPHICS_API const void* sfTileMap_getChunkVertices(const sfTileMap* tileMap, DUint chunk);
+
+//Get the number of chunks, how many the last call to prepare found, rebuilt and patched, the total number of rebuilds and the number of visible tiles
+DSFML_GRAPHICS_API void sfTileMap_getStatistics(const sfTileMap* tileMap, DUint* chunkCount, DUint* visibleChunkCount, DUint* rebuiltChunkCount, DUint* patchedChunkCount, DUint* totalRebuildCount, DUint* visibleTileCount);
+
+#endif // DSFML_TILEMAP_H
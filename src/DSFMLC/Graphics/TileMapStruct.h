@@ -0,0 +1,138 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_TILEMAPSTRUCT_H
+#define DSFML_TILEMAPSTRUCT_H
+
+#include <DSFMLC/Config.h>
+#include <SFML/Graphics/Vertex.hpp>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+//A square block of tiles drawn with a single vertex buffer, all layers included
+struct sfTileMapChunk
+{
+    sfTileMapChunk() :
+    dirty(true),
+    uploaded(false),
+    animationVersion(0),
+    patchBegin(0),
+    patchEnd(0)
+    {
+    }
+
+    //Quads of the non-empty tiles, layer by layer
+    std::vector<sf::Vertex> vertices;
+
+    //First vertex and base tile of each animated tile
+    std::vector<std::pair<std::size_t, DInt> > animatedTiles;
+
+    //Whether the tiles changed since the vertices were last built
+    bool dirty;
+
+    //Whether the chunk's vertex buffer holds its vertices
+    bool uploaded;
+
+    //Version of the animation frames the texture coordinates were last set for
+    unsigned int animationVersion;
+
+    //Range of vertices changed by animations and not uploaded yet
+    std::size_t patchBegin;
+    std::size_t patchEnd;
+};
+
+//Tiles shown in turn in place of a tile
+struct sfTileMapAnimation
+{
+    std::vector<DInt> frames;
+    DLong frameDuration;
+    DLong elapsed;
+    std::size_t frame;
+};
+
+//Internal structure of sfTileMap
+struct sfTileMap
+{
+    sfTileMap() :
+    width(0),
+    height(0),
+    layerCount(0),
+    chunkSize(0),
+    chunkColumns(0),
+    chunkRows(0),
+    tileWidth(0),
+    tileHeight(0),
+    textureTileWidth(0),
+    textureTileHeight(0),
+    textureColumns(0),
+    animationVersion(1),
+    rebuiltChunkCount(0),
+    patchedChunkCount(0),
+    totalRebuildCount(0),
+    visibleTileCount(0)
+    {
+    }
+
+    unsigned int width;
+    unsigned int height;
+    unsigned int layerCount;
+
+    //Chunks are chunkSize tiles wide and high
+    unsigned int chunkSize;
+    unsigned int chunkColumns;
+    unsigned int chunkRows;
+
+    //Size of a tile in the map
+    float tileWidth;
+    float tileHeight;
+
+    //Size of a tile in the tileset texture, and how many tiles a row of the tileset holds
+    unsigned int textureTileWidth;
+    unsigned int textureTileHeight;
+    unsigned int textureColumns;
+
+    //Tiles of each layer one after the other, row by row, negative for empty tiles
+    std::vector<DInt> tiles;
+
+    std::vector<sfTileMapChunk> chunks;
+
+    std::unordered_map<DInt, sfTileMapAnimation> animations;
+
+    //Incremented whenever an animation shows another frame
+    unsigned int animationVersion;
+
+    //Chunks found by the last call to prepare
+    std::vector<DUint> visibleChunks;
+
+    unsigned int rebuiltChunkCount;
+    unsigned int patchedChunkCount;
+    unsigned int totalRebuildCount;
+    unsigned int visibleTileCount;
+};
+
+#endif // DSFML_TILEMAPSTRUCT_H
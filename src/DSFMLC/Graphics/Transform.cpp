@@ -26,7 +26,9 @@
  */
 
 #include <DSFMLC/Graphics/Transform.h>
+#include <DSFMLC/Graphics/TransformKernels.hpp>
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/Err.hpp>
 #include <cstring>
 
 void sfTransform_getInverse(const float* transform, float* inverse)
@@ -55,11 +57,43 @@ void sfTransform_transformRect(const float* transform, float leftIn, float topIn
     *heightOut = sfmlRect.height;
 }
 
+void sfTransform_transformPoints(const float* transform, const float* points, float* result, size_t count)
+{
+    transformkernels::transformPoints(transform, points, result, count);
+}
+
+void sfTransform_transformRects(const float* transform, const float* rects, float* result, size_t count)
+{
+    transformkernels::transformRects(transform, rects, result, count);
+}
+
 void sfTransform_combine(float* transform, const float* other)
 {
     reinterpret_cast<sf::Transform*>(transform)->combine(*reinterpret_cast<const sf::Transform*>(other));
 }
 
+void sfTransform_combineTransforms(const float* left, const float* right, float* result, size_t count)
+{
+    transformkernels::combine(left, right, result, count);
+}
+
+DBool sfTransform_combineHierarchy(const float* locals, const int* parents, float* worlds, size_t count)
+{
+    //Parents must come first so that their combined transform is ready when their children need it
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (parents[i] >= 0 && static_cast<size_t>(parents[i]) >= i)
+        {
+            sf::err() << "Failed to combine transform hierarchy, the parent of transform " << i
+                      << " (" << parents[i] << ") doesn't come before it" << std::endl;
+            return DFalse;
+        }
+    }
+
+    transformkernels::combineHierarchy(locals, parents, worlds, count);
+    return DTrue;
+}
+
 void sfTransform_translate(float* transform, float x, float y)
 {
     reinterpret_cast<sf::Transform*>(transform)->translate(x, y);
@@ -30,6 +30,7 @@
 
 #include <DSFMLC/Graphics/Export.h>
 #include <DSFMLC/Graphics/Types.h>
+#include <stddef.h>
 
 //Return the inverse of a transform
 DSFML_GRAPHICS_API void sfTransform_getInverse(const float* transform, float* inverse);
@@ -40,9 +41,21 @@ DSFML_GRAPHICS_API void sfTransform_transformPoint(const float* transform, float
 //Apply a transform to a rectangle
 DSFML_GRAPHICS_API void sfTransform_transformRect(const float* transform, float leftIn, float topIn, float widthIn, float heightIn, float* leftOut, float* topOut, float* widthOut, float* heightOut);
 
+//Apply a transform to an array of 2D points, stored as x, y pairs
+DSFML_GRAPHICS_API void sfTransform_transformPoints(const float* transform, const float* points, float* result, size_t count);
+
+//Apply a transform to an array of rectangles, stored as left, top, width, height
+DSFML_GRAPHICS_API void sfTransform_transformRects(const float* transform, const float* rects, float* result, size_t count);
+
 //Combine two transforms
 DSFML_GRAPHICS_API void sfTransform_combine(float* transform, const float* other);
 
+//Combine two arrays of transforms pairwise
+DSFML_GRAPHICS_API void sfTransform_combineTransforms(const float* left, const float* right, float* result, size_t count);
+
+//Combine each transform of a hierarchy with the combined transform of its parent
+DSFML_GRAPHICS_API DBool sfTransform_combineHierarchy(const float* locals, const int* parents, float* worlds, size_t count);
+
 //Combine a transform with a translation
 DSFML_GRAPHICS_API void sfTransform_translate(float* transform, float x, float y);
 
@@ -0,0 +1,469 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/TransformKernels.hpp>
+#include <DSFMLC/Graphics/PixelKernels.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define DSFML_TRANSFORMKERNELS_SSE2
+    #include <emmintrin.h>
+
+    //AVX functions are compiled for it on their own and only called when the pixel kernels chose AVX2
+    #if defined(_MSC_VER)
+        #define DSFML_TRANSFORMKERNELS_AVX2
+        #define DSFML_TARGET_AVX2
+        #include <immintrin.h>
+    #elif defined(__GNUC__)
+        #define DSFML_TRANSFORMKERNELS_AVX2
+        #define DSFML_TARGET_AVX2 __attribute__((target("avx2")))
+        #include <immintrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define DSFML_TRANSFORMKERNELS_NEON
+    #include <arm_neon.h>
+#endif
+
+//The vector kernels add the products in the same order as sf::Transform and never fuse them,
+//so that they give exactly the same results as the scalar code.
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    // Scalar kernels, also used for the elements left over by the vector loops
+    ////////////////////////////////////////////////////////////
+
+    void transformPointsScalar(const float* m, const float* points, float* result, std::size_t begin, std::size_t count)
+    {
+        for (std::size_t i = begin; i < count; ++i)
+        {
+            float x = points[i * 2];
+            float y = points[i * 2 + 1];
+
+            result[i * 2] = m[0] * x + m[4] * y + m[12];
+            result[i * 2 + 1] = m[1] * x + m[5] * y + m[13];
+        }
+    }
+
+    //The bounds of the four transformed corners, each coordinate being the sum of a term from
+    //the rectangle's x range and one from its y range. Rounding is monotonic, so adding the
+    //smallest (largest) terms gives exactly the smallest (largest) corner.
+    void transformRectsScalar(const float* m, const float* rects, float* result, std::size_t begin, std::size_t count)
+    {
+        for (std::size_t i = begin; i < count; ++i)
+        {
+            const float* rect = rects + i * 4;
+            float left = rect[0];
+            float top = rect[1];
+            float right = left + rect[2];
+            float bottom = top + rect[3];
+
+            float x0 = m[0] * left, x1 = m[0] * right;
+            float x2 = m[4] * top, x3 = m[4] * bottom;
+            float y0 = m[1] * left, y1 = m[1] * right;
+            float y2 = m[5] * top, y3 = m[5] * bottom;
+
+            float minX = std::min(x0, x1) + std::min(x2, x3) + m[12];
+            float maxX = std::max(x0, x1) + std::max(x2, x3) + m[12];
+            float minY = std::min(y0, y1) + std::min(y2, y3) + m[13];
+            float maxY = std::max(y0, y1) + std::max(y2, y3) + m[13];
+
+            float* out = result + i * 4;
+            out[0] = minX;
+            out[1] = minY;
+            out[2] = maxX - minX;
+            out[3] = maxY - minY;
+        }
+    }
+
+    //Same as sf::Transform::combine
+    void combineScalar(const float* a, const float* b, float* result)
+    {
+        float combined[16] = {a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
+                              a[1] * b[0]  + a[5] * b[1]  + a[13] * b[3],
+                              0.f,
+                              a[3] * b[0]  + a[7] * b[1]  + a[15] * b[3],
+                              a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
+                              a[1] * b[4]  + a[5] * b[5]  + a[13] * b[7],
+                              0.f,
+                              a[3] * b[4]  + a[7] * b[5]  + a[15] * b[7],
+                              0.f, 0.f, 1.f, 0.f,
+                              a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
+                              a[1] * b[12] + a[5] * b[13] + a[13] * b[15],
+                              0.f,
+                              a[3] * b[12] + a[7] * b[13] + a[15] * b[15]};
+
+        std::memcpy(result, combined, sizeof(combined));
+    }
+
+    template <typename Combine>
+    void combineWith(Combine combineOne, const float* left, const float* right, float* result, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            combineOne(left + i * 16, right + i * 16, result + i * 16);
+    }
+
+    template <typename Combine>
+    void combineHierarchyWith(Combine combineOne, const float* locals, const int* parents, float* worlds, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (parents[i] < 0)
+                std::memmove(worlds + i * 16, locals + i * 16, 16 * sizeof(float));
+            else
+                combineOne(worlds + parents[i] * 16, locals + i * 16, worlds + i * 16);
+        }
+    }
+
+#ifdef DSFML_TRANSFORMKERNELS_SSE2
+    ////////////////////////////////////////////////////////////
+    // SSE2 kernels, 2 points, 4 rectangles or 1 transform at a time
+    ////////////////////////////////////////////////////////////
+
+    std::size_t transformPointsSse2(const float* m, const float* points, float* result, std::size_t count)
+    {
+        const __m128 columnX = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+        const __m128 columnY = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+        const __m128 offset = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+        std::size_t i = 0;
+
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128 pair = _mm_loadu_ps(points + i * 2);
+            __m128 x = _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 y = _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(3, 3, 1, 1));
+
+            _mm_storeu_ps(result + i * 2, _mm_add_ps(_mm_add_ps(_mm_mul_ps(columnX, x), _mm_mul_ps(columnY, y)), offset));
+        }
+
+        return i;
+    }
+
+    //Works on the rectangles transposed, one vector per component
+    inline void boundsSse2(const float* m, __m128& left, __m128& top, __m128& width, __m128& height)
+    {
+        __m128 right = _mm_add_ps(left, width);
+        __m128 bottom = _mm_add_ps(top, height);
+
+        __m128 x0 = _mm_mul_ps(_mm_set1_ps(m[0]), left), x1 = _mm_mul_ps(_mm_set1_ps(m[0]), right);
+        __m128 x2 = _mm_mul_ps(_mm_set1_ps(m[4]), top), x3 = _mm_mul_ps(_mm_set1_ps(m[4]), bottom);
+        __m128 y0 = _mm_mul_ps(_mm_set1_ps(m[1]), left), y1 = _mm_mul_ps(_mm_set1_ps(m[1]), right);
+        __m128 y2 = _mm_mul_ps(_mm_set1_ps(m[5]), top), y3 = _mm_mul_ps(_mm_set1_ps(m[5]), bottom);
+
+        __m128 minX = _mm_add_ps(_mm_add_ps(_mm_min_ps(x0, x1), _mm_min_ps(x2, x3)), _mm_set1_ps(m[12]));
+        __m128 maxX = _mm_add_ps(_mm_add_ps(_mm_max_ps(x0, x1), _mm_max_ps(x2, x3)), _mm_set1_ps(m[12]));
+        __m128 minY = _mm_add_ps(_mm_add_ps(_mm_min_ps(y0, y1), _mm_min_ps(y2, y3)), _mm_set1_ps(m[13]));
+        __m128 maxY = _mm_add_ps(_mm_add_ps(_mm_max_ps(y0, y1), _mm_max_ps(y2, y3)), _mm_set1_ps(m[13]));
+
+        left = minX;
+        top = minY;
+        width = _mm_sub_ps(maxX, minX);
+        height = _mm_sub_ps(maxY, minY);
+    }
+
+    std::size_t transformRectsSse2(const float* m, const float* rects, float* result, std::size_t count)
+    {
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 r0 = _mm_loadu_ps(rects + i * 4);
+            __m128 r1 = _mm_loadu_ps(rects + i * 4 + 4);
+            __m128 r2 = _mm_loadu_ps(rects + i * 4 + 8);
+            __m128 r3 = _mm_loadu_ps(rects + i * 4 + 12);
+
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            boundsSse2(m, r0, r1, r2, r3);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+            _mm_storeu_ps(result + i * 4, r0);
+            _mm_storeu_ps(result + i * 4 + 4, r1);
+            _mm_storeu_ps(result + i * 4 + 8, r2);
+            _mm_storeu_ps(result + i * 4 + 12, r3);
+        }
+
+        return i;
+    }
+
+    //Each column of the result is a sum of the columns of a, the third row and column stay those of the identity
+    void combineSse2(const float* a, const float* b, float* result)
+    {
+        const __m128 rows = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, 0, -1));
+
+        __m128 column0 = _mm_loadu_ps(a);
+        __m128 column1 = _mm_loadu_ps(a + 4);
+        __m128 column3 = _mm_loadu_ps(a + 12);
+
+        __m128 combined0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(b[0])), _mm_mul_ps(column1, _mm_set1_ps(b[1]))), _mm_mul_ps(column3, _mm_set1_ps(b[3])));
+        __m128 combined1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(b[4])), _mm_mul_ps(column1, _mm_set1_ps(b[5]))), _mm_mul_ps(column3, _mm_set1_ps(b[7])));
+        __m128 combined3 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(b[12])), _mm_mul_ps(column1, _mm_set1_ps(b[13]))), _mm_mul_ps(column3, _mm_set1_ps(b[15])));
+
+        _mm_storeu_ps(result, _mm_and_ps(combined0, rows));
+        _mm_storeu_ps(result + 4, _mm_and_ps(combined1, rows));
+        _mm_storeu_ps(result + 8, _mm_setr_ps(0.f, 0.f, 1.f, 0.f));
+        _mm_storeu_ps(result + 12, _mm_and_ps(combined3, rows));
+    }
+#endif
+
+#ifdef DSFML_TRANSFORMKERNELS_AVX2
+    ////////////////////////////////////////////////////////////
+    // AVX kernels, 4 points or 8 rectangles at a time
+    ////////////////////////////////////////////////////////////
+
+    DSFML_TARGET_AVX2 std::size_t transformPointsAvx2(const float* m, const float* points, float* result, std::size_t count)
+    {
+        const __m256 columnX = _mm256_setr_ps(m[0], m[1], m[0], m[1], m[0], m[1], m[0], m[1]);
+        const __m256 columnY = _mm256_setr_ps(m[4], m[5], m[4], m[5], m[4], m[5], m[4], m[5]);
+        const __m256 offset = _mm256_setr_ps(m[12], m[13], m[12], m[13], m[12], m[13], m[12], m[13]);
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256 pairs = _mm256_loadu_ps(points + i * 2);
+            __m256 x = _mm256_moveldup_ps(pairs);
+            __m256 y = _mm256_movehdup_ps(pairs);
+
+            _mm256_storeu_ps(result + i * 2, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(columnX, x), _mm256_mul_ps(columnY, y)), offset));
+        }
+
+        return i;
+    }
+
+    //Transposes the 4x4 blocks of both 128 bits lanes at once
+    DSFML_TARGET_AVX2 inline void transposeLanesAvx2(__m256& r0, __m256& r1, __m256& r2, __m256& r3)
+    {
+        __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+        __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+        __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+        __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+
+        r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+        r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+        r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    //The low lanes hold the even rectangles and the high lanes the odd ones, the same transpose puts them back
+    DSFML_TARGET_AVX2 std::size_t transformRectsAvx2(const float* m, const float* rects, float* result, std::size_t count)
+    {
+        const __m256 scale0 = _mm256_set1_ps(m[0]), scale1 = _mm256_set1_ps(m[1]);
+        const __m256 scale4 = _mm256_set1_ps(m[4]), scale5 = _mm256_set1_ps(m[5]);
+        const __m256 offsetX = _mm256_set1_ps(m[12]), offsetY = _mm256_set1_ps(m[13]);
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 left = _mm256_loadu_ps(rects + i * 4);
+            __m256 top = _mm256_loadu_ps(rects + i * 4 + 8);
+            __m256 width = _mm256_loadu_ps(rects + i * 4 + 16);
+            __m256 height = _mm256_loadu_ps(rects + i * 4 + 24);
+
+            transposeLanesAvx2(left, top, width, height);
+
+            __m256 right = _mm256_add_ps(left, width);
+            __m256 bottom = _mm256_add_ps(top, height);
+
+            __m256 x0 = _mm256_mul_ps(scale0, left), x1 = _mm256_mul_ps(scale0, right);
+            __m256 x2 = _mm256_mul_ps(scale4, top), x3 = _mm256_mul_ps(scale4, bottom);
+            __m256 y0 = _mm256_mul_ps(scale1, left), y1 = _mm256_mul_ps(scale1, right);
+            __m256 y2 = _mm256_mul_ps(scale5, top), y3 = _mm256_mul_ps(scale5, bottom);
+
+            __m256 minX = _mm256_add_ps(_mm256_add_ps(_mm256_min_ps(x0, x1), _mm256_min_ps(x2, x3)), offsetX);
+            __m256 maxX = _mm256_add_ps(_mm256_add_ps(_mm256_max_ps(x0, x1), _mm256_max_ps(x2, x3)), offsetX);
+            __m256 minY = _mm256_add_ps(_mm256_add_ps(_mm256_min_ps(y0, y1), _mm256_min_ps(y2, y3)), offsetY);
+            __m256 maxY = _mm256_add_ps(_mm256_add_ps(_mm256_max_ps(y0, y1), _mm256_max_ps(y2, y3)), offsetY);
+
+            left = minX;
+            top = minY;
+            width = _mm256_sub_ps(maxX, minX);
+            height = _mm256_sub_ps(maxY, minY);
+
+            transposeLanesAvx2(left, top, width, height);
+
+            _mm256_storeu_ps(result + i * 4, left);
+            _mm256_storeu_ps(result + i * 4 + 8, top);
+            _mm256_storeu_ps(result + i * 4 + 16, width);
+            _mm256_storeu_ps(result + i * 4 + 24, height);
+        }
+
+        return i;
+    }
+#endif
+
+#ifdef DSFML_TRANSFORMKERNELS_NEON
+    ////////////////////////////////////////////////////////////
+    // NEON kernels, 4 points, 4 rectangles or 1 transform at a time
+    ////////////////////////////////////////////////////////////
+
+    std::size_t transformPointsNeon(const float* m, const float* points, float* result, std::size_t count)
+    {
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4x2_t xy = vld2q_f32(points + i * 2);
+            float32x4x2_t transformed;
+
+            transformed.val[0] = vaddq_f32(vaddq_f32(vmulq_n_f32(xy.val[0], m[0]), vmulq_n_f32(xy.val[1], m[4])), vdupq_n_f32(m[12]));
+            transformed.val[1] = vaddq_f32(vaddq_f32(vmulq_n_f32(xy.val[0], m[1]), vmulq_n_f32(xy.val[1], m[5])), vdupq_n_f32(m[13]));
+            vst2q_f32(result + i * 2, transformed);
+        }
+
+        return i;
+    }
+
+    std::size_t transformRectsNeon(const float* m, const float* rects, float* result, std::size_t count)
+    {
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4x4_t rect = vld4q_f32(rects + i * 4);
+            float32x4_t right = vaddq_f32(rect.val[0], rect.val[2]);
+            float32x4_t bottom = vaddq_f32(rect.val[1], rect.val[3]);
+
+            float32x4_t x0 = vmulq_n_f32(rect.val[0], m[0]), x1 = vmulq_n_f32(right, m[0]);
+            float32x4_t x2 = vmulq_n_f32(rect.val[1], m[4]), x3 = vmulq_n_f32(bottom, m[4]);
+            float32x4_t y0 = vmulq_n_f32(rect.val[0], m[1]), y1 = vmulq_n_f32(right, m[1]);
+            float32x4_t y2 = vmulq_n_f32(rect.val[1], m[5]), y3 = vmulq_n_f32(bottom, m[5]);
+
+            float32x4_t minX = vaddq_f32(vaddq_f32(vminq_f32(x0, x1), vminq_f32(x2, x3)), vdupq_n_f32(m[12]));
+            float32x4_t maxX = vaddq_f32(vaddq_f32(vmaxq_f32(x0, x1), vmaxq_f32(x2, x3)), vdupq_n_f32(m[12]));
+            float32x4_t minY = vaddq_f32(vaddq_f32(vminq_f32(y0, y1), vminq_f32(y2, y3)), vdupq_n_f32(m[13]));
+            float32x4_t maxY = vaddq_f32(vaddq_f32(vmaxq_f32(y0, y1), vmaxq_f32(y2, y3)), vdupq_n_f32(m[13]));
+
+            rect.val[0] = minX;
+            rect.val[1] = minY;
+            rect.val[2] = vsubq_f32(maxX, minX);
+            rect.val[3] = vsubq_f32(maxY, minY);
+            vst4q_f32(result + i * 4, rect);
+        }
+
+        return i;
+    }
+
+    void combineNeon(const float* a, const float* b, float* result)
+    {
+        const uint32x4_t rows = {0xFFFFFFFFu, 0xFFFFFFFFu, 0u, 0xFFFFFFFFu};
+        const float32x4_t identity = {0.f, 0.f, 1.f, 0.f};
+
+        float32x4_t column0 = vld1q_f32(a);
+        float32x4_t column1 = vld1q_f32(a + 4);
+        float32x4_t column3 = vld1q_f32(a + 12);
+
+        float32x4_t combined0 = vaddq_f32(vaddq_f32(vmulq_n_f32(column0, b[0]), vmulq_n_f32(column1, b[1])), vmulq_n_f32(column3, b[3]));
+        float32x4_t combined1 = vaddq_f32(vaddq_f32(vmulq_n_f32(column0, b[4]), vmulq_n_f32(column1, b[5])), vmulq_n_f32(column3, b[7]));
+        float32x4_t combined3 = vaddq_f32(vaddq_f32(vmulq_n_f32(column0, b[12]), vmulq_n_f32(column1, b[13])), vmulq_n_f32(column3, b[15]));
+
+        vst1q_f32(result, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(combined0), rows)));
+        vst1q_f32(result + 4, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(combined1), rows)));
+        vst1q_f32(result + 8, identity);
+        vst1q_f32(result + 12, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(combined3), rows)));
+    }
+#endif
+}
+
+namespace transformkernels
+{
+    void transformPoints(const float* transform, const float* points, float* result, std::size_t count)
+    {
+        std::size_t done = 0;
+
+        switch (pixelkernels::getInstructionSet())
+        {
+#ifdef DSFML_TRANSFORMKERNELS_AVX2
+            case pixelkernels::Avx2: done = transformPointsAvx2(transform, points, result, count); break;
+#endif
+#ifdef DSFML_TRANSFORMKERNELS_SSE2
+            case pixelkernels::Sse2: done = transformPointsSse2(transform, points, result, count); break;
+#endif
+#ifdef DSFML_TRANSFORMKERNELS_NEON
+            case pixelkernels::Neon: done = transformPointsNeon(transform, points, result, count); break;
+#endif
+            default: break;
+        }
+
+        transformPointsScalar(transform, points, result, done, count);
+    }
+
+    void transformRects(const float* transform, const float* rects, float* result, std::size_t count)
+    {
+        std::size_t done = 0;
+
+        switch (pixelkernels::getInstructionSet())
+        {
+#ifdef DSFML_TRANSFORMKERNELS_AVX2
+            case pixelkernels::Avx2: done = transformRectsAvx2(transform, rects, result, count); break;
+#endif
+#ifdef DSFML_TRANSFORMKERNELS_SSE2
+            case pixelkernels::Sse2: done = transformRectsSse2(transform, rects, result, count); break;
+#endif
+#ifdef DSFML_TRANSFORMKERNELS_NEON
+            case pixelkernels::Neon: done = transformRectsNeon(transform, rects, result, count); break;
+#endif
+            default: break;
+        }
+
+        transformRectsScalar(transform, rects, result, done, count);
+    }
+
+    //A single transform fits in four SSE registers, so AVX has nothing more to offer here
+    void combine(const float* left, const float* right, float* result, std::size_t count)
+    {
+        switch (pixelkernels::getInstructionSet())
+        {
+#ifdef DSFML_TRANSFORMKERNELS_SSE2
+            case pixelkernels::Avx2:
+            case pixelkernels::Sse2: combineWith(combineSse2, left, right, result, count); return;
+#endif
+#ifdef DSFML_TRANSFORMKERNELS_NEON
+            case pixelkernels::Neon: combineWith(combineNeon, left, right, result, count); return;
+#endif
+            default: break;
+        }
+
+        combineWith(combineScalar, left, right, result, count);
+    }
+
+    void combineHierarchy(const float* locals, const int* parents, float* worlds, std::size_t count)
+    {
+        switch (pixelkernels::getInstructionSet())
+        {
+#ifdef DSFML_TRANSFORMKERNELS_SSE2
+            case pixelkernels::Avx2:
+            case pixelkernels::Sse2: combineHierarchyWith(combineSse2, locals, parents, worlds, count); return;
+#endif
+#ifdef DSFML_TRANSFORMKERNELS_NEON
+            case pixelkernels::Neon: combineHierarchyWith(combineNeon, locals, parents, worlds, count); return;
+#endif
+            default: break;
+        }
+
+        combineHierarchyWith(combineScalar, locals, parents, worlds, count);
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_TRANSFORMKERNELS_HPP
+#define DSFML_TRANSFORMKERNELS_HPP
+
+#include <cstddef>
+
+//Transforms applied to whole arrays at once, vectorized with the instruction set chosen for the pixel kernels
+//
+//Transforms are 4x4 column major matrices of 16 floats, laid out like sf::Transform. The results are the
+//same as the sf::Transform functions, point by point.
+namespace transformkernels
+{
+    //Transform interleaved x, y pairs, points and result may be the same array
+    void transformPoints(const float* transform, const float* points, float* result, std::size_t count);
+
+    //Transform rectangles stored as left, top, width, height into their bounding rectangles, rects and result may be the same array
+    void transformRects(const float* transform, const float* rects, float* result, std::size_t count);
+
+    //Combine transforms pairwise, result[i] = left[i] * right[i], result may be either of the inputs
+    void combine(const float* left, const float* right, float* result, std::size_t count);
+
+    //Combine each local transform with the world transform of its parent, parents[i] < i or negative for roots
+    void combineHierarchy(const float* locals, const int* parents, float* worlds, std::size_t count);
+}
+
+#endif // DSFML_TRANSFORMKERNELS_HPP
@@ -28,13 +28,25 @@
 #ifndef DSFML_GRAPHICS_TYPES_H
 #define DSFML_GRAPHICS_TYPES_H
 
+typedef struct sfDynamicAtlas sfDynamicAtlas;
 typedef struct sfFont sfFont;
+typedef struct sfFrameCapture sfFrameCapture;
+typedef struct sfFrameRecorder sfFrameRecorder;
 typedef struct sfImage sfImage;
+typedef struct sfImageLoad sfImageLoad;
+typedef struct sfParticleSystem sfParticleSystem;
 typedef struct sfShader sfShader;
+typedef struct sfShaderLoad sfShaderLoad;
+typedef struct sfSpatialIndex sfSpatialIndex;
 typedef struct sfRenderTexture sfRenderTexture;
 typedef struct sfRenderWindow sfRenderWindow;
 typedef struct sfSprite sfSprite;
+typedef struct sfSpriteBatch sfSpriteBatch;
 typedef struct sfText sfText;
+typedef struct sfTextureAtlas sfTextureAtlas;
+typedef struct sfTileMap sfTileMap;
 typedef struct sfTexture sfTexture;
+typedef struct sfTextureUploader sfTextureUploader;
+typedef struct sfVertexBuffer sfVertexBuffer;
 
 #endif // SFML_GRAPHICS_TYPES_H
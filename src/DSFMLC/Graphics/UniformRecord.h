@@ -0,0 +1,57 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_UNIFORMRECORD_H
+#define DSFML_UNIFORMRECORD_H
+
+#include <DSFMLC/Config.h>
+
+//Types of the values that can be uploaded in a uniform batch
+typedef enum
+{
+    sfUniformFloat,
+    sfUniformVec2,
+    sfUniformVec3,
+    sfUniformVec4,
+    sfUniformInt,
+    sfUniformIvec2,
+    sfUniformIvec3,
+    sfUniformIvec4,
+    sfUniformMat3,
+    sfUniformMat4
+} sfUniformType;
+
+//A uniform in a batch, whose value is stored at offset bytes in the batch data
+typedef struct
+{
+    DUint location;
+    DUint type;
+    DUint count;
+    DUint offset;
+} sfUniformRecord;
+
+#endif // DSFML_UNIFORMRECORD_H
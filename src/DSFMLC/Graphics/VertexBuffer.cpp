@@ -0,0 +1,309 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#include <DSFMLC/Graphics/VertexBuffer.h>
+#include <DSFMLC/Graphics/VertexBufferStruct.h>
+#include <DSFMLC/Graphics/GLFunctions.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+namespace
+{
+    GLenum usageToGlEnum(sfVertexBuffer::Usage usage)
+    {
+        switch (usage)
+        {
+            case sfVertexBuffer::Stream:  return GL_STREAM_DRAW;
+            case sfVertexBuffer::Dynamic: return GL_DYNAMIC_DRAW;
+            default:                      return GL_STATIC_DRAW;
+        }
+    }
+
+    GLenum factorToGlEnum(sf::BlendMode::Factor blendFactor)
+    {
+        switch (blendFactor)
+        {
+            case sf::BlendMode::Zero:             return GL_ZERO;
+            case sf::BlendMode::One:              return GL_ONE;
+            case sf::BlendMode::SrcColor:         return GL_SRC_COLOR;
+            case sf::BlendMode::OneMinusSrcColor: return GL_ONE_MINUS_SRC_COLOR;
+            case sf::BlendMode::DstColor:         return GL_DST_COLOR;
+            case sf::BlendMode::OneMinusDstColor: return GL_ONE_MINUS_DST_COLOR;
+            case sf::BlendMode::SrcAlpha:         return GL_SRC_ALPHA;
+            case sf::BlendMode::OneMinusSrcAlpha: return GL_ONE_MINUS_SRC_ALPHA;
+            case sf::BlendMode::DstAlpha:         return GL_DST_ALPHA;
+            default:                              return GL_ONE_MINUS_DST_ALPHA;
+        }
+    }
+
+    GLenum equationToGlEnum(sf::BlendMode::Equation blendEquation)
+    {
+        switch (blendEquation)
+        {
+            case sf::BlendMode::Add:             return GL_FUNC_ADD;
+            case sf::BlendMode::Subtract:        return GL_FUNC_SUBTRACT;
+            default:                             return GL_FUNC_REVERSE_SUBTRACT;
+        }
+    }
+
+    void applyBlendMode(const sf::BlendMode& mode)
+    {
+        if (glext::blendFuncSeparate)
+        {
+            glext::blendFuncSeparate(factorToGlEnum(mode.colorSrcFactor), factorToGlEnum(mode.colorDstFactor),
+                                     factorToGlEnum(mode.alphaSrcFactor), factorToGlEnum(mode.alphaDstFactor));
+        }
+        else
+        {
+            glBlendFunc(factorToGlEnum(mode.colorSrcFactor), factorToGlEnum(mode.colorDstFactor));
+        }
+
+        if (glext::blendEquationSeparate)
+            glext::blendEquationSeparate(equationToGlEnum(mode.colorEquation), equationToGlEnum(mode.alphaEquation));
+        else if (glext::blendEquation)
+            glext::blendEquation(equationToGlEnum(mode.colorEquation));
+    }
+
+    const GLenum primitiveModes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                     GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+}
+
+sfVertexBuffer::sfVertexBuffer(Usage bufferUsage) :
+buffer(0),
+size(0),
+usage(bufferUsage)
+{
+}
+
+sfVertexBuffer::~sfVertexBuffer()
+{
+    if (buffer)
+    {
+        TransientContextLock lock;
+
+        glext::deleteBuffers(1, &buffer);
+    }
+}
+
+bool sfVertexBuffer::create(std::size_t vertexCount)
+{
+    TransientContextLock lock;
+
+    if (!glext::hasBufferObjects())
+    {
+        sf::err() << "Failed to create vertex buffer: vertex buffers are not supported by your system" << std::endl;
+        return false;
+    }
+
+    if (!buffer)
+        glext::genBuffers(1, &buffer);
+
+    if (!buffer)
+    {
+        sf::err() << "Failed to create vertex buffer: the buffer could not be generated" << std::endl;
+        return false;
+    }
+
+    glext::bindBuffer(GL_ARRAY_BUFFER, buffer);
+    glext::bufferData(GL_ARRAY_BUFFER, sizeof(sf::Vertex) * vertexCount, NULL, usageToGlEnum(usage));
+    glext::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    size = vertexCount;
+
+    return true;
+}
+
+bool sfVertexBuffer::update(const sf::Vertex* vertices, std::size_t vertexCount, std::size_t offset)
+{
+    if (!buffer || !vertices)
+        return false;
+
+    //Writing past the end is only allowed when the whole buffer is replaced
+    if ((offset != 0) && (offset + vertexCount > size))
+        return false;
+
+    TransientContextLock lock;
+
+    glext::bindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    if ((offset == 0) && (vertexCount >= size))
+    {
+        glext::bufferData(GL_ARRAY_BUFFER, sizeof(sf::Vertex) * vertexCount, vertices, usageToGlEnum(usage));
+        size = vertexCount;
+    }
+    else
+    {
+        glext::bufferSubData(GL_ARRAY_BUFFER, sizeof(sf::Vertex) * offset, sizeof(sf::Vertex) * vertexCount, vertices);
+    }
+
+    glext::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return true;
+}
+
+sf::Vertex* sfVertexBuffer::map(std::size_t vertexCount)
+{
+    if (vertexCount == 0)
+        return NULL;
+
+    TransientContextLock lock;
+
+    if (!glext::hasBufferObjects() || !glext::mapBufferRange || !glext::unmapBuffer)
+        return NULL;
+
+    if (!buffer)
+        glext::genBuffers(1, &buffer);
+
+    if (!buffer)
+        return NULL;
+
+    glext::bindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    //A larger buffer is reallocated, a smaller one is invalidated so the GPU can keep drawing its old contents
+    if (vertexCount > size)
+    {
+        glext::bufferData(GL_ARRAY_BUFFER, sizeof(sf::Vertex) * vertexCount, NULL, usageToGlEnum(usage));
+        size = vertexCount;
+    }
+
+    void* vertices = glext::mapBufferRange(GL_ARRAY_BUFFER, 0, sizeof(sf::Vertex) * vertexCount,
+                                           GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    glext::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return static_cast<sf::Vertex*>(vertices);
+}
+
+bool sfVertexBuffer::unmap()
+{
+    if (!buffer)
+        return false;
+
+    TransientContextLock lock;
+
+    glext::bindBuffer(GL_ARRAY_BUFFER, buffer);
+    bool intact = glext::unmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
+    glext::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return intact;
+}
+
+void sfVertexBuffer::draw(sf::RenderTarget& target, std::size_t firstVertex, std::size_t vertexCount,
+                          sf::PrimitiveType type, const sf::RenderStates& states) const
+{
+    if (!buffer || (firstVertex >= size))
+        return;
+
+    vertexCount = std::min(vertexCount, size - firstVertex);
+
+    if (vertexCount == 0)
+        return;
+
+    //Only the states the draw depends on are set here, SFML doesn't know how to draw from a buffer
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_ALPHA_TEST);
+    glEnable(GL_TEXTURE_2D);
+    glEnable(GL_BLEND);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    const sf::View& view = target.getView();
+    sf::IntRect viewport = target.getViewport(view);
+    int top = static_cast<int>(target.getSize().y) - (viewport.top + viewport.height);
+    glViewport(viewport.left, top, viewport.width, viewport.height);
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(view.getTransform().getMatrix());
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(states.transform.getMatrix());
+
+    applyBlendMode(states.blendMode);
+    sf::Texture::bind(states.texture, sf::Texture::Pixels);
+    if (states.shader)
+        sf::Shader::bind(states.shader);
+
+    glext::bindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexPointer(2, GL_FLOAT, sizeof(sf::Vertex), reinterpret_cast<const void*>(0));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(sf::Vertex), reinterpret_cast<const void*>(8));
+    glTexCoordPointer(2, GL_FLOAT, sizeof(sf::Vertex), reinterpret_cast<const void*>(12));
+    glDrawArrays(primitiveModes[type], static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount));
+    glext::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (states.shader)
+        sf::Shader::bind(NULL);
+
+    //The states changed behind SFML's back, so its cache has to be reset too
+    target.resetGLStates();
+}
+
+sfVertexBuffer* sfVertexBuffer_construct(DInt usage)
+{
+    return new sfVertexBuffer(static_cast<sfVertexBuffer::Usage>(usage));
+}
+
+void sfVertexBuffer_destroy(sfVertexBuffer* vertexBuffer)
+{
+    delete vertexBuffer;
+}
+
+DBool sfVertexBuffer_create(sfVertexBuffer* vertexBuffer, DUint vertexCount)
+{
+    return vertexBuffer->create(vertexCount)?DTrue:DFalse;
+}
+
+DUint sfVertexBuffer_getVertexCount(const sfVertexBuffer* vertexBuffer)
+{
+    return static_cast<DUint>(vertexBuffer->size);
+}
+
+DBool sfVertexBuffer_update(sfVertexBuffer* vertexBuffer, const void* vertices, DUint vertexCount, DUint offset)
+{
+    return vertexBuffer->update(static_cast<const sf::Vertex*>(vertices), vertexCount, offset)?DTrue:DFalse;
+}
+
+void sfVertexBuffer_setUsage(sfVertexBuffer* vertexBuffer, DInt usage)
+{
+    vertexBuffer->usage = static_cast<sfVertexBuffer::Usage>(usage);
+}
+
+DInt sfVertexBuffer_getUsage(const sfVertexBuffer* vertexBuffer)
+{
+    return vertexBuffer->usage;
+}
+
+DBool sfVertexBuffer_isAvailable(void)
+{
+    sf::Context context;
+
+    return glext::hasBufferObjects()?DTrue:DFalse;
+}
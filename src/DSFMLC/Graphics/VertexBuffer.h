@@ -0,0 +1,58 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_VERTEXBUFFER_H
+#define DSFML_VERTEXBUFFER_H
+
+#include <DSFMLC/Graphics/Export.h>
+#include <DSFMLC/Graphics/Types.h>
+
+//Construct a new vertex buffer
+DSFML_GRAPHICS_API sfVertexBuffer* sfVertexBuffer_construct(DInt usage);
+
+//Destroy an existing vertex buffer
+DSFML_GRAPHICS_API void sfVertexBuffer_destroy(sfVertexBuffer* vertexBuffer);
+
+//Allocate room for a number of vertices on the graphics card
+DSFML_GRAPHICS_API DBool sfVertexBuffer_create(sfVertexBuffer* vertexBuffer, DUint vertexCount);
+
+//Get the number of vertices a vertex buffer can hold
+DSFML_GRAPHICS_API DUint sfVertexBuffer_getVertexCount(const sfVertexBuffer* vertexBuffer);
+
+//Update part of a vertex buffer from an array of vertices
+DSFML_GRAPHICS_API DBool sfVertexBuffer_update(sfVertexBuffer* vertexBuffer, const void* vertices, DUint vertexCount, DUint offset);
+
+//Set the usage hint of a vertex buffer
+DSFML_GRAPHICS_API void sfVertexBuffer_setUsage(sfVertexBuffer* vertexBuffer, DInt usage);
+
+//Get the usage hint of a vertex buffer
+DSFML_GRAPHICS_API DInt sfVertexBuffer_getUsage(const sfVertexBuffer* vertexBuffer);
+
+//Check if vertex buffers are supported by the system
+DSFML_GRAPHICS_API DBool sfVertexBuffer_isAvailable(void);
+
+#endif // DSFML_VERTEXBUFFER_H
@@ -0,0 +1,72 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_VERTEXBUFFERSTRUCT_H
+#define DSFML_VERTEXBUFFERSTRUCT_H
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <DSFMLC/Config.h>
+#include <cstddef>
+
+//Internal structure of sfVertexBuffer
+struct sfVertexBuffer : private sf::GlResource
+{
+    enum Usage
+    {
+        Stream,
+        Dynamic,
+        Static
+    };
+
+    sfVertexBuffer(Usage bufferUsage);
+
+    ~sfVertexBuffer();
+
+    //Allocate room for vertexCount vertices, discarding the previous contents
+    bool create(std::size_t vertexCount);
+
+    //Copy vertices into the buffer, growing it if the whole buffer is replaced
+    bool update(const sf::Vertex* vertices, std::size_t vertexCount, std::size_t offset);
+
+    //Map the buffer for writing vertexCount vertices, discarding its contents, or return NULL if buffers can't be mapped
+    sf::Vertex* map(std::size_t vertexCount);
+
+    //Unmap the buffer once the vertices are written, returning false if they were lost and must be written again
+    bool unmap();
+
+    //Draw a range of the buffer to a render target, which must be active
+    void draw(sf::RenderTarget& target, std::size_t firstVertex, std::size_t vertexCount,
+              sf::PrimitiveType type, const sf::RenderStates& states) const;
+
+    unsigned int buffer;
+    std::size_t size;
+    Usage usage;
+};
+
+#endif // DSFML_VERTEXBUFFERSTRUCT_H
@@ -0,0 +1,107 @@
+/*
+ * DSFML - The Simple and Fast Multimedia Library for D
+ *
+ * Copyright (c) 2013 - 2018 Jeremy DeHaan (dehaan.jeremiah@gmail.com)
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from the
+ * use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim
+ * that you wrote the original software. If you use this software in a product,
+ * an acknowledgment in the product documentation would be appreciated but is
+ * not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution
+ *
+ *
+ * DSFML is based on SFML (Copyright Laurent Gomila)
+ */
+
+#ifndef DSFML_VIEWCACHE_HPP
+#define DSFML_VIEWCACHE_HPP
+
+#include <SFML/Graphics/View.hpp>
+#include <DSFMLC/Graphics/ViewData.h>
+#include <cstring>
+#include <cstddef>
+
+// Keeps the views last set on a render target alive, so that switching
+// between a few views (world, minimap, HUD, ...) doesn't rebuild them and
+// recompute their projection every time
+struct sfViewCache
+{
+    static const std::size_t Size = 4;
+
+    sfViewCache() :
+    next(0),
+    count(0)
+    {
+    }
+
+    // Find the view matching some view data, creating it if needed
+    const sf::View& get(const sfViewData& data)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (std::memcmp(&entries[i].data, &data, sizeof(sfViewData)) == 0)
+                return entries[i].view;
+        }
+
+        Entry& entry = entries[next];
+        next = (next + 1) % Size;
+        if (count < Size)
+            ++count;
+
+        entry.data = data;
+        entry.view = createView(data);
+
+        //Compute the projection now, so that copies of the view share it
+        entry.view.getTransform();
+
+        return entry.view;
+    }
+
+    static sf::View createView(const sfViewData& data)
+    {
+        sf::View view;
+        view.setCenter(data.centerX, data.centerY);
+        view.setSize(data.sizeX, data.sizeY);
+        view.setRotation(data.rotation);
+        view.setViewport(sf::FloatRect(data.viewportLeft, data.viewportTop, data.viewportWidth, data.viewportHeight));
+
+        return view;
+    }
+
+    static void getViewData(const sf::View& view, sfViewData* data)
+    {
+        data->centerX = view.getCenter().x;
+        data->centerY = view.getCenter().y;
+        data->sizeX = view.getSize().x;
+        data->sizeY = view.getSize().y;
+        data->rotation = view.getRotation();
+        data->viewportLeft = view.getViewport().left;
+        data->viewportTop = view.getViewport().top;
+        data->viewportWidth = view.getViewport().width;
+        data->viewportHeight = view.getViewport().height;
+    }
+
+    struct Entry
+    {
+        sfViewData data;
+        sf::View   view;
+    };
+
+    Entry       entries[Size];
+    std::size_t next;
+    std::size_t count;
+};
+
+#endif // DSFML_VIEWCACHE_HPP